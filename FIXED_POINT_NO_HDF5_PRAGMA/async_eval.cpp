@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file    async_eval.cpp
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Test set through the coroutine interface (lenet_async.hpp)
+  * @brief   usage: ./async_eval [-j workers] [-b max_batch] [-w max_wait_us] [-c coroutines] [-n max_images]
+  *          Each coroutine awaits lenet.classify() on its share of the images,
+  *          one image at a time; the executor batches the concurrent awaits.
+  */
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <latch>
+#include <vector>
+#include <unistd.h>
+
+extern "C" {
+#include "lenet_cnn_float.h"
+}
+#include "lenet_async.hpp"
+
+#define DEFAULT_COROUTINES  64
+
+// coroutine started eagerly and never awaited, its frame freed at the end
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+static Detached ClassifyShare(lenet::Executor &lenet, unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],
+                              unsigned char *predicted, int first, int step, int nb_images, std::latch &finished)
+{
+  for (int m = first; m < nb_images; m += step)
+  {
+    lenet_result result = co_await lenet.classify(&images[m][0][0][0]);
+    predicted[m] = result.label;
+  }
+  finished.count_down();
+}
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-j workers] [-b max_batch] [-w max_wait_us] [-c coroutines] [-n max_images]\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES], predicted[NB_TEST_IMAGES];
+  unsigned int error;
+  int opt, m, c, nb_workers, max_batch, max_wait, nb_coroutines, nb_images, max_images;
+  double tstart, tdiff;
+
+  nb_workers = 0;
+  max_batch = 32;
+  max_wait = 200;
+  nb_coroutines = DEFAULT_COROUTINES;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "j:b:w:c:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j': nb_workers = atoi(optarg); break;
+    case 'b': max_batch = atoi(optarg); break;
+    case 'w': max_wait = atoi(optarg); break;
+    case 'c': nb_coroutines = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_coroutines < 1)
+    nb_coroutines = 1;
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  nb_images = LoadTestSet((char *)"mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  lenet::ExecutorStats stats;
+  {
+    // destroyed after the executor, whose workers count it down
+    std::latch finished(nb_coroutines);
+    lenet::Executor lenet(nb_workers, max_batch, std::chrono::microseconds(max_wait));
+
+    tstart = TimeNow();
+    for (c = 0; c < nb_coroutines; c++)
+      ClassifyShare(lenet, images, predicted, c, nb_coroutines, nb_images, finished);
+    finished.wait();
+    tdiff = TimeNow() - tstart;
+    stats = lenet.Stats();
+  }
+
+  error = 0;
+  for (m = 0; m < nb_images; m++)
+    if (predicted[m] != labels[m])
+      error = error + 1;
+
+  printf("\n%d images, %d coroutines: %f s, %.1f images/s\n", nb_images, nb_coroutines, tdiff, nb_images / tdiff);
+  printf("%llu batches, %.1f images per batch\n", stats.batches, stats.batches ? (double)stats.images / stats.batches : 0);
+  printf("\n\nErrors : %d / %d", error, nb_images);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+  printf("\n\n");
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    bench.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Benchmark harness and cases of the fixed point layers (bench.h)
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+
+#include "lenet_cnn_float.h"
+#include "bench.h"
+
+#define BENCH_SEED          42
+
+// random fixed point inputs and weights in the range of the trained ones
+static unsigned char INPUT[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+static short CONV1_K[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM];
+static short CONV1_B[CONV1_NBOUTPUT];
+static short CONV1_OUT[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+static short POOL1_OUT[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+static short CONV2_K[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+static short CONV2_B[CONV2_NBOUTPUT];
+static short CONV2_OUT[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+static short POOL2_OUT[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+static short FC1_K[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+static short FC1_B[FC1_NBOUTPUT];
+static short FC1_OUT[FC1_NBOUTPUT];
+static short FC2_K[FC2_NBOUTPUT][FC1_NBOUTPUT];
+static short FC2_B[FC2_NBOUTPUT];
+static short FC2_OUT[FC2_NBOUTPUT];
+static float SOFTMAX_OUT[FC2_NBOUTPUT];
+
+static void Fill(short *array, int size, int range, unsigned int *seed)
+{
+  int k;
+
+  for (k = 0; k < size; k++)
+    array[k] = rand_r(seed) % (2 * range + 1) - range;
+}
+
+static void BenchConv1(void) { Conv1_28x28x1_5x5x20_1_0(INPUT, CONV1_K, CONV1_B, CONV1_OUT); }
+static void BenchPool1(void) { Pool1_24x24x20_2x2x20_2_0(CONV1_OUT, POOL1_OUT); }
+static void BenchConv2(void) { Conv2_12x12x20_5x5x40_1_0(POOL1_OUT, CONV2_K, CONV2_B, CONV2_OUT); }
+static void BenchPool2(void) { Pool2_8x8x40_2x2x40_2_0(CONV2_OUT, POOL2_OUT); }
+static void BenchFc1(void) { Fc1_40_400(POOL2_OUT, FC1_K, FC1_B, FC1_OUT); }
+static void BenchFc2(void) { Fc2_400_10(FC1_OUT, FC2_K, FC2_B, FC2_OUT); }
+static void BenchSoftmax(void) { Softmax(FC2_OUT, SOFTMAX_OUT); }
+
+int FixedBenchCases(bench_case cases[])
+{
+  unsigned int seed = BENCH_SEED;
+  int k;
+
+  for (k = 0; k < IMG_HEIGHT * IMG_WIDTH; k++)
+    (&INPUT[0][0][0])[k] = rand_r(&seed) % 256;
+  Fill(&CONV1_K[0][0][0][0], sizeof(CONV1_K) / sizeof(short), 128, &seed);
+  Fill(CONV1_B, CONV1_NBOUTPUT, 128, &seed);
+  Fill(&CONV2_K[0][0][0][0], sizeof(CONV2_K) / sizeof(short), 64, &seed);
+  Fill(CONV2_B, CONV2_NBOUTPUT, 64, &seed);
+  Fill(&FC1_K[0][0][0][0], sizeof(FC1_K) / sizeof(short), 32, &seed);
+  Fill(FC1_B, FC1_NBOUTPUT, 32, &seed);
+  Fill(&FC2_K[0][0], sizeof(FC2_K) / sizeof(short), 64, &seed);
+  Fill(FC2_B, FC2_NBOUTPUT, 64, &seed);
+
+  // each layer reads the output of the previous one
+  BenchConv1(); BenchPool1(); BenchConv2(); BenchPool2(); BenchFc1(); BenchFc2();
+
+  cases[0] = (bench_case){ "fixed", "Conv1_28x28x1_5x5x20_1_0", BenchConv1,
+                           (double)CONV1_NBOUTPUT * CONV1_HEIGHT * CONV1_WIDTH * IMG_DEPTH * CONV1_DIM * CONV1_DIM,
+                           sizeof(INPUT) + sizeof(CONV1_K) + sizeof(CONV1_B) + sizeof(CONV1_OUT) };
+  cases[1] = (bench_case){ "fixed", "Pool1_24x24x20_2x2x20_2_0", BenchPool1, 0, sizeof(CONV1_OUT) + sizeof(POOL1_OUT) };
+  cases[2] = (bench_case){ "fixed", "Conv2_12x12x20_5x5x40_1_0", BenchConv2,
+                           (double)CONV2_NBOUTPUT * CONV2_HEIGHT * CONV2_WIDTH * POOL1_NBOUTPUT * CONV2_DIM * CONV2_DIM,
+                           sizeof(POOL1_OUT) + sizeof(CONV2_K) + sizeof(CONV2_B) + sizeof(CONV2_OUT) };
+  cases[3] = (bench_case){ "fixed", "Pool2_8x8x40_2x2x40_2_0", BenchPool2, 0, sizeof(CONV2_OUT) + sizeof(POOL2_OUT) };
+  cases[4] = (bench_case){ "fixed", "Fc1_40_400", BenchFc1, (double)FC1_NBOUTPUT * POOL2_NBOUTPUT * POOL2_HEIGHT * POOL2_WIDTH,
+                           sizeof(POOL2_OUT) + sizeof(FC1_K) + sizeof(FC1_B) + sizeof(FC1_OUT) };
+  cases[5] = (bench_case){ "fixed", "Fc2_400_10", BenchFc2, (double)FC2_NBOUTPUT * FC1_NBOUTPUT,
+                           sizeof(FC1_OUT) + sizeof(FC2_K) + sizeof(FC2_B) + sizeof(FC2_OUT) };
+  cases[6] = (bench_case){ "fixed", "Softmax", BenchSoftmax, 0, sizeof(FC2_OUT) + sizeof(SOFTMAX_OUT) };
+
+  return 7;
+}
+
+static double NowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double TimeCalls(bench_call call, long calls)
+{
+  double tstart;
+  long k;
+
+  tstart = NowNs();
+  for (k = 0; k < calls; k++)
+    call();
+  return NowNs() - tstart;
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return x < y ? -1 : x > y;
+}
+
+void BenchRun(bench_case *bench, int warmup, int nb_samples, double *median, double *min)
+{
+  double samples[BENCH_MAX_SAMPLES];
+  long calls;
+  int s;
+
+  calls = 1;
+  while (TimeCalls(bench->call, calls) < BENCH_MIN_SAMPLE_NS)
+    calls *= 2;
+  for (s = 0; s < warmup; s++)
+    TimeCalls(bench->call, calls);
+  for (s = 0; s < nb_samples; s++)
+    samples[s] = TimeCalls(bench->call, calls) / calls;
+
+  qsort(samples, nb_samples, sizeof(double), CompareDouble);
+  *median = samples[nb_samples / 2];
+  *min = samples[0];
+}
+
+void BenchPin(int cpu)
+{
+  cpu_set_t cpus;
+
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+  {
+    printf("Error: Unable to pin to cpu %d.\n", cpu);
+    exit(1);
+  }
+}
@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    bench.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-layer microbenchmarks: one case per layer function of this tree
+  *          (bench.c) and of the FLOAT tree (bench_float.c), and the timing
+  *          harness shared by lenet_bench (make bench) and roofline
+  */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#define MAX_BENCH_CASES     32
+#define BENCH_MIN_SAMPLE_NS 200000  // calls per sample calibrated to last at least this long
+#define BENCH_WARMUP        10
+#define BENCH_SAMPLES       25
+#define BENCH_MAX_SAMPLES   1000
+
+// one call of the layer function on buffers prepared by the case
+typedef void (*bench_call)(void);
+
+typedef struct {
+  const char *tree;         // "fixed" or "float"
+  const char *layer;        // function name
+  bench_call call;
+  double macs;              // multiply-accumulates per call, 0 for pooling and softmax
+  double bytes;             // input + weights + bias + output bytes per call
+} bench_case;
+
+// adds the cases of the tree to cases, returns how many
+int FixedBenchCases(bench_case cases[]);   // OUT
+int FloatBenchCases(bench_case cases[]);   // OUT
+
+// median and min ns per call over nb_samples, after warmup samples
+void BenchRun(bench_case *bench, int warmup, int nb_samples, double *median, double *min);  // OUT
+
+// pins the calling thread, exits on failure
+void BenchPin(int cpu);
+
+#endif
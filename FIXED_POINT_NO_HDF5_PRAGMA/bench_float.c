@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file    bench_float.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Benchmark cases of the FLOAT tree layers, linked with the Float_ prefix (ref_names.h)
+  */
+
+#include <stdlib.h>
+
+#define REF_PREFIX Float_
+#include "ref_names.h"
+#include "../FLOAT/lenet_cnn_float.h"
+#include "bench.h"
+
+#define BENCH_SEED  42
+
+// random inputs and weights: the timing of these loops does not depend on the values
+static float INPUT[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+static float CONV1_K[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM];
+static float CONV1_B[CONV1_NBOUTPUT];
+static float CONV1_OUT[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+static float POOL1_OUT[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+static float CONV2_K[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+static float CONV2_B[CONV2_NBOUTPUT];
+static float CONV2_OUT[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+static float POOL2_OUT[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+static float FC1_K[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+static float FC1_B[FC1_NBOUTPUT];
+static float FC1_OUT[FC1_NBOUTPUT];
+static float FC2_K[FC2_NBOUTPUT][FC1_NBOUTPUT];
+static float FC2_B[FC2_NBOUTPUT];
+static float FC2_OUT[FC2_NBOUTPUT];
+static float SOFTMAX_OUT[FC2_NBOUTPUT];
+
+static void Fill(float *array, int size, unsigned int *seed)
+{
+  int k;
+
+  for (k = 0; k < size; k++)
+    array[k] = (float)rand_r(seed) / RAND_MAX - 0.5f;
+}
+
+static void BenchConv1(void) { Conv1_28x28x1_5x5x20_1_0(INPUT, CONV1_K, CONV1_B, CONV1_OUT); }
+static void BenchPool1(void) { Pool1_24x24x20_2x2x20_2_0(CONV1_OUT, POOL1_OUT); }
+static void BenchConv2(void) { Conv2_12x12x20_5x5x40_1_0(POOL1_OUT, CONV2_K, CONV2_B, CONV2_OUT); }
+static void BenchPool2(void) { Pool2_8x8x40_2x2x40_2_0(CONV2_OUT, POOL2_OUT); }
+static void BenchFc1(void) { Fc1_40_400(POOL2_OUT, FC1_K, FC1_B, FC1_OUT); }
+static void BenchFc2(void) { Fc2_400_10(FC1_OUT, FC2_K, FC2_B, FC2_OUT); }
+static void BenchSoftmax(void) { Softmax(FC2_OUT, SOFTMAX_OUT); }
+
+int FloatBenchCases(bench_case cases[])
+{
+  unsigned int seed = BENCH_SEED;
+
+  Fill(&INPUT[0][0][0], sizeof(INPUT) / sizeof(float), &seed);
+  Fill(&CONV1_K[0][0][0][0], sizeof(CONV1_K) / sizeof(float), &seed);
+  Fill(CONV1_B, CONV1_NBOUTPUT, &seed);
+  Fill(&CONV2_K[0][0][0][0], sizeof(CONV2_K) / sizeof(float), &seed);
+  Fill(CONV2_B, CONV2_NBOUTPUT, &seed);
+  Fill(&FC1_K[0][0][0][0], sizeof(FC1_K) / sizeof(float), &seed);
+  Fill(FC1_B, FC1_NBOUTPUT, &seed);
+  Fill(&FC2_K[0][0], sizeof(FC2_K) / sizeof(float), &seed);
+  Fill(FC2_B, FC2_NBOUTPUT, &seed);
+
+  // each layer reads the output of the previous one
+  BenchConv1(); BenchPool1(); BenchConv2(); BenchPool2(); BenchFc1(); BenchFc2();
+
+  cases[0] = (bench_case){ "float", "Conv1_28x28x1_5x5x20_1_0", BenchConv1,
+                           (double)CONV1_NBOUTPUT * CONV1_HEIGHT * CONV1_WIDTH * IMG_DEPTH * CONV1_DIM * CONV1_DIM,
+                           sizeof(INPUT) + sizeof(CONV1_K) + sizeof(CONV1_B) + sizeof(CONV1_OUT) };
+  cases[1] = (bench_case){ "float", "Pool1_24x24x20_2x2x20_2_0", BenchPool1, 0, sizeof(CONV1_OUT) + sizeof(POOL1_OUT) };
+  cases[2] = (bench_case){ "float", "Conv2_12x12x20_5x5x40_1_0", BenchConv2,
+                           (double)CONV2_NBOUTPUT * CONV2_HEIGHT * CONV2_WIDTH * POOL1_NBOUTPUT * CONV2_DIM * CONV2_DIM,
+                           sizeof(POOL1_OUT) + sizeof(CONV2_K) + sizeof(CONV2_B) + sizeof(CONV2_OUT) };
+  cases[3] = (bench_case){ "float", "Pool2_8x8x40_2x2x40_2_0", BenchPool2, 0, sizeof(CONV2_OUT) + sizeof(POOL2_OUT) };
+  cases[4] = (bench_case){ "float", "Fc1_40_400", BenchFc1, (double)FC1_NBOUTPUT * POOL2_NBOUTPUT * POOL2_HEIGHT * POOL2_WIDTH,
+                           sizeof(POOL2_OUT) + sizeof(FC1_K) + sizeof(FC1_B) + sizeof(FC1_OUT) };
+  cases[5] = (bench_case){ "float", "Fc2_400_10", BenchFc2, (double)FC2_NBOUTPUT * FC1_NBOUTPUT,
+                           sizeof(FC1_OUT) + sizeof(FC2_K) + sizeof(FC2_B) + sizeof(FC2_OUT) };
+  cases[6] = (bench_case){ "float", "Softmax", BenchSoftmax, 0, sizeof(FC2_OUT) + sizeof(SOFTMAX_OUT) };
+
+  return 7;
+}
@@ -0,0 +1,208 @@
+/**
+  ******************************************************************************
+  * @file    cache_eval.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Prediction cache of liblenet on a stream with exact duplicates
+  * @brief   usage: ./cache_eval [-d duplicate_rate] [-W recent] [-s stream_length] [-C capacity]
+  *                               [-S shards] [-j threads] [-n max_images]
+  *          The stream takes the test images in order; with probability
+  *          duplicate_rate a request repeats one of the last recent images
+  *          instead (retries, re-scans). The stream is classified without and
+  *          with a shared cache; labels must match and both rates are reported.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "lenet_cnn_float.h"
+#include "lenet.h"
+
+#define MAX_THREADS     64
+#define STREAM_SEED     1234
+
+typedef struct {
+  const lenet_model *model;
+  lenet_cache *cache;
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  int *stream;
+  unsigned char *predicted;
+  int stream_length;
+  int thread;
+  int nb_threads;
+} cache_job;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-d duplicate_rate] [-W recent] [-s stream_length] [-C capacity] [-S shards] [-j threads] [-n max_images]\n",
+         program);
+}
+
+static void *StreamThread(void *arg)
+{
+  cache_job *job = arg;
+  lenet_result result;
+  lenet_ctx *ctx;
+  int r;
+
+  ctx = lenet_ctx_create(job->model);
+  if (!ctx)
+  {
+    printf("Error: Unable to create the context of thread %d.\n", job->thread);
+    exit(1);
+  }
+  lenet_ctx_set_cache(ctx, job->cache);
+  for (r = job->thread; r < job->stream_length; r += job->nb_threads)
+  {
+    lenet_infer(ctx, &job->images[job->stream[r]][0][0][0], &result);
+    job->predicted[r] = result.label;
+  }
+  lenet_ctx_destroy(ctx);
+  return NULL;
+}
+
+static double RunStream(cache_job *job, int nb_threads)
+{
+  pthread_t threads[MAX_THREADS];
+  cache_job jobs[MAX_THREADS];
+  double tstart;
+  int t;
+
+  tstart = TimeNow();
+  for (t = 0; t < nb_threads; t++)
+  {
+    jobs[t] = *job;
+    jobs[t].thread = t;
+    jobs[t].nb_threads = nb_threads;
+    if (pthread_create(&threads[t], NULL, StreamThread, &jobs[t]) != 0)
+    {
+      printf("Error: Unable to start thread %d.\n", t);
+      exit(1);
+    }
+  }
+  for (t = 0; t < nb_threads; t++)
+    pthread_join(threads[t], NULL);
+  return TimeNow() - tstart;
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES];
+  lenet_cache_stats stats;
+  cache_job job;
+  lenet_model *model;
+  unsigned char *reference;
+  unsigned int seed, error, mismatch, duplicates;
+  int opt, r, next, recent, stream_length, capacity, nb_shards, nb_threads, nb_images, max_images;
+  double duplicate_rate, tplain, tcached;
+
+  duplicate_rate = 0.3;
+  recent = 1000;
+  stream_length = 20000;
+  capacity = 4096;
+  nb_shards = 16;
+  nb_threads = 1;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "d:W:s:C:S:j:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'd': duplicate_rate = atof(optarg); break;
+    case 'W': recent = atoi(optarg); break;
+    case 's': stream_length = atoi(optarg); break;
+    case 'C': capacity = atoi(optarg); break;
+    case 'S': nb_shards = atoi(optarg); break;
+    case 'j': nb_threads = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_threads < 1 || nb_threads > MAX_THREADS)
+    nb_threads = 1;
+  if (recent < 1)
+    recent = 1;
+  if (stream_length < 1)
+    stream_length = 1;
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  job.stream = malloc(sizeof(int) * stream_length);
+  reference = malloc(stream_length);
+  model = lenet_model_create();
+  if (!job.stream || !reference || !model)
+  {
+    printf("Error: Unable to allocate a stream of %d images.\n", stream_length);
+    exit(1);
+  }
+
+  // test images in order, repeats drawn from the last recent ones
+  seed = STREAM_SEED;
+  next = 0;
+  duplicates = 0;
+  for (r = 0; r < stream_length; r++)
+  {
+    if (next > 0 && rand_r(&seed) < duplicate_rate * RAND_MAX)
+    {
+      job.stream[r] = (next - 1 - rand_r(&seed) % (next < recent ? next : recent)) % nb_images;
+      duplicates++;
+    }
+    else
+      job.stream[r] = next++ % nb_images;
+  }
+  job.model = model;
+  job.images = images;
+  job.stream_length = stream_length;
+
+  job.cache = NULL;
+  job.predicted = reference;
+  tplain = RunStream(&job, nb_threads);
+
+  job.cache = lenet_cache_create(capacity, nb_shards);
+  job.predicted = malloc(stream_length);
+  if (!job.cache || !job.predicted)
+  {
+    printf("Error: Unable to allocate a cache of %d entries in %d shards (power of two).\n", capacity, nb_shards);
+    exit(1);
+  }
+  tcached = RunStream(&job, nb_threads);
+  lenet_cache_get_stats(job.cache, &stats);
+
+  error = 0;
+  mismatch = 0;
+  for (r = 0; r < stream_length; r++)
+  {
+    if (job.predicted[r] != labels[job.stream[r]])
+      error = error + 1;
+    if (job.predicted[r] != reference[r])
+      mismatch = mismatch + 1;
+  }
+
+  printf("\nStream of %d images, %u repeats (rate %.2f, among the last %d), %d threads\n", stream_length, duplicates,
+         duplicate_rate, recent, nb_threads);
+  printf("Cache: %d entries in %d shards, %d used\n", stats.capacity, nb_shards, stats.entries);
+  printf("Hits %llu, misses %llu (hit rate %.1f%%), evictions %llu\n", stats.hits, stats.misses,
+         100.0 * stats.hits / (stats.hits + stats.misses), stats.evictions);
+  printf("Without cache: %f s, %.1f images/s\n", tplain, stream_length / tplain);
+  printf("With cache   : %f s, %.1f images/s (x%.2f)\n", tcached, stream_length / tcached, tplain / tcached);
+  printf("Labels different from the uncached run: %u\n", mismatch);
+  printf("\n\nErrors : %d / %d", error, stream_length);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / stream_length)) * 100);
+  printf("\n\n");
+
+  lenet_cache_destroy(job.cache);
+  lenet_model_destroy(model);
+  free(job.stream);
+  free(job.predicted);
+  free(reference);
+
+  return mismatch ? 1 : 0;
+}
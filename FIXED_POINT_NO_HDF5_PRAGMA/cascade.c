@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    cascade.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Adaptive precision inference: low precision engine first,
+  *          float fallback only for the close calls
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lenet_cnn_float.h"
+#include "engine.h"
+
+// difference between the two highest logits (float units)
+float LogitMargin(float logits[FC2_NBOUTPUT])
+{
+  float first, second;
+  short k;
+
+  first = logits[0];
+  second = logits[1];
+  if (second > first) {
+    first = logits[1];
+    second = logits[0];
+  }
+  for (k = 2; k < FC2_NBOUTPUT; k++) {
+    if (logits[k] > first) {
+      second = first;
+      first = logits[k];
+    } else if (logits[k] > second) {
+      second = logits[k];
+    }
+  }
+
+  return first - second;
+}
+
+unsigned char CascadeRun(lenet_engine *cheap, lenet_engine *fallback, float min_margin,
+                         unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],     // IN
+                         float logits[FC2_NBOUTPUT],                                // OUT
+                         int *escalated)                                            // OUT
+{
+  unsigned char number;
+
+  number = cheap->run(input, logits, NULL);
+
+  *escalated = LogitMargin(logits) < min_margin;
+  if (*escalated)
+    number = fallback->run(input, logits, NULL);
+
+  return number;
+}
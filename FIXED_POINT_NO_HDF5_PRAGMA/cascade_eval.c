@@ -0,0 +1,133 @@
+/**
+  ******************************************************************************
+  * @file    cascade_eval.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Accuracy, escalation rate and throughput of the adaptive precision cascade
+  * @brief   usage: ./cascade_eval [-c cheap_engine] [-f fallback_engine] [-m min_margin] [-n max_images]
+  *          without -m, a range of margins is swept
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "engine.h"
+
+#define DEFAULT_CHEAP       "fixed"
+#define DEFAULT_FALLBACK    "float"
+
+static const float sweep_margins[] = { 0, 0.5, 1, 2, 3, 4, 6, 8 };
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-c cheap_engine] [-f fallback_engine] [-m min_margin] [-n max_images]\n\n", program);
+  printf("engines:\n");
+  ListEngines();
+}
+
+// errors and images/s of one engine alone
+static void EvalEngine(lenet_engine *engine, unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],
+                       unsigned char *labels, int nb_images)
+{
+  float logits[FC2_NBOUTPUT];
+  unsigned int error;
+  double tstart, tdiff;
+  int m;
+
+  error = 0;
+  tstart = TimeNow();
+  for (m = 0; m < nb_images; m++)
+    if (engine->run(images[m], logits, NULL) != labels[m])
+      error++;
+  tdiff = TimeNow() - tstart;
+
+  printf("%-12s %8u / %-5d %8.2f%% %12.1f\n", engine->name, error, nb_images,
+         (1 - ((double)error / nb_images)) * 100, nb_images / tdiff);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  lenet_engine *cheap, *fallback;
+  char *cheap_name, *fallback_name;
+  float logits[FC2_NBOUTPUT], margin;
+  unsigned int error, nb_escalated;
+  int opt, m, s, nb_margins, escalated, nb_images, max_images;
+  double tstart, tdiff;
+
+  cheap_name = DEFAULT_CHEAP;
+  fallback_name = DEFAULT_FALLBACK;
+  margin = -1;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "c:f:m:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'c': cheap_name = optarg; break;
+    case 'f': fallback_name = optarg; break;
+    case 'm': margin = atof(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  cheap = FindEngine(cheap_name);
+  fallback = FindEngine(fallback_name);
+  if (!cheap || !fallback)
+  {
+    printf("Error: Unknown engine %s.\n\n", !cheap ? cheap_name : fallback_name);
+    Usage(argv[0]);
+    return 2;
+  }
+
+  images = malloc(sizeof(*images) * max_images);
+  if (!images)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  printf("\n%-12s %14s %9s %12s\n", "engine", "errors", "success", "images/s");
+  EvalEngine(cheap, images, labels, nb_images);
+  EvalEngine(fallback, images, labels, nb_images);
+
+  printf("\nCascade %s -> %s, fallback when top-1 / top-2 logit margin < min margin\n\n", cheap->name, fallback->name);
+  printf("%10s %10s %14s %9s %12s\n", "min margin", "escalated", "errors", "success", "images/s");
+
+  nb_margins = margin < 0 ? sizeof(sweep_margins) / sizeof(sweep_margins[0]) : 1;
+  for (s = 0; s < nb_margins; s++)
+  {
+    if (nb_margins > 1)
+      margin = sweep_margins[s];
+
+    error = 0;
+    nb_escalated = 0;
+    tstart = TimeNow();
+    for (m = 0; m < nb_images; m++)
+    {
+      if (CascadeRun(cheap, fallback, margin, images[m], logits, &escalated) != labels[m])
+        error++;
+      nb_escalated += escalated;
+    }
+    tdiff = TimeNow() - tstart;
+
+    printf("%10.2f %9.2f%% %8u / %-5d %8.2f%% %12.1f\n", margin, (double)nb_escalated * 100 / nb_images,
+           error, nb_images, (1 - ((double)error / nb_images)) * 100, nb_images / tdiff);
+  }
+  printf("\n");
+
+  free(images);
+
+  return 0;
+}
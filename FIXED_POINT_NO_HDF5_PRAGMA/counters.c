@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * @file    counters.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-layer hardware performance counters (perf_event_open)
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "counters.h"
+
+static const char *LAYER_NAMES[NB_LAYERS] = { "Conv1", "Pool1", "Conv2", "Pool2", "Fc1", "Fc2" };
+
+static const struct {
+  const char *name;
+  unsigned int type;
+  unsigned long long config;
+} EVENTS[NB_COUNTERS] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "L1D misses", PERF_TYPE_HW_CACHE,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { "LLC misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+  { "branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+// read format of the group: nr, time enabled, time running, one value per opened event
+typedef struct {
+  unsigned long long nr;
+  unsigned long long time_enabled;
+  unsigned long long time_running;
+  unsigned long long values[NB_COUNTERS];
+} group_read;
+
+static int FDS[NB_COUNTERS];
+static int SLOT[NB_COUNTERS];              // position in values[], -1 when unavailable
+static int NB_OPENED;
+static group_read START;
+static unsigned long long START_NS;
+
+static unsigned long long TOTALS[NB_LAYERS][NB_COUNTERS];
+static unsigned long long LAYER_NS[NB_LAYERS];
+static unsigned long long ENABLED_NS, RUNNING_NS;
+
+static int OpenEvent(int e, int group_fd)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = EVENTS[e].type;
+  attr.config = EVENTS[e].config;
+  attr.disabled = group_fd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static unsigned long long NowNs(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+int CountersOpen(void)
+{
+  int e, leader;
+
+  memset(TOTALS, 0, sizeof(TOTALS));
+  memset(LAYER_NS, 0, sizeof(LAYER_NS));
+  ENABLED_NS = RUNNING_NS = 0;
+  NB_OPENED = 0;
+  leader = -1;
+  for (e = 0; e < NB_COUNTERS; e++)
+  {
+    FDS[e] = OpenEvent(e, leader);
+    SLOT[e] = -1;
+    if (FDS[e] < 0)
+    {
+      printf("Counter %s unavailable: %s\n", EVENTS[e].name, strerror(errno));
+      continue;
+    }
+    if (leader == -1)
+      leader = FDS[e];
+    SLOT[e] = NB_OPENED++;
+  }
+  if (leader != -1)
+  {
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  return NB_OPENED;
+}
+
+void CountersClose(void)
+{
+  int e;
+
+  for (e = NB_COUNTERS - 1; e >= 0; e--)
+    if (FDS[e] >= 0)
+      close(FDS[e]);
+  NB_OPENED = 0;
+}
+
+static void ReadGroup(group_read *values)
+{
+  int e;
+
+  for (e = 0; e < NB_COUNTERS; e++)
+    if (SLOT[e] == 0)
+      break;
+  if (e == NB_COUNTERS || read(FDS[e], values, sizeof(group_read)) <= 0)
+    memset(values, 0, sizeof(group_read));
+}
+
+void CountersStart(void)
+{
+  if (NB_OPENED)
+    ReadGroup(&START);
+  START_NS = NowNs();
+}
+
+void CountersStop(int layer)
+{
+  group_read end;
+  int e;
+
+  LAYER_NS[layer] += NowNs() - START_NS;
+  if (!NB_OPENED)
+    return;
+  ReadGroup(&end);
+  for (e = 0; e < NB_COUNTERS; e++)
+    if (SLOT[e] >= 0)
+      TOTALS[layer][e] += end.values[SLOT[e]] - START.values[SLOT[e]];
+  ENABLED_NS += end.time_enabled - START.time_enabled;
+  RUNNING_NS += end.time_running - START.time_running;
+}
+
+void CountersPrint(int nb_images)
+{
+  int l, e;
+
+  if (nb_images <= 0)
+    return;
+  printf("\nPer image   %10s", "ns");
+  for (e = 0; e < NB_COUNTERS; e++)
+    printf(" %13s", EVENTS[e].name);
+  printf(" %7s\n", "IPC");
+  for (l = 0; l < NB_LAYERS; l++)
+  {
+    printf("%-11s %10.1f", LAYER_NAMES[l], (double)LAYER_NS[l] / nb_images);
+    for (e = 0; e < NB_COUNTERS; e++)
+    {
+      if (SLOT[e] >= 0)
+        printf(" %13.1f", (double)TOTALS[l][e] / nb_images);
+      else
+        printf(" %13s", "n/a");
+    }
+    if (SLOT[COUNTER_CYCLES] >= 0 && SLOT[COUNTER_INSTRUCTIONS] >= 0 && TOTALS[l][COUNTER_CYCLES])
+      printf(" %7.2f\n", (double)TOTALS[l][COUNTER_INSTRUCTIONS] / TOTALS[l][COUNTER_CYCLES]);
+    else
+      printf(" %7s\n", "n/a");
+  }
+  // events multiplexed with other users of the PMU are only counted part of the time
+  if (NB_OPENED && RUNNING_NS < ENABLED_NS)
+    printf("Counters running %.1f%% of the enabled time, counts not scaled\n", 100.0 * RUNNING_NS / ENABLED_NS);
+}
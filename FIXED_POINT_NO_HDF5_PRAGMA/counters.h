@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    counters.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-layer hardware performance counters (perf_event_open)
+  * @brief   lenet_cnn.c built with -DLAYER_COUNTERS (counters_lenet_cnn.o) wraps
+  *          each layer call in CountersStart / CountersStop; without the flag
+  *          LAYER_COUNT is the bare call. The counters are one perf event group
+  *          (user space only) on the calling thread: cycles, instructions,
+  *          L1D read misses, LLC misses and branch misses. Events the cpu or
+  *          the hypervisor does not expose are reported as unavailable, the
+  *          time per layer is always measured.
+  */
+
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+enum { LAYER_CONV1, LAYER_POOL1, LAYER_CONV2, LAYER_POOL2, LAYER_FC1, LAYER_FC2, NB_LAYERS };
+enum { COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_L1D_MISSES, COUNTER_LLC_MISSES, COUNTER_BRANCH_MISSES, NB_COUNTERS };
+
+// opens the group on the calling thread, returns the number of available events
+int CountersOpen(void);
+void CountersClose(void);
+
+void CountersStart(void);
+void CountersStop(int layer);
+
+// per-layer time, counts per image and IPC over nb_images
+void CountersPrint(int nb_images);
+
+#ifdef LAYER_COUNTERS
+#define LAYER_COUNT(layer, call)  do { CountersStart(); call; CountersStop(layer); } while (0)
+#else
+#define LAYER_COUNT(layer, call)  call
+#endif
+
+#endif
@@ -0,0 +1,228 @@
+/**
+  ******************************************************************************
+  * @file    engine.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Registry of the network implementations and fixed point engines of this tree
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lenet_cnn_float.h"
+#include "engine.h"
+
+enum { VARIANT_FIXED, VARIANT_FC1_TERNARY, VARIANT_FC1_POW2, VARIANT_POW2, VARIANT_FC1_CSR, VARIANT_EARLY_EXIT };
+
+const char *LAYER_NAMES[NB_LAYERS] = { "conv1", "pool1", "conv2", "pool2", "fc1", "fc2" };
+
+// quantized / compressed weights, built by the init functions
+static unsigned char FC1_TERNARY[FC1_NBOUTPUT][FC1_TERNARY_BYTES];
+static short FC1_TERNARY_SCALE[FC1_NBOUTPUT];
+static unsigned char FC1_POW2[FC1_NBOUTPUT][FC1_POW2_BYTES];
+static unsigned char CONV2_POW2[CONV2_NBOUTPUT][CONV2_POW2_BYTES];
+static unsigned int FC1_ROW_PTR[FC1_NBOUTPUT+1];
+static unsigned char FC1_COL_DELTA[FC1_MAX_ENTRIES];
+static signed char FC1_VALUES[FC1_MAX_ENTRIES];
+static short EXIT_KERNEL[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+static short EXIT_BIAS[FC2_NBOUTPUT];
+
+
+void FixedToTrace(short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH],
+                  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH],
+                  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH],
+                  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],
+                  short fc1_output[FC1_NBOUTPUT],
+                  short fc2_output[FC2_NBOUTPUT],
+                  layer_trace *trace)
+{
+  short *fixed[NB_LAYERS];
+  float *out;
+  int layer, size, i;
+
+  fixed[LAYER_CONV1] = &conv1_output[0][0][0];
+  fixed[LAYER_POOL1] = &pool1_output[0][0][0];
+  fixed[LAYER_CONV2] = &conv2_output[0][0][0];
+  fixed[LAYER_POOL2] = &pool2_output[0][0][0];
+  fixed[LAYER_FC1] = fc1_output;
+  fixed[LAYER_FC2] = fc2_output;
+
+  for (layer = 0; layer < NB_LAYERS; layer++) {
+    out = TraceLayer(trace, layer, &size);
+    for (i = 0; i < size; i++)
+      out[i] = (float)fixed[layer][i] / (1 << FIXED_POINT);
+  }
+}
+
+float *TraceLayer(layer_trace *trace, int layer, int *size)
+{
+  switch (layer) {
+  case LAYER_CONV1: *size = sizeof(trace->conv1) / sizeof(float); return &trace->conv1[0][0][0];
+  case LAYER_POOL1: *size = sizeof(trace->pool1) / sizeof(float); return &trace->pool1[0][0][0];
+  case LAYER_CONV2: *size = sizeof(trace->conv2) / sizeof(float); return &trace->conv2[0][0][0];
+  case LAYER_POOL2: *size = sizeof(trace->pool2) / sizeof(float); return &trace->pool2[0][0][0];
+  case LAYER_FC1:   *size = sizeof(trace->fc1) / sizeof(float);   return trace->fc1;
+  default:          *size = sizeof(trace->fc2) / sizeof(float);   return trace->fc2;
+  }
+}
+
+// fixed point network with one of the FC1 / Conv2 variants
+static unsigned char FixedRun(int variant,
+                              unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                              float logits[FC2_NBOUTPUT],                             // OUT
+                              layer_trace *trace)                                     // OUT
+{
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  unsigned char number;
+  short k;
+
+  Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output);
+  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+
+  if (variant == VARIANT_POW2)
+    Conv2_12x12x20_5x5x40_1_0_pow2(pool1_output, CONV2_POW2, CONV2_BIAS, conv2_output);
+  else
+    Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
+
+  Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
+
+  // confident head: FC1 is skipped (traced as zeros), the head logits are the output
+  if (variant == VARIANT_EARLY_EXIT) {
+    ExitHead_40_10(pool2_output, EXIT_KERNEL, EXIT_BIAS, fc2_output);
+    if (ExitConfidence(fc2_output, &number) >= EXIT_DEFAULT_THRESHOLD) {
+      for (k = 0; k < FC1_NBOUTPUT; k++)
+        fc1_output[k] = 0;
+      if (trace)
+        FixedToTrace(conv1_output, pool1_output, conv2_output, pool2_output, fc1_output, fc2_output, trace);
+      for (k = 0; k < FC2_NBOUTPUT; k++)
+        logits[k] = (float)fc2_output[k] / (1 << FIXED_POINT);
+      return number;
+    }
+  }
+
+  switch (variant) {
+  case VARIANT_FC1_TERNARY:
+    Fc1_40_400_ternary(pool2_output, FC1_TERNARY, FC1_TERNARY_SCALE, FC1_BIAS, fc1_output);
+    break;
+  case VARIANT_FC1_POW2:
+  case VARIANT_POW2:
+    Fc1_40_400_pow2(pool2_output, FC1_POW2, FC1_BIAS, fc1_output);
+    break;
+  case VARIANT_FC1_CSR:
+    Fc1_40_400_csr(pool2_output, FC1_ROW_PTR, FC1_COL_DELTA, FC1_VALUES, FC1_BIAS, fc1_output);
+    break;
+  default:
+    Fc1_40_400(pool2_output, FC1_KERNEL, FC1_BIAS, fc1_output);
+  }
+
+  Fc2_400_10(fc1_output, FC2_KERNEL, FC2_BIAS, fc2_output);
+
+  if (trace)
+    FixedToTrace(conv1_output, pool1_output, conv2_output, pool2_output, fc1_output, fc2_output, trace);
+
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+    logits[k] = (float)fc2_output[k] / (1 << FIXED_POINT);
+
+  Softmax(fc2_output, softmax_output);
+  return ClassifySoftmax(softmax_output);
+}
+
+static unsigned char RunFixed(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace)
+{
+  return FixedRun(VARIANT_FIXED, input, logits, trace);
+}
+
+static unsigned char RunFc1Ternary(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace)
+{
+  return FixedRun(VARIANT_FC1_TERNARY, input, logits, trace);
+}
+
+static unsigned char RunFc1Pow2(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace)
+{
+  return FixedRun(VARIANT_FC1_POW2, input, logits, trace);
+}
+
+static unsigned char RunPow2(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace)
+{
+  return FixedRun(VARIANT_POW2, input, logits, trace);
+}
+
+static unsigned char RunFc1Csr(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace)
+{
+  return FixedRun(VARIANT_FC1_CSR, input, logits, trace);
+}
+
+static unsigned char RunEarlyExit(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace)
+{
+  return FixedRun(VARIANT_EARLY_EXIT, input, logits, trace);
+}
+
+static void InitTernary(void)
+{
+  QuantizeFc1Ternary(FC1_KERNEL, FC1_TERNARY, FC1_TERNARY_SCALE);
+}
+
+static void InitPow2(void)
+{
+  QuantizeFc1Pow2(FC1_KERNEL, FC1_POW2);
+  QuantizeConv2Pow2(CONV2_KERNEL, CONV2_POW2);
+}
+
+static void InitCsr(void)
+{
+  // threshold 0 only drops the exact zeros, results stay bit-exact
+  PruneFc1(FC1_KERNEL, 0, FC1_ROW_PTR, FC1_COL_DELTA, FC1_VALUES);
+}
+
+static void InitEarlyExit(void)
+{
+  if (!LoadExitHead(EXIT_HEAD_FILE, EXIT_KERNEL, EXIT_BIAS))
+    BuildExitHead(FC1_KERNEL, FC1_BIAS, FC2_KERNEL, FC2_BIAS, EXIT_KERNEL, EXIT_BIAS);
+}
+
+lenet_engine ENGINES[] = {
+  { "float",       "FLOAT tree, float weights from ../FLOAT/lenet_weights.hdf5",    FloatEngineInit, FloatEngineRun, 0 },
+  { "fixed",       "this tree, 8-bit fractional fixed point (reference)",           NULL,            RunFixed,       0 },
+  { "sdsoc",       "FIXED_POINT_NO_HDF5_PRAGMA_SDSOC tree and its own weights.h",    NULL,            SdsocEngineRun, 0 },
+  { "fc1-ternary", "fixed point, ternary FC1 (quant.c)",                            InitTernary,     RunFc1Ternary,  0 },
+  { "fc1-pow2",    "fixed point, power of two FC1 (quant.c)",                       InitPow2,        RunFc1Pow2,     0 },
+  { "pow2",        "fixed point, power of two FC1 and Conv2 (quant.c)",             InitPow2,        RunPow2,        0 },
+  { "fc1-csr",     "fixed point, CSR FC1 without pruning (sparse.c)",               InitCsr,         RunFc1Csr,      0 },
+  { "early-exit",  "fixed point, Pool2 exit head skips FC1 when confident (exit_head.c)", InitEarlyExit, RunEarlyExit, 0 },
+};
+
+const int NB_ENGINES = sizeof(ENGINES) / sizeof(ENGINES[0]);
+
+lenet_engine *FindEngine(const char *name)
+{
+  int e;
+
+  for (e = 0; e < NB_ENGINES; e++) {
+    if (strcmp(ENGINES[e].name, name) == 0) {
+      if (!ENGINES[e].ready) {
+        if (ENGINES[e].init)
+          ENGINES[e].init();
+        ENGINES[e].ready = 1;
+      }
+      return &ENGINES[e];
+    }
+  }
+
+  return NULL;
+}
+
+void ListEngines(void)
+{
+  int e;
+
+  for (e = 0; e < NB_ENGINES; e++)
+    printf("  %-12s %s\n", ENGINES[e].name, ENGINES[e].description);
+}
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    engine.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Interchangeable implementations of the whole network (engines)
+  * @brief   Every engine can export its intermediate tensors in float units
+  *          (fixed point values are divided by 2^FIXED_POINT) so that any two
+  *          implementations can be compared layer by layer.
+  *          Include after lenet_cnn_float.h (of this tree or of a sibling tree).
+  */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+enum { LAYER_CONV1, LAYER_POOL1, LAYER_CONV2, LAYER_POOL2, LAYER_FC1, LAYER_FC2, NB_LAYERS };
+
+// intermediate tensors of one inference, conv1_output through the logits
+typedef struct {
+  float conv1[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  float pool1[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  float conv2[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  float pool2[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  float fc1[FC1_NBOUTPUT];
+  float fc2[FC2_NBOUTPUT];
+} layer_trace;
+
+// runs one image, fills logits (float units) and trace when not NULL,
+// returns the predicted class as selected by the engine's own softmax
+typedef unsigned char (*engine_run)(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                                    float logits[FC2_NBOUTPUT],                             // OUT
+                                    layer_trace *trace);                                    // OUT
+
+typedef struct {
+  const char *name;
+  const char *description;
+  void (*init)(void);         // one time setup (weights loading, quantization)
+  engine_run run;             // reentrant once init has been called
+  int ready;
+} lenet_engine;
+
+extern lenet_engine ENGINES[];
+extern const int NB_ENGINES;
+extern const char *LAYER_NAMES[NB_LAYERS];
+
+lenet_engine *FindEngine(const char *name);   // initialized engine or NULL
+void ListEngines(void);
+float *TraceLayer(layer_trace *trace, int layer, int *size);
+
+void FixedToTrace(short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH],
+                  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH],
+                  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH],
+                  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],
+                  short fc1_output[FC1_NBOUTPUT],
+                  short fc2_output[FC2_NBOUTPUT],
+                  layer_trace *trace);
+
+// engines built from the sibling trees (engine_float.c, engine_sdsoc.c)
+void FloatEngineInit(void);
+unsigned char FloatEngineRun(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace);
+unsigned char SdsocEngineRun(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], float logits[FC2_NBOUTPUT], layer_trace *trace);
+
+// Adaptive precision cascade (cascade.c): the cheap engine answers unless the
+// gap between its two highest logits is below min_margin, then the fallback runs
+float LogitMargin(float logits[FC2_NBOUTPUT]);
+unsigned char CascadeRun(lenet_engine *cheap, lenet_engine *fallback, float min_margin,
+                         unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],     // IN
+                         float logits[FC2_NBOUTPUT],                                // OUT
+                         int *escalated);                                           // OUT
+
+#endif
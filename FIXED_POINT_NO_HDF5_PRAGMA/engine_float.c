@@ -0,0 +1,101 @@
+/**
+  ******************************************************************************
+  * @file    engine_float.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   "float" engine: layers of the FLOAT tree, linked with the Float_ prefix (ref_names.h)
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REF_PREFIX Float_
+#include "ref_names.h"
+#include "../FLOAT/lenet_cnn_float.h"
+#include "engine.h"
+
+#define FLOAT_WEIGHTS_FILE  "../FLOAT/lenet_weights.hdf5"
+
+static float FLOAT_CONV1_KERNEL[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM];
+static float FLOAT_CONV1_BIAS[CONV1_NBOUTPUT];
+static float FLOAT_CONV2_KERNEL[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+static float FLOAT_CONV2_BIAS[CONV2_NBOUTPUT];
+static float FLOAT_FC1_KERNEL[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+static float FLOAT_FC1_BIAS[FC1_NBOUTPUT];
+static float FLOAT_FC2_KERNEL[FC2_NBOUTPUT][FC1_NBOUTPUT];
+static float FLOAT_FC2_BIAS[FC2_NBOUTPUT];
+
+void FloatEngineInit(void)
+{
+  FILE *hdf5_file;
+
+  // the hdf5 library would only print a stack of errors
+  hdf5_file = fopen(FLOAT_WEIGHTS_FILE, "rb");
+  if (!hdf5_file)
+  {
+    printf("Error: Unable to open file %s.\n", FLOAT_WEIGHTS_FILE);
+    exit(1);
+  }
+  fclose(hdf5_file);
+
+  ReadConv1Weights(FLOAT_WEIGHTS_FILE, "conv2d_1/conv2d_1/kernel:0", FLOAT_CONV1_KERNEL);
+  ReadConv1Bias(FLOAT_WEIGHTS_FILE, "conv2d_1/conv2d_1/bias:0", FLOAT_CONV1_BIAS);
+  ReadConv2Weights(FLOAT_WEIGHTS_FILE, "conv2d_2/conv2d_2/kernel:0", FLOAT_CONV2_KERNEL);
+  ReadConv2Bias(FLOAT_WEIGHTS_FILE, "conv2d_2/conv2d_2/bias:0", FLOAT_CONV2_BIAS);
+  ReadFc1Weights(FLOAT_WEIGHTS_FILE, "dense_1/dense_1/kernel:0", FLOAT_FC1_KERNEL);
+  ReadFc1Bias(FLOAT_WEIGHTS_FILE, "dense_1/dense_1/bias:0", FLOAT_FC1_BIAS);
+  ReadFc2Weights(FLOAT_WEIGHTS_FILE, "dense_2/dense_2/kernel:0", FLOAT_FC2_KERNEL);
+  ReadFc2Bias(FLOAT_WEIGHTS_FILE, "dense_2/dense_2/bias:0", FLOAT_FC2_BIAS);
+}
+
+unsigned char FloatEngineRun(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                             float logits[FC2_NBOUTPUT],                             // OUT
+                             layer_trace *trace)                                     // OUT
+{
+  float input_norm[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  float conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  float pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  float conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  float pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  float fc1_output[FC1_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  float max;
+  unsigned char number;
+  short k;
+
+  NormalizeImg((unsigned char *)input, (float *)input_norm, IMG_WIDTH, IMG_HEIGHT);
+
+  Conv1_28x28x1_5x5x20_1_0(input_norm, FLOAT_CONV1_KERNEL, FLOAT_CONV1_BIAS, conv1_output);
+  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+  Conv2_12x12x20_5x5x40_1_0(pool1_output, FLOAT_CONV2_KERNEL, FLOAT_CONV2_BIAS, conv2_output);
+  Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
+  Fc1_40_400(pool2_output, FLOAT_FC1_KERNEL, FLOAT_FC1_BIAS, fc1_output);
+  Fc2_400_10(fc1_output, FLOAT_FC2_KERNEL, FLOAT_FC2_BIAS, logits);
+
+  if (trace)
+  {
+    // already in float units
+    memcpy(trace->conv1, conv1_output, sizeof(conv1_output));
+    memcpy(trace->pool1, pool1_output, sizeof(pool1_output));
+    memcpy(trace->conv2, conv2_output, sizeof(conv2_output));
+    memcpy(trace->pool2, pool2_output, sizeof(pool2_output));
+    memcpy(trace->fc1, fc1_output, sizeof(fc1_output));
+    memcpy(trace->fc2, logits, sizeof(trace->fc2));
+  }
+
+  // same selection as the FLOAT main test loop
+  Softmax(logits, softmax_output);
+  max = 0;
+  number = 0;
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+  {
+    if (softmax_output[k] > max)
+    {
+      max = softmax_output[k];
+      number = k;
+    }
+  }
+  return number;
+}
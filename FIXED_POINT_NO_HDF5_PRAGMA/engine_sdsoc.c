@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    engine_sdsoc.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   "sdsoc" engine: layers and weights of the FIXED_POINT_NO_HDF5_PRAGMA_SDSOC tree,
+  *          linked with the Sdsoc_ prefix (ref_names.h)
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define REF_PREFIX Sdsoc_
+#include "ref_names.h"
+#include "../FIXED_POINT_NO_HDF5_PRAGMA_SDSOC/lenet_cnn_float.h"
+#include "engine.h"
+
+// own copy of the SDSoC tree weights, kept apart from weights.c
+#define CONV1_KERNEL    SDSOC_CONV1_KERNEL
+#define CONV2_KERNEL    SDSOC_CONV2_KERNEL
+#define FC1_KERNEL      SDSOC_FC1_KERNEL
+#define FC2_KERNEL      SDSOC_FC2_KERNEL
+#define CONV1_BIAS      SDSOC_CONV1_BIAS
+#define CONV2_BIAS      SDSOC_CONV2_BIAS
+#define FC1_BIAS        SDSOC_FC1_BIAS
+#define FC2_BIAS        SDSOC_FC2_BIAS
+#include "../FIXED_POINT_NO_HDF5_PRAGMA_SDSOC/weights.h"
+
+unsigned char SdsocEngineRun(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                             float logits[FC2_NBOUTPUT],                             // OUT
+                             layer_trace *trace)                                     // OUT
+{
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  float max;
+  unsigned char number;
+  short k;
+
+  // same body as lenet_cnn() of the SDSoC tree
+  Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output);
+  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+  Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
+  Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
+  Fc1_40_400(pool2_output, FC1_KERNEL, FC1_BIAS, fc1_output);
+  Fc2_400_10(fc1_output, FC2_KERNEL, FC2_BIAS, fc2_output);
+
+  if (trace)
+    FixedToTrace(conv1_output, pool1_output, conv2_output, pool2_output, fc1_output, fc2_output, trace);
+
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+    logits[k] = (float)fc2_output[k] / (1 << FIXED_POINT);
+
+  // same selection as the SDSoC main test loop
+  Softmax(fc2_output, softmax_output);
+  max = 0;
+  number = 0;
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+  {
+    if (softmax_output[k] > max)
+    {
+      max = softmax_output[k];
+      number = k;
+    }
+  }
+  return number;
+}
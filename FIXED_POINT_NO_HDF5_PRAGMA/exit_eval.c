@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    exit_eval.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Exit rate, accuracy and average cost per image of the Pool2 early exit head
+  * @brief   usage: ./exit_eval [-f exit_head.txt] [-t threshold] [-n max_images]
+  *          without -t, a range of confidence thresholds is swept
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+
+// multiply-accumulates and weight bytes of each part of the network
+#define CONV1_MACS      (CONV1_NBOUTPUT*CONV1_HEIGHT*CONV1_WIDTH*IMG_DEPTH*CONV1_DIM*CONV1_DIM)      // 288000
+#define CONV2_MACS      (CONV2_NBOUTPUT*CONV2_HEIGHT*CONV2_WIDTH*POOL1_NBOUTPUT*CONV2_DIM*CONV2_DIM) // 1280000
+#define FC1_MACS        (FC1_NBOUTPUT*FC1_NBINPUT)                                                  // 256000
+#define FC2_MACS        (FC2_NBOUTPUT*FC1_NBOUTPUT)                                                 // 4000
+#define EXIT_MACS       (FC2_NBOUTPUT*FC1_NBINPUT)                                                  // 6400
+#define FEATURE_BYTES   (sizeof(CONV1_KERNEL) + sizeof(CONV1_BIAS) + sizeof(CONV2_KERNEL) + sizeof(CONV2_BIAS))
+#define CLASSIFIER_BYTES (sizeof(FC1_KERNEL) + sizeof(FC1_BIAS) + sizeof(FC2_KERNEL) + sizeof(FC2_BIAS))
+#define EXIT_BYTES      (sizeof(EXIT_KERNEL) + sizeof(EXIT_BIAS))
+
+// a threshold above 1 never exits: full network plus the head overhead
+static const float sweep_thresholds[] = { 0.9, 0.99, 0.995, 0.999, 0.9995, 0.9999, 2 };
+
+short EXIT_KERNEL[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+short EXIT_BIAS[FC2_NBOUTPUT];
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-f exit_head.txt] [-t threshold] [-n max_images]\n", program);
+  printf("       the head answers when its highest softmax probability is >= threshold\n");
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short output[FC2_NBOUTPUT];
+  char *head_filename;
+  unsigned char number;
+  float threshold;
+  unsigned int error, nb_exited;
+  int opt, m, s, nb_thresholds, exited, nb_images, max_images;
+  double tstart, tdiff, exit_rate, macs, weight_bytes;
+
+  head_filename = EXIT_HEAD_FILE;
+  threshold = -1;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "f:t:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'f': head_filename = optarg; break;
+    case 't': threshold = atof(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  images = malloc(sizeof(*images) * max_images);
+  if (!images)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  if (LoadExitHead(head_filename, EXIT_KERNEL, EXIT_BIAS))
+    printf("\nExit head trained by lenet_keras_20_40.py (%s)\n", head_filename);
+  else
+  {
+    BuildExitHead(FC1_KERNEL, FC1_BIAS, FC2_KERNEL, FC2_BIAS, EXIT_KERNEL, EXIT_BIAS);
+    printf("\nNo %s, exit head built from FC2 * FC1 without the FC1 ReLU\n", head_filename);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  // the head alone, on every image
+  error = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    Conv1_28x28x1_5x5x20_1_0(images[m], CONV1_KERNEL, CONV1_BIAS, conv1_output);
+    Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+    Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
+    Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
+    ExitHead_40_10(pool2_output, EXIT_KERNEL, EXIT_BIAS, output);
+    ExitConfidence(output, &number);
+    if (number != labels[m])
+      error++;
+  }
+  printf("\nHead alone: %u / %d errors (%.2f%%), full network baseline %d / %d errors\n", error, nb_images,
+         (1 - ((double)error / nb_images)) * 100, BASELINE_ERRORS, NB_TEST_IMAGES);
+  printf("Per image: features %d MACs, FC1 + FC2 %d MACs / %u weight bytes, head %d MACs / %u weight bytes\n\n",
+         CONV1_MACS + CONV2_MACS, FC1_MACS + FC2_MACS, (unsigned int)CLASSIFIER_BYTES, EXIT_MACS, (unsigned int)EXIT_BYTES);
+
+  printf("%10s %9s %14s %9s %14s %16s %10s\n", "threshold", "exits", "errors", "success", "MACs/image", "weight KB/image", "us/image");
+
+  nb_thresholds = threshold < 0 ? sizeof(sweep_thresholds) / sizeof(sweep_thresholds[0]) : 1;
+  for (s = 0; s < nb_thresholds; s++)
+  {
+    if (nb_thresholds > 1)
+      threshold = sweep_thresholds[s];
+
+    error = 0;
+    nb_exited = 0;
+    tstart = TimeNow();
+    for (m = 0; m < nb_images; m++)
+    {
+      if (EarlyExitRun(images[m], EXIT_KERNEL, EXIT_BIAS, threshold, output, &exited) != labels[m])
+        error++;
+      nb_exited += exited;
+    }
+    tdiff = TimeNow() - tstart;
+
+    exit_rate = (double)nb_exited / nb_images;
+    macs = CONV1_MACS + CONV2_MACS + EXIT_MACS + (1 - exit_rate) * (FC1_MACS + FC2_MACS);
+    weight_bytes = FEATURE_BYTES + EXIT_BYTES + (1 - exit_rate) * CLASSIFIER_BYTES;
+
+    if (threshold > 1)
+      printf("%10s", "never");
+    else
+      printf("%10g", threshold);
+    printf(" %8.2f%% %8u / %-5d %8.2f%% %14.0f %16.1f %10.2f\n", exit_rate * 100, error, nb_images,
+           (1 - ((double)error / nb_images)) * 100, macs, weight_bytes / 1024, tdiff * 1000000 / nb_images);
+  }
+  printf("\n");
+
+  free(images);
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**
+  ******************************************************************************
+  * @file    exit_head.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Early exit: linear classifier on the Pool2 features, FC1 and FC2
+  *          only run when the head is not confident enough
+  * @brief   The head is either trained by lenet_keras_20_40.py (exit_head.txt)
+  *          or, without it, the FC2 * FC1 product with the ReLU left out
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "lenet_cnn_float.h"
+
+void BuildExitHead(short fc1_kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                   short fc1_bias[FC1_NBOUTPUT],                                                // IN
+                   short fc2_kernel[FC2_NBOUTPUT][FC1_NBOUTPUT],                                // IN
+                   short fc2_bias[FC2_NBOUTPUT],                                                // IN
+                   short exit_kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // OUT
+                   short exit_bias[FC2_NBOUTPUT])                                               // OUT
+{
+  unsigned short k, o, d, h, w;
+  int temp_sum;
+
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+  {
+    for (d = 0; d < POOL2_NBOUTPUT; d++)
+      for (h = 0; h < POOL2_HEIGHT; h++)
+        for (w = 0; w < POOL2_WIDTH; w++)
+        {
+          temp_sum = 0;
+          for (o = 0; o < FC1_NBOUTPUT; o++)
+            temp_sum += fc2_kernel[k][o] * fc1_kernel[o][d][h][w];
+          exit_kernel[k][d][h][w] = temp_sum >> FIXED_POINT;
+        }
+
+    temp_sum = 0;
+    for (o = 0; o < FC1_NBOUTPUT; o++)
+      temp_sum += fc2_kernel[k][o] * fc1_bias[o];
+    exit_bias[k] = (temp_sum >> FIXED_POINT) + fc2_bias[k];
+  }
+}
+
+// exit_head.txt: "classes inputs" then one line of inputs weights per class and the biases,
+// all in fixed point; returns 0 when the file is missing or does not match this network
+int LoadExitHead(char *filename,
+                 short exit_kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // OUT
+                 short exit_bias[FC2_NBOUTPUT])                                               // OUT
+{
+  FILE *txt_file;
+  int classes, inputs, value, i;
+  short *kernel;
+
+  txt_file = fopen(filename, "r");
+  if (!txt_file)
+    return 0;
+
+  if (fscanf(txt_file, "%d %d", &classes, &inputs) != 2 || classes != FC2_NBOUTPUT || inputs != FC1_NBINPUT)
+  {
+    printf("Warning: %s does not match the Pool2 features, ignored.\n", filename);
+    fclose(txt_file);
+    return 0;
+  }
+
+  kernel = &exit_kernel[0][0][0][0];
+  for (i = 0; i < FC2_NBOUTPUT * FC1_NBINPUT + FC2_NBOUTPUT; i++)
+  {
+    if (fscanf(txt_file, "%d", &value) != 1)
+    {
+      printf("Warning: %s is truncated, ignored.\n", filename);
+      fclose(txt_file);
+      return 0;
+    }
+    if (i < FC2_NBOUTPUT * FC1_NBINPUT)
+      kernel[i] = value;
+    else
+      exit_bias[i - FC2_NBOUTPUT * FC1_NBINPUT] = value;
+  }
+
+  fclose(txt_file);
+  return 1;
+}
+
+void ExitHead_40_10(short input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],                 // IN
+                    short kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                    short bias[FC2_NBOUTPUT],                                               // IN
+                    short output[FC2_NBOUTPUT])                                             // OUT
+{
+  #pragma HLS ARRAY_PARTITION variable=input complete dim=2
+
+  unsigned short o, d, h, w;
+  int temp_sum;
+  short fc_sum;
+
+  for (o = 0; o < FC2_NBOUTPUT; o++) { // 10
+    temp_sum = 0;
+
+    for (d = 0; d < POOL2_NBOUTPUT; d++) { // 10*40 > 400 iteration
+    #pragma HLS pipeline
+      for (h = 0; h < POOL2_HEIGHT; h++) {
+        for (w = 0; w < POOL2_WIDTH; w++) {
+          temp_sum = temp_sum + input[d][h][w] * kernel[o][d][h][w];
+        }
+      }
+    }
+
+    // shifting back after matrix*kernel multiplication, no activation: logits
+    fc_sum = temp_sum >> FIXED_POINT;
+    output[o] = fc_sum + bias[o];
+  }
+}
+
+// highest softmax probability of fixed point logits, computed without the
+// integer truncation of Softmax() so that thresholds close to 1 stay usable
+float ExitConfidence(short logits[FC2_NBOUTPUT], unsigned char *number)
+{
+  float exp_sum;
+  short k;
+
+  *number = 0;
+  for (k = 1; k < FC2_NBOUTPUT; k++)
+    if (logits[k] > logits[*number])
+      *number = k;
+
+  exp_sum = 0;
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+    exp_sum += expf((float)(logits[k] - logits[*number]) / (1 << FIXED_POINT));
+
+  return 1 / exp_sum;
+}
+
+unsigned char EarlyExitRun(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],                    // IN
+                           short exit_kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                           short exit_bias[FC2_NBOUTPUT],                                               // IN
+                           float threshold,                                                             // IN
+                           short output[FC2_NBOUTPUT],                                                  // OUT
+                           int *exited)                                                                 // OUT
+{
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  unsigned char number;
+
+  Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output);
+  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+  Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
+  Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
+
+  ExitHead_40_10(pool2_output, exit_kernel, exit_bias, output);
+  *exited = ExitConfidence(output, &number) >= threshold;
+  if (*exited)
+    return number;
+
+  Fc1_40_400(pool2_output, FC1_KERNEL, FC1_BIAS, fc1_output);
+  Fc2_400_10(fc1_output, FC2_KERNEL, FC2_BIAS, output);
+  Softmax(output, softmax_output);
+  return ClassifySoftmax(softmax_output);
+}
@@ -95,4 +95,18 @@ void Fc2_400_10(  short input[FC1_NBOUTPUT],                // IN
     // output for final classification
     output[o]=fc_sum+bias[o];
   }  
-}
\ No newline at end of file
+}
+
+// index of the highest probability, same selection as the main test loop
+unsigned char ClassifySoftmax(float vector_in[FC2_NBOUTPUT]){
+  float max=0;
+  unsigned char number=0;
+
+  for(short k = 0; k < FC2_NBOUTPUT; k++){
+    if(vector_in[k] > max){
+      max=vector_in[k];
+      number=k;
+    }
+  }
+  return number;
+}
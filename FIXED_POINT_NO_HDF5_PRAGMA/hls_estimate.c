@@ -0,0 +1,1579 @@
+/**
+  ******************************************************************************
+  * @file    hls_estimate.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Static latency and II estimate of the HLS layers from their loop
+  *          nests and pragmas, checked against the Vivado HLS reports
+  * @brief   usage: ./hls_estimate [-P] [-r report.html] [-t tolerance] [-u] [-v] [file.c ...]
+  *          Parses the layer functions of conv.c pool.c fc.c (default), with
+  *          the loop bounds from the macros of lenet_cnn_float.h and the
+  *          #pragma HLS PIPELINE / UNROLL / ARRAY_PARTITION / RESOURCE
+  *          directives (-P ignores them); a loop over a variable range runs
+  *          its LOOP_TRIPCOUNT max. Model of Vivado HLS 2018.2:
+  *          - a loop that is not pipelined takes trips x iteration latency,
+  *            plus LOOP_STATES cycles to enter and leave it
+  *          - a pipelined loop unrolls its inner loops and is flattened with
+  *            the perfect loop nest around it: (trips - 1) x II + depth
+  *          - II is the largest number of accesses to one bank of an array
+  *            per iteration over its ports (2, 1 for a RAM_1P core); the
+  *            weight tables without a directive are ROMs partitioned by the
+  *            tool as needed and never limit II
+  *          - the directives on the input and output of two consecutive
+  *            layers apply to the buffer they share in lenet_cnn
+  *          - straight-line code takes its read port cycles, the read
+  *            latency, one cycle per operation on the dependency chain
+  *            (multiply-add fused, RESOURCE latency for multiplies, adder tree
+  *            for unrolled reductions, constant shifts free) and one cycle
+  *            to write an array; identical accesses are counted once
+  *          The estimates are compared with the instance latencies of the
+  *          report (../synthesis_results/synth_with_pragma.html, or
+  *          synth_without_pragma.html with -P); layers inlined by the tool
+  *          are matched with the top level loops of the report in call order.
+  *          The memories of the report give the number of banks of each
+  *          buffer of lenet_cnn; a layer accessing a buffer from a pipelined
+  *          loop with another partitioning than the one of its directives
+  *          (the tool partitioned it further) is unsupported and not checked.
+  *          Exits with 1 when a checked layer or the total is off by more
+  *          than the tolerance (default 10%), when nothing could be checked
+  *          or when a layer is unsupported, unless -u accepts those.
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <unistd.h>
+
+#define MAX_TOKENS      32768
+#define TOKEN_TEXT      128
+#define MAX_MACROS      256
+#define MAX_NODES       2048
+#define MAX_FUNCTIONS   32
+#define MAX_ARRAYS      16
+#define MAX_DIMS        4
+#define MAX_VARS        16
+#define MAX_BANKS       1024
+#define MAX_ACCESSES    4096
+#define MAX_LOOPS       8
+#define MAX_REPORT      64
+#define MAX_LINES       256
+
+#define LOOP_STATES     2           // enter and leave a loop that is not pipelined
+#define CALL_STATES     2           // start and done of a layer call
+#define READ_LATENCY    1           // BRAM / LUTRAM read
+#define RAM_PORTS       2           // dual port unless a RAM_1P core is given
+
+#define DEFAULT_REPORT          "../synthesis_results/synth_with_pragma.html"
+#define DEFAULT_REPORT_NOPRAGMA "../synthesis_results/synth_without_pragma.html"
+#define DEFAULT_TOLERANCE       0.1
+
+enum { TOK_IDENT, TOK_NUMBER, TOK_PUNCT, TOK_PRAGMA };
+enum { NODE_BLOCK, NODE_LOOP, NODE_IF, NODE_STMT };
+enum { PART_NONE, PART_COMPLETE, PART_CYCLIC, PART_BLOCK };
+
+typedef struct {
+  int kind;
+  int line;
+  const char *file;
+  char text[TOKEN_TEXT];
+} token;
+
+typedef struct {
+  char name[TOKEN_TEXT];
+  char value[TOKEN_TEXT];
+} macro;
+
+typedef struct {
+  char name[TOKEN_TEXT];
+  long value;
+} binding;
+
+typedef struct {
+  int kind;
+  int child, next, other;         // body or then branch, next sibling, else branch
+  int start, end;                 // tokens of a statement or of an if condition
+  int line;
+  char var[TOKEN_TEXT];           // loop variable
+  long lo, step, trip;
+  int pipeline;
+  long unroll;                    // 0 none, -1 complete, else factor
+} node;
+
+typedef struct {
+  char name[TOKEN_TEXT];
+  int nb_dims;
+  long dims[MAX_DIMS];
+  int part_type[MAX_DIMS];
+  long part_factor[MAX_DIMS];
+  int ports;
+  int pinned;                     // ARRAY_PARTITION or RESOURCE directive
+  int weight;                     // kernel / bias table
+  int pipelined;                  // accessed in a pipelined loop
+} array;
+
+typedef struct {
+  char var[TOKEN_TEXT];
+  int line;
+  long trips;
+  long ii;
+  int limit;                      // array limiting II, -1 for none
+} pipelined_loop;
+
+typedef struct {
+  char name[TOKEN_TEXT];
+  const char *file;
+  int line;
+  int body;
+  array arrays[MAX_ARRAYS];
+  int nb_arrays, nb_params;
+  int mul_latency;
+  pipelined_loop loops[MAX_LOOPS];
+  int nb_loops;
+  long long latency;
+} function;
+
+typedef struct {
+  binding vars[MAX_VARS];
+  int nb_vars;
+} context;
+
+typedef struct {
+  int counts[MAX_ARRAYS][MAX_BANKS];
+  struct {
+    int array, write;
+    long index[MAX_DIMS];
+  } seen[MAX_ACCESSES];
+  int nb_seen;
+  int reads, writes;
+} segment;
+
+typedef struct {
+  char module[TOKEN_TEXT];
+  long long latency;
+} report_entry;
+
+// layer calls of lenet_cnn (lenet_cnn.c) in order, each output buffer is the input of the next
+static const char *LAYERS[] = { "Conv1_", "Pool1_", "Conv2_", "Pool2_", "Fc1_", "Fc2_", NULL };
+// their output buffers, named as in lenet_cnn and in the memories of the report
+static const char *BUFFERS[] = { "conv1_output", "pool1_output", "conv2_output", "pool2_output", "fc1_output",
+                                 "fc2_output", NULL };
+
+static const char *PUNCTS[] = { "<<=", ">>=", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=",
+                                "<=", ">=", "==", "!=", "&&", "||", "<<", ">>", "->", NULL };
+
+static const char *TYPES[] = { "short", "int", "unsigned", "signed", "char", "float", "double", "long",
+                               "const", "static", "void", NULL };
+
+static token TOKENS[MAX_TOKENS];
+static int NB_TOKENS;
+static macro MACROS[MAX_MACROS];
+static int NB_MACROS;
+static node NODES[MAX_NODES];
+static int NB_NODES;
+static function FUNCTIONS[MAX_FUNCTIONS];
+static int NB_FUNCTIONS;
+
+static int USE_PRAGMAS = 1;
+static int VERBOSE;
+static char LINES[MAX_LINES][160];
+static int NB_LINES, INDENT;
+
+static long long REPORT_TOTAL = -1;
+static report_entry INSTANCES[MAX_REPORT];
+static int NB_INSTANCES;
+static long long REPORT_LOOPS[MAX_REPORT];
+static int NB_REPORT_LOOPS;
+static int REPORT_BANKS[8];                 // memories of each buffer, 0 when not listed
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-P] [-r report.html] [-t tolerance] [-u] [-v] [file.c ...]\n", program);
+}
+
+static char *ReadFile(const char *filename)
+{
+  FILE *file;
+  char *buffer;
+  long size;
+
+  file = fopen(filename, "rb");
+  if (!file)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  buffer = malloc(size + 1);
+  if (!buffer)
+  {
+    printf("Error: Unable to allocate %ld bytes.\n", size + 1);
+    exit(1);
+  }
+  size = fread(buffer, 1, size, file);
+  buffer[size] = 0;
+  fclose(file);
+  return buffer;
+}
+
+static void AddToken(token *tokens, int *nb_tokens, int max_tokens, int kind, const char *text, int length, const char *file, int line)
+{
+  if (*nb_tokens == max_tokens)
+  {
+    printf("Error: More than %d tokens.\n", max_tokens);
+    exit(1);
+  }
+  if (length >= TOKEN_TEXT)
+    length = TOKEN_TEXT - 1;
+  tokens[*nb_tokens].kind = kind;
+  tokens[*nb_tokens].line = line;
+  tokens[*nb_tokens].file = file;
+  memcpy(tokens[*nb_tokens].text, text, length);
+  tokens[*nb_tokens].text[length] = 0;
+  (*nb_tokens)++;
+}
+
+static void Directive(const char *text, token *tokens, int *nb_tokens, int max_tokens, const char *file, int line)
+{
+  char name[TOKEN_TEXT], value[TOKEN_TEXT], *cut;
+  const char *p;
+
+  p = text + 1;
+  while (isspace((unsigned char)*p))
+    p++;
+  if (!strncmp(p, "pragma", 6))
+  {
+    p += 6;
+    while (isspace((unsigned char)*p))
+      p++;
+    if (strncasecmp(p, "HLS", 3) || !isspace((unsigned char)p[3]))
+      return;
+    p += 3;
+    while (isspace((unsigned char)*p))
+      p++;
+    if (tokens)
+      AddToken(tokens, nb_tokens, max_tokens, TOK_PRAGMA, p, strcspn(p, "\r\n"), file, line);
+  }
+  else if (!strncmp(p, "define", 6) && NB_MACROS < MAX_MACROS)
+  {
+    if (sscanf(p + 6, " %127[A-Za-z0-9_] %127[^\r\n]", name, value) != 2 || strchr(name, '('))
+      return;
+    cut = strstr(value, "//");
+    if (cut)
+      *cut = 0;
+    cut = strstr(value, "/*");
+    if (cut)
+      *cut = 0;
+    strcpy(MACROS[NB_MACROS].name, name);
+    strcpy(MACROS[NB_MACROS].value, value);
+    NB_MACROS++;
+  }
+}
+
+// tokens of C source, NULL tokens only collects the macros
+static void Lex(const char *src, const char *file, token *tokens, int *nb_tokens, int max_tokens)
+{
+  char directive[1024];
+  const char *p, *start;
+  int line, k, length;
+
+  p = src;
+  line = 1;
+  while (*p)
+  {
+    if (*p == '\n')
+    {
+      line++;
+      p++;
+    }
+    else if (isspace((unsigned char)*p))
+      p++;
+    else if (p[0] == '/' && p[1] == '/')
+      while (*p && *p != '\n')
+        p++;
+    else if (p[0] == '/' && p[1] == '*')
+    {
+      p += 2;
+      while (*p && !(p[0] == '*' && p[1] == '/'))
+        if (*p++ == '\n')
+          line++;
+      if (*p)
+        p += 2;
+    }
+    else if (*p == '#')
+    {
+      length = 0;
+      while (*p && *p != '\n')
+      {
+        if (p[0] == '\\' && p[1] == '\n')
+        {
+          p += 2;
+          line++;
+          continue;
+        }
+        if (length < (int)sizeof(directive) - 1)
+          directive[length++] = *p;
+        p++;
+      }
+      directive[length] = 0;
+      Directive(directive, tokens, nb_tokens, max_tokens, file, line);
+    }
+    else if (*p == '"' || *p == '\'')
+    {
+      start = p++;
+      while (*p && *p != *start && *p != '\n')
+        p += (*p == '\\' && p[1]) ? 2 : 1;
+      if (*p == *start)
+        p++;
+    }
+    else if (isalpha((unsigned char)*p) || *p == '_')
+    {
+      start = p;
+      while (isalnum((unsigned char)*p) || *p == '_')
+        p++;
+      if (tokens)
+        AddToken(tokens, nb_tokens, max_tokens, TOK_IDENT, start, p - start, file, line);
+    }
+    else if (isdigit((unsigned char)*p))
+    {
+      start = p;
+      while (isalnum((unsigned char)*p) || *p == '.')
+        p++;
+      if (tokens)
+        AddToken(tokens, nb_tokens, max_tokens, TOK_NUMBER, start, p - start, file, line);
+    }
+    else
+    {
+      for (k = 0; PUNCTS[k]; k++)
+        if (!strncmp(p, PUNCTS[k], strlen(PUNCTS[k])))
+          break;
+      length = PUNCTS[k] ? (int)strlen(PUNCTS[k]) : 1;
+      if (tokens)
+        AddToken(tokens, nb_tokens, max_tokens, TOK_PUNCT, p, length, file, line);
+      p += length;
+    }
+  }
+}
+
+/* Integer expressions of loop bounds, array sizes and indexes */
+
+typedef struct {
+  token *tokens;
+  int pos, end;
+  context *ctx;
+  int ok;
+  int depth;
+} eval_state;
+
+static long EvalShift(eval_state *s);
+
+static int EvalIs(eval_state *s, const char *text)
+{
+  return s->pos < s->end && s->tokens[s->pos].kind == TOK_PUNCT && !strcmp(s->tokens[s->pos].text, text);
+}
+
+static long EvalMacro(const char *name, int depth, int *ok)
+{
+  token tokens[64];
+  eval_state s;
+  long value;
+  int k, nb_tokens;
+
+  for (k = NB_MACROS - 1; k >= 0; k--)
+    if (!strcmp(MACROS[k].name, name))
+      break;
+  if (k < 0 || depth > 32)
+  {
+    *ok = 0;
+    return 0;
+  }
+  nb_tokens = 0;
+  Lex(MACROS[k].value, "macro", tokens, &nb_tokens, 64);
+  s.tokens = tokens;
+  s.pos = 0;
+  s.end = nb_tokens;
+  s.ctx = NULL;
+  s.ok = 1;
+  s.depth = depth + 1;
+  value = EvalShift(&s);
+  if (!s.ok || s.pos != s.end)
+    *ok = 0;
+  return value;
+}
+
+static long EvalPrimary(eval_state *s)
+{
+  token *t;
+  long value;
+  int k;
+
+  if (s->pos >= s->end)
+  {
+    s->ok = 0;
+    return 0;
+  }
+  t = &s->tokens[s->pos++];
+  if (t->kind == TOK_NUMBER)
+    return strtol(t->text, NULL, 0);
+  if (t->kind == TOK_IDENT)
+  {
+    if (s->ctx)
+      for (k = s->ctx->nb_vars - 1; k >= 0; k--)
+        if (!strcmp(s->ctx->vars[k].name, t->text))
+          return s->ctx->vars[k].value;
+    return EvalMacro(t->text, s->depth, &s->ok);
+  }
+  if (t->kind == TOK_PUNCT && !strcmp(t->text, "("))
+  {
+    value = EvalShift(s);
+    if (EvalIs(s, ")"))
+      s->pos++;
+    else
+      s->ok = 0;
+    return value;
+  }
+  if (t->kind == TOK_PUNCT && !strcmp(t->text, "-"))
+    return -EvalPrimary(s);
+  s->ok = 0;
+  return 0;
+}
+
+static long EvalTerm(eval_state *s)
+{
+  long value, right;
+  char op;
+
+  value = EvalPrimary(s);
+  while (EvalIs(s, "*") || EvalIs(s, "/") || EvalIs(s, "%"))
+  {
+    op = s->tokens[s->pos++].text[0];
+    right = EvalPrimary(s);
+    if (op == '*')
+      value *= right;
+    else if (right == 0)
+      s->ok = 0;
+    else if (op == '/')
+      value /= right;
+    else
+      value %= right;
+  }
+  return value;
+}
+
+static long EvalAdd(eval_state *s)
+{
+  long value;
+  char op;
+
+  value = EvalTerm(s);
+  while (EvalIs(s, "+") || EvalIs(s, "-"))
+  {
+    op = s->tokens[s->pos++].text[0];
+    value = op == '+' ? value + EvalTerm(s) : value - EvalTerm(s);
+  }
+  return value;
+}
+
+static long EvalShift(eval_state *s)
+{
+  long value;
+  int left;
+
+  value = EvalAdd(s);
+  while (EvalIs(s, "<<") || EvalIs(s, ">>"))
+  {
+    left = s->tokens[s->pos++].text[0] == '<';
+    value = left ? value << EvalAdd(s) : value >> EvalAdd(s);
+  }
+  return value;
+}
+
+// value of TOKENS[start, end), 0 if it is not a constant under ctx
+static int Eval(int start, int end, context *ctx, long *value)
+{
+  eval_state s;
+
+  s.tokens = TOKENS;
+  s.pos = start;
+  s.end = end;
+  s.ctx = ctx;
+  s.ok = 1;
+  s.depth = 0;
+  *value = EvalShift(&s);
+  return s.ok && s.pos == end;
+}
+
+/* Parser: functions, loop nests, if statements, statements and pragmas */
+
+static int IsPunct(int pos, const char *text)
+{
+  return pos < NB_TOKENS && TOKENS[pos].kind == TOK_PUNCT && !strcmp(TOKENS[pos].text, text);
+}
+
+static int IsIdent(int pos, const char *text)
+{
+  return pos < NB_TOKENS && TOKENS[pos].kind == TOK_IDENT && !strcmp(TOKENS[pos].text, text);
+}
+
+static int IsType(int pos)
+{
+  int k;
+
+  for (k = 0; TYPES[k]; k++)
+    if (IsIdent(pos, TYPES[k]))
+      return 1;
+  return 0;
+}
+
+// index of the bracket closing the one at pos
+static int Matching(int pos)
+{
+  const char *open, *close;
+  int depth;
+
+  open = TOKENS[pos].text;
+  close = !strcmp(open, "(") ? ")" : !strcmp(open, "[") ? "]" : "}";
+  depth = 0;
+  for (; pos < NB_TOKENS; pos++)
+  {
+    if (IsPunct(pos, open))
+      depth++;
+    else if (IsPunct(pos, close) && --depth == 0)
+      return pos;
+  }
+  return NB_TOKENS;
+}
+
+static void Note(int pos, const char *message, const char *name)
+{
+  printf("%s:%d: note: ", TOKENS[pos].file, TOKENS[pos].line);
+  printf(message, name);
+  printf("\n");
+}
+
+static int NewNode(int kind, int pos)
+{
+  node *n;
+
+  if (NB_NODES == MAX_NODES)
+  {
+    printf("Error: More than %d statements.\n", MAX_NODES);
+    exit(1);
+  }
+  n = &NODES[NB_NODES];
+  memset(n, 0, sizeof(node));
+  n->kind = kind;
+  n->child = n->next = n->other = -1;
+  n->line = TOKENS[pos].line;
+  n->step = 1;
+  return NB_NODES++;
+}
+
+static int FindArray(function *f, const char *name)
+{
+  int k;
+
+  for (k = 0; k < f->nb_arrays; k++)
+    if (!strcmp(f->arrays[k].name, name))
+      return k;
+  return -1;
+}
+
+// declarator at pos: name and dimensions, added to the arrays of f if it has any
+static int Declarator(function *f, int pos, int end)
+{
+  array a;
+  long value;
+  int close;
+
+  memset(&a, 0, sizeof(array));
+  while (pos < end && (TOKENS[pos].kind != TOK_IDENT || IsType(pos)))
+    pos++;
+  if (pos == end)
+    return end;
+  snprintf(a.name, TOKEN_TEXT, "%s", TOKENS[pos].text);
+  pos++;
+  while (IsPunct(pos, "[") && a.nb_dims < MAX_DIMS)
+  {
+    close = Matching(pos);
+    if (!Eval(pos + 1, close, NULL, &value))
+      Note(pos, "size of %s is not a constant", a.name);
+    a.dims[a.nb_dims++] = value > 0 ? value : 1;
+    pos = close + 1;
+  }
+  if (a.nb_dims && f->nb_arrays < MAX_ARRAYS)
+  {
+    a.ports = RAM_PORTS;
+    a.weight = !strcmp(a.name, "kernel") || !strcmp(a.name, "bias");
+    f->arrays[f->nb_arrays++] = a;
+  }
+  return pos;
+}
+
+static const char *PragmaOption(const char *text, const char *key, char *value)
+{
+  const char *p;
+  int length;
+
+  length = strlen(key);
+  for (p = text; (p = strcasestr(p, key)); p += length)
+    if ((p == text || isspace((unsigned char)p[-1])) && p[length] == '=')
+    {
+      sscanf(p + length + 1, "%127s", value);
+      return value;
+    }
+  return NULL;
+}
+
+static void Pragma(function *f, int pos, int loop)
+{
+  char keyword[TOKEN_TEXT], variable[TOKEN_TEXT], value[TOKEN_TEXT];
+  const char *text;
+  array *a;
+  int k, dim, type;
+
+  text = TOKENS[pos].text;
+  sscanf(text, "%127s", keyword);
+
+  // the trip count of a loop with a variable bound is structural, read with or without -P
+  if (!strcasecmp(keyword, "LOOP_TRIPCOUNT"))
+  {
+    if (loop >= 0 && NODES[loop].trip < 0 && PragmaOption(text, "max", value))
+      NODES[loop].trip = atol(value);
+    return;
+  }
+  if (!USE_PRAGMAS)
+    return;
+
+  if (!strcasecmp(keyword, "PIPELINE"))
+  {
+    if (loop < 0)
+      Note(pos, "PIPELINE of function %s not modelled, ignored", f->name);
+    else
+      NODES[loop].pipeline = 1;
+  }
+  else if (!strcasecmp(keyword, "UNROLL"))
+  {
+    if (loop < 0)
+      Note(pos, "UNROLL outside a loop in %s, ignored", f->name);
+    else
+      NODES[loop].unroll = PragmaOption(text, "factor", value) ? atol(value) : -1;
+  }
+  else if (!strcasecmp(keyword, "ARRAY_PARTITION") || !strcasecmp(keyword, "RESOURCE"))
+  {
+    if (!PragmaOption(text, "variable", variable))
+      return;
+    k = FindArray(f, variable);
+    if (k < 0)
+    {
+      // a multiplier core on the accumulator sets the multiply latency
+      if (!strcasecmp(keyword, "RESOURCE") && PragmaOption(text, "core", value) && !strncasecmp(value, "Mul", 3))
+        f->mul_latency = PragmaOption(text, "latency", value) ? atoi(value) : 1;
+      else
+        Note(pos, "directive on %s, not an array of this function, ignored", variable);
+      return;
+    }
+    a = &f->arrays[k];
+    a->pinned = 1;
+    if (!strcasecmp(keyword, "RESOURCE"))
+    {
+      if (PragmaOption(text, "core", value) && strcasestr(value, "1P"))
+        a->ports = 1;
+      return;
+    }
+    type = strcasestr(text, "cyclic") ? PART_CYCLIC : strcasestr(text, "block") ? PART_BLOCK : PART_COMPLETE;
+    dim = PragmaOption(text, "dim", value) ? atoi(value) : 1;
+    for (k = 0; k < a->nb_dims; k++)
+      if (dim == 0 || dim == k + 1)
+      {
+        a->part_type[k] = type;
+        a->part_factor[k] = PragmaOption(text, "factor", value) ? atol(value) : 1;
+      }
+  }
+}
+
+static int ParseStatement(function *f, int pos, int loop, int *result);
+
+static int ParseBlock(function *f, int pos, int loop, int *first)
+{
+  int n, last;
+
+  *first = last = -1;
+  pos++;
+  while (pos < NB_TOKENS && !IsPunct(pos, "}"))
+  {
+    pos = ParseStatement(f, pos, loop, &n);
+    if (n < 0)
+      continue;
+    if (last < 0)
+      *first = n;
+    else
+      NODES[last].next = n;
+    last = n;
+  }
+  return pos + 1;
+}
+
+static int ParseFor(function *f, int pos, int *result)
+{
+  int n, close, init, cond, incr, k, variable;
+  long hi;
+
+  n = NewNode(NODE_LOOP, pos);
+  close = Matching(pos + 1);
+  init = pos + 2;
+  for (cond = init; cond < close && !IsPunct(cond, ";"); cond++)
+    ;
+  for (incr = cond + 1; incr < close && !IsPunct(incr, ";"); incr++)
+    ;
+
+  // init: [type] var = lo
+  for (k = init; k < cond && !IsPunct(k, "="); k++)
+    ;
+  variable = 0;
+  if (k < cond && k > init)
+  {
+    snprintf(NODES[n].var, TOKEN_TEXT, "%s", TOKENS[k - 1].text);
+    if (!Eval(k + 1, cond, NULL, &NODES[n].lo))
+      variable = 1;
+  }
+
+  // increment: var++, ++var, var += step
+  for (k = cond + 1; k < close; k++)
+    if (IsPunct(k, "+="))
+      Eval(k + 1, close, NULL, &NODES[n].step);
+  if (NODES[n].step < 1)
+    NODES[n].step = 1;
+
+  // condition: var < hi or var <= hi
+  hi = NODES[n].lo + 1;
+  if (IsIdent(cond + 1, NODES[n].var) && (IsPunct(cond + 2, "<") || IsPunct(cond + 2, "<=")))
+  {
+    if (!Eval(cond + 3, incr, NULL, &hi))
+      variable = 1;
+    if (IsPunct(cond + 2, "<="))
+      hi++;
+  }
+  else
+    Note(cond, "loop %s has no var < bound condition, counted once", NODES[n].var);
+  NODES[n].trip = hi > NODES[n].lo ? (hi - NODES[n].lo + NODES[n].step - 1) / NODES[n].step : 0;
+
+  // a variable range takes the LOOP_TRIPCOUNT max of the body, from 0
+  if (variable)
+  {
+    NODES[n].lo = 0;
+    NODES[n].trip = -1;
+  }
+  pos = ParseStatement(f, close + 1, n, &NODES[n].child);
+  if (NODES[n].trip < 0)
+  {
+    Note(cond, "range of loop %s is not constant and has no LOOP_TRIPCOUNT, counted once", NODES[n].var);
+    NODES[n].trip = 1;
+  }
+  *result = n;
+  return pos;
+}
+
+static int ParseStatement(function *f, int pos, int loop, int *result)
+{
+  int n, close, end, start;
+
+  *result = -1;
+  while (pos < NB_TOKENS && TOKENS[pos].kind == TOK_PRAGMA)
+    Pragma(f, pos++, loop);
+  if (pos >= NB_TOKENS || IsPunct(pos, "}"))
+    return pos;
+  if (IsPunct(pos, ";"))
+    return pos + 1;
+
+  if (IsPunct(pos, "{"))
+  {
+    n = NewNode(NODE_BLOCK, pos);
+    pos = ParseBlock(f, pos, loop, &NODES[n].child);
+    *result = n;
+    return pos;
+  }
+
+  if (IsIdent(pos, "for") && IsPunct(pos + 1, "("))
+    return ParseFor(f, pos, result);
+
+  if (IsIdent(pos, "if") && IsPunct(pos + 1, "("))
+  {
+    n = NewNode(NODE_IF, pos);
+    close = Matching(pos + 1);
+    NODES[n].start = pos + 2;
+    NODES[n].end = close;
+    pos = ParseStatement(f, close + 1, loop, &NODES[n].child);
+    if (IsIdent(pos, "else"))
+      pos = ParseStatement(f, pos + 1, loop, &NODES[n].other);
+    *result = n;
+    return pos;
+  }
+
+  for (end = pos; end < NB_TOKENS && !IsPunct(end, ";"); end++)
+    if (IsPunct(end, "(") || IsPunct(end, "["))
+      end = Matching(end);
+
+  // declaration: arrays are recorded, scalar initializations are free
+  if (IsType(pos))
+  {
+    start = pos;
+    while (IsType(start))
+      start++;
+    while (start < end)
+    {
+      start = Declarator(f, start, end);
+      while (start < end && !IsPunct(start, ","))
+        start = (IsPunct(start, "(") || IsPunct(start, "[")) ? Matching(start) + 1 : start + 1;
+      start++;
+    }
+    return end + 1;
+  }
+
+  n = NewNode(NODE_STMT, pos);
+  NODES[n].start = pos;
+  NODES[n].end = end;
+  *result = n;
+  return end + 1;
+}
+
+static void ParseFunctions(int first_token)
+{
+  function *f;
+  int pos, close, start, k;
+
+  pos = first_token;
+  while (pos < NB_TOKENS)
+  {
+    if (!(TOKENS[pos].kind == TOK_IDENT && IsPunct(pos + 1, "(") && pos > first_token && IsType(pos - 1)))
+    {
+      pos++;
+      continue;
+    }
+    close = Matching(pos + 1);
+    if (!IsPunct(close + 1, "{"))
+    {
+      pos = close + 1;
+      continue;
+    }
+    if (NB_FUNCTIONS == MAX_FUNCTIONS)
+    {
+      printf("Error: More than %d functions.\n", MAX_FUNCTIONS);
+      exit(1);
+    }
+    f = &FUNCTIONS[NB_FUNCTIONS++];
+    memset(f, 0, sizeof(function));
+    snprintf(f->name, TOKEN_TEXT, "%s", TOKENS[pos].text);
+    f->file = TOKENS[pos].file;
+    f->line = TOKENS[pos].line;
+    f->mul_latency = 1;
+
+    // parameters, split on the commas outside brackets
+    start = pos + 2;
+    for (k = start; k <= close; k++)
+    {
+      if (IsPunct(k, "[") || (IsPunct(k, "(") && k > pos + 1))
+        k = Matching(k);
+      else if (IsPunct(k, ",") || k == close)
+      {
+        Declarator(f, start, k);
+        start = k + 1;
+      }
+    }
+    f->nb_params = f->nb_arrays;
+
+    pos = ParseBlock(f, close + 1, -1, &f->body);
+  }
+}
+
+/* Estimate */
+
+static int Log2Ceil(long n)
+{
+  int k;
+
+  for (k = 0; (1L << k) < n; k++)
+    ;
+  return k;
+}
+
+static void Push(context *ctx, const char *var, long value)
+{
+  if (ctx->nb_vars == MAX_VARS)
+  {
+    printf("Error: More than %d nested loops.\n", MAX_VARS);
+    exit(1);
+  }
+  snprintf(ctx->vars[ctx->nb_vars].name, TOKEN_TEXT, "%s", var);
+  ctx->vars[ctx->nb_vars].value = value;
+  ctx->nb_vars++;
+}
+
+static long BankIndex(array *a, long *index)
+{
+  long bank, banks, size;
+  int d;
+
+  bank = 0;
+  for (d = 0; d < a->nb_dims; d++)
+  {
+    if (a->part_type[d] == PART_NONE)
+      continue;
+    if (a->part_type[d] == PART_COMPLETE)
+    {
+      banks = a->dims[d];
+      size = 1;
+    }
+    else
+    {
+      banks = a->part_factor[d] > 0 ? a->part_factor[d] : 1;
+      size = (a->dims[d] + banks - 1) / banks;
+    }
+    bank = bank * banks + (a->part_type[d] == PART_BLOCK ? index[d] / size : index[d] % banks);
+  }
+  bank %= MAX_BANKS;
+  return bank < 0 ? bank + MAX_BANKS : bank;
+}
+
+static void Access(segment *seg, function *f, int k, long *index, int write)
+{
+  int s;
+
+  for (s = 0; s < seg->nb_seen; s++)
+    if (seg->seen[s].array == k && seg->seen[s].write == write &&
+        !memcmp(seg->seen[s].index, index, sizeof(long) * MAX_DIMS))
+      return;
+  if (seg->nb_seen < MAX_ACCESSES)
+  {
+    seg->seen[seg->nb_seen].array = k;
+    seg->seen[seg->nb_seen].write = write;
+    memcpy(seg->seen[seg->nb_seen].index, index, sizeof(long) * MAX_DIMS);
+    seg->nb_seen++;
+  }
+  seg->counts[k][BankIndex(&f->arrays[k], index)]++;
+  if (write)
+    seg->writes++;
+  else
+    seg->reads++;
+}
+
+// array accesses of TOKENS[start, end) under the loop values of ctx
+static void CountAccesses(function *f, segment *seg, int start, int end, context *ctx)
+{
+  long index[MAX_DIMS];
+  int pos, k, d, close, next;
+
+  for (pos = start; pos < end; pos++)
+  {
+    if (TOKENS[pos].kind != TOK_IDENT || !IsPunct(pos + 1, "[") || (k = FindArray(f, TOKENS[pos].text)) < 0)
+      continue;
+    memset(index, 0, sizeof(index));
+    next = pos + 1;
+    for (d = 0; IsPunct(next, "["); d++)
+    {
+      close = Matching(next);
+      if (d < MAX_DIMS && !Eval(next + 1, close, ctx, &index[d]))
+        index[d] = 0;
+      next = close + 1;
+    }
+    if (IsPunct(next, "="))
+      Access(seg, f, k, index, 1);
+    else if (next < end && TOKENS[next].kind == TOK_PUNCT && strlen(TOKENS[next].text) >= 2 &&
+             (TOKENS[next].text[strlen(TOKENS[next].text) - 1] == '=' || !strcmp(TOKENS[next].text, "++") ||
+              !strcmp(TOKENS[next].text, "--")) && strcmp(TOKENS[next].text, "==") && strcmp(TOKENS[next].text, "!=") &&
+             strcmp(TOKENS[next].text, "<=") && strcmp(TOKENS[next].text, ">="))
+    {
+      Access(seg, f, k, index, 0);
+      Access(seg, f, k, index, 1);
+    }
+    else
+      Access(seg, f, k, index, 0);
+  }
+}
+
+// cycles of the operations of TOKENS[start, end) on the dependency chain
+static int Operations(function *f, int start, int end, int *reduction)
+{
+  const char *text, *prev;
+  int pos, depth, muls, adds, compares;
+
+  muls = adds = compares = 0;
+  depth = 0;
+  for (pos = start; pos < end; pos++)
+  {
+    text = TOKENS[pos].text;
+    if (TOKENS[pos].kind != TOK_PUNCT)
+      continue;
+    if (!strcmp(text, "["))
+      depth++;
+    else if (!strcmp(text, "]"))
+      depth--;
+    if (depth || pos == start)
+      continue;
+    prev = TOKENS[pos - 1].text;
+    // binary operator: the previous token ends an operand
+    if ((!strcmp(text, "*") || !strcmp(text, "+") || !strcmp(text, "-")) &&
+        !(TOKENS[pos - 1].kind != TOK_PUNCT || !strcmp(prev, ")") || !strcmp(prev, "]")))
+      continue;
+    if (!strcmp(text, "*") || !strcmp(text, "*="))
+      muls++;
+    else if (!strcmp(text, "+") || !strcmp(text, "-") || !strcmp(text, "+=") || !strcmp(text, "-=") ||
+             !strcmp(text, "++") || !strcmp(text, "--"))
+      adds++;
+    else if (!strcmp(text, "<") || !strcmp(text, ">") || !strcmp(text, "<=") || !strcmp(text, ">=") ||
+             !strcmp(text, "==") || !strcmp(text, "!="))
+      compares++;
+  }
+
+  // scalar accumulation: s = s + ..., s += ...
+  *reduction = 0;
+  if (TOKENS[start].kind == TOK_IDENT && FindArray(f, TOKENS[start].text) < 0)
+  {
+    if (IsPunct(start + 1, "+=") || IsPunct(start + 1, "-="))
+      *reduction = 1;
+    else if (IsPunct(start + 1, "="))
+      for (pos = start + 2; pos < end; pos++)
+        if (IsIdent(pos, TOKENS[start].text))
+          *reduction = 1;
+  }
+
+  // a multiply feeding an add is one multiply-add
+  return muls * (USE_PRAGMAS ? f->mul_latency : 1) + (adds > muls ? adds - muls : 0) + compares;
+}
+
+// operation cycles of the chain of node n, its accesses added to seg; loops are unrolled
+static int ChainDepth(function *f, int n, context *ctx, long copies, segment *seg)
+{
+  int depth, then_depth, else_depth, reduction, c, k;
+
+  switch (NODES[n].kind)
+  {
+  case NODE_STMT:
+    CountAccesses(f, seg, NODES[n].start, NODES[n].end, ctx);
+    depth = Operations(f, NODES[n].start, NODES[n].end, &reduction);
+    if (reduction && copies > 1)
+      depth += Log2Ceil(copies);
+    return depth;
+  case NODE_IF:
+    CountAccesses(f, seg, NODES[n].start, NODES[n].end, ctx);
+    depth = Operations(f, NODES[n].start, NODES[n].end, &reduction);
+    then_depth = NODES[n].child >= 0 ? ChainDepth(f, NODES[n].child, ctx, copies, seg) : 0;
+    else_depth = NODES[n].other >= 0 ? ChainDepth(f, NODES[n].other, ctx, copies, seg) : 0;
+    return depth + (then_depth > else_depth ? then_depth : else_depth);
+  case NODE_BLOCK:
+    depth = 0;
+    for (c = NODES[n].child; c >= 0; c = NODES[c].next)
+      depth += ChainDepth(f, c, ctx, copies, seg);
+    return depth;
+  default:
+    // unrolled loop: independent copies in parallel, reductions through an adder tree
+    depth = 0;
+    for (k = 0; k < NODES[n].trip && NODES[n].child >= 0; k++)
+    {
+      Push(ctx, NODES[n].var, NODES[n].lo + k * NODES[n].step);
+      c = ChainDepth(f, NODES[n].child, ctx, copies * NODES[n].trip, seg);
+      ctx->nb_vars--;
+      if (c > depth)
+        depth = c;
+    }
+    return depth;
+  }
+}
+
+// port cycles of the busiest bank, over the arrays that limit a pipeline or all of them
+static long MemoryCycles(function *f, segment *seg, int pipelined, int *limit)
+{
+  long cycles, c;
+  int k, b;
+
+  cycles = 0;
+  *limit = -1;
+  for (k = 0; k < f->nb_arrays; k++)
+  {
+    if (pipelined && USE_PRAGMAS && f->arrays[k].weight && !f->arrays[k].pinned)
+      continue;
+    for (b = 0; b < MAX_BANKS; b++)
+    {
+      c = (seg->counts[k][b] + f->arrays[k].ports - 1) / f->arrays[k].ports;
+      if (c > cycles)
+      {
+        cycles = c;
+        *limit = k;
+      }
+    }
+  }
+  return cycles;
+}
+
+static segment *NewSegment(void)
+{
+  segment *seg;
+
+  seg = calloc(1, sizeof(segment));
+  if (!seg)
+  {
+    printf("Error: Unable to allocate a segment.\n");
+    exit(1);
+  }
+  return seg;
+}
+
+static long long SegmentLatency(function *f, segment *seg, int ops)
+{
+  int limit;
+
+  return MemoryCycles(f, seg, 0, &limit) + (seg->reads ? READ_LATENCY : 0) + ops + (seg->writes ? 1 : 0);
+}
+
+static int ContainsLoop(int n)
+{
+  int c;
+
+  if (n < 0)
+    return 0;
+  if (NODES[n].kind == NODE_LOOP)
+    return 1;
+  for (c = NODES[n].child; c >= 0; c = NODES[c].next)
+    if (ContainsLoop(c))
+      return 1;
+  return NODES[n].kind == NODE_IF && ContainsLoop(NODES[n].other);
+}
+
+// the single loop of a body, -1 if the body holds anything else
+static int OnlyLoop(int n)
+{
+  if (n >= 0 && NODES[n].kind == NODE_BLOCK && NODES[n].child >= 0 && NODES[NODES[n].child].next < 0)
+    n = NODES[n].child;
+  return n >= 0 && NODES[n].kind == NODE_LOOP ? n : -1;
+}
+
+static int ReserveLine(void)
+{
+  if (!VERBOSE || NB_LINES == MAX_LINES)
+    return -1;
+  LINES[NB_LINES][0] = 0;
+  return NB_LINES++;
+}
+
+static long long LoopLatency(function *f, int n, context *ctx);
+
+// statements of a body in sequence: straight-line segments and loops
+static long long BlockLatency(function *f, int first, context *ctx)
+{
+  segment *seg;
+  long long latency;
+  int c, ops;
+
+  seg = NewSegment();
+  latency = 0;
+  ops = 0;
+  for (c = first; c >= 0; c = NODES[c].next)
+  {
+    if (NODES[c].kind == NODE_LOOP)
+      latency += LoopLatency(f, c, ctx) + LOOP_STATES;
+    else if (NODES[c].kind == NODE_BLOCK && ContainsLoop(c))
+      latency += BlockLatency(f, NODES[c].child, ctx);
+    else
+      ops += ChainDepth(f, c, ctx, 1, seg);
+  }
+  latency += SegmentLatency(f, seg, ops);
+  free(seg);
+  return latency;
+}
+
+static long long PipelinedLatency(function *f, int n, context *ctx, long trips, int line)
+{
+  segment *seg;
+  pipelined_loop *loop;
+  long ii;
+  long long depth, latency;
+  int ops, limit, k, b;
+
+  seg = NewSegment();
+  ops = ChainDepth(f, NODES[n].child, ctx, 1, seg);
+  ii = MemoryCycles(f, seg, 1, &limit);
+  if (ii < 1)
+    ii = 1;
+  depth = ii + (seg->reads ? READ_LATENCY : 0) + ops + (seg->writes ? 1 : 0);
+  latency = (trips - 1) * ii + depth;
+  for (k = 0; k < f->nb_arrays; k++)
+    for (b = 0; b < MAX_BANKS; b++)
+      if (seg->counts[k][b])
+        f->arrays[k].pipelined = 1;
+  free(seg);
+
+  if (f->nb_loops < MAX_LOOPS)
+  {
+    loop = &f->loops[f->nb_loops++];
+    snprintf(loop->var, TOKEN_TEXT, "%s", NODES[n].var);
+    loop->line = NODES[n].line;
+    loop->trips = trips;
+    loop->ii = ii;
+    loop->limit = limit;
+  }
+  if (line >= 0)
+    snprintf(LINES[line], sizeof(LINES[line]), "%*sline %d: for %s pipelined, %ld trips%s, II %ld (%s), depth %lld: %lld cycles",
+             INDENT, "", NODES[n].line, NODES[n].var, trips, trips != NODES[n].trip ? " flattened" : "", ii,
+             limit >= 0 ? f->arrays[limit].name : "no array", depth, latency);
+  return latency;
+}
+
+static long long LoopLatency(function *f, int n, context *ctx)
+{
+  segment *seg;
+  long long latency, iteration;
+  long trips, unroll;
+  int p, inner, nb_vars, line, ops;
+
+  line = ReserveLine();
+  nb_vars = ctx->nb_vars;
+
+  // a pipelined loop is flattened with the perfect nest around it
+  p = n;
+  trips = 1;
+  while (!NODES[p].pipeline && (inner = OnlyLoop(NODES[p].child)) >= 0)
+  {
+    trips *= NODES[p].trip;
+    Push(ctx, NODES[p].var, NODES[p].lo);
+    p = inner;
+  }
+  if (NODES[p].pipeline)
+  {
+    Push(ctx, NODES[p].var, NODES[p].lo);
+    latency = PipelinedLatency(f, p, ctx, trips * NODES[p].trip, line);
+    ctx->nb_vars = nb_vars;
+    return latency;
+  }
+  ctx->nb_vars = nb_vars;
+
+  Push(ctx, NODES[n].var, NODES[n].lo);
+  unroll = NODES[n].unroll < 0 ? NODES[n].trip : NODES[n].unroll;
+  if (unroll > 1 && !ContainsLoop(NODES[n].child))
+  {
+    // unrolled by a factor: copies of the body share one iteration
+    seg = NewSegment();
+    ops = 0;
+    for (p = 0; p < unroll; p++)
+    {
+      ctx->vars[ctx->nb_vars - 1].value = NODES[n].lo + p * NODES[n].step;
+      iteration = ChainDepth(f, NODES[n].child, ctx, unroll, seg);
+      if (iteration > ops)
+        ops = iteration;
+    }
+    iteration = SegmentLatency(f, seg, ops);
+    free(seg);
+    trips = (NODES[n].trip + unroll - 1) / unroll;
+  }
+  else
+  {
+    INDENT += 2;
+    iteration = BlockLatency(f, NODES[n].child, ctx);
+    INDENT -= 2;
+    trips = NODES[n].trip;
+  }
+  ctx->nb_vars = nb_vars;
+
+  latency = trips * iteration;
+  if (line >= 0)
+    snprintf(LINES[line], sizeof(LINES[line]), "%*sline %d: for %s, %ld trips x %lld: %lld cycles", INDENT, "",
+             NODES[n].line, NODES[n].var, trips, iteration, latency);
+  return latency;
+}
+
+/* Report */
+
+static void ReadReport(const char *filename)
+{
+  char *html, *p, *end, **cells;
+  int nb_cells, k, l, length;
+
+  html = ReadFile(filename);
+  if (!html)
+    return;
+  cells = malloc(sizeof(char *) * (strlen(html) / 2 + 1));
+  if (!cells)
+  {
+    printf("Error: Unable to allocate the report cells.\n");
+    exit(1);
+  }
+
+  // text between tags, trimmed
+  nb_cells = 0;
+  for (p = html; (p = strchr(p, '>')); p = end)
+  {
+    p++;
+    end = strchr(p, '<');
+    if (!end)
+      break;
+    *end++ = 0;
+    while (isspace((unsigned char)*p))
+      p++;
+    for (k = strlen(p); k > 0 && isspace((unsigned char)p[k - 1]); k--)
+      p[k - 1] = 0;
+    if (*p)
+      cells[nb_cells++] = p;
+  }
+
+  for (k = 0; k < nb_cells; k++)
+  {
+    if (!strcmp(cells[k], "Latency (clock cycles)") && REPORT_TOTAL < 0)
+    {
+      while (k + 1 < nb_cells && !isdigit((unsigned char)cells[k + 1][0]))
+        k++;
+      if (k + 1 < nb_cells)
+        REPORT_TOTAL = atoll(cells[++k]);
+    }
+    else if (!strncmp(cells[k], "grp_", 4) && k + 2 < nb_cells && NB_INSTANCES < MAX_REPORT)
+    {
+      snprintf(INSTANCES[NB_INSTANCES].module, TOKEN_TEXT, "%s", cells[k + 1]);
+      INSTANCES[NB_INSTANCES].latency = atoll(cells[k + 2]);
+      NB_INSTANCES++;
+    }
+    else if (!strncmp(cells[k], "- Loop ", 7) && k + 1 < nb_cells && NB_REPORT_LOOPS < MAX_REPORT)
+      REPORT_LOOPS[NB_REPORT_LOOPS++] = atoll(cells[k + 1]);
+    else
+      // memory instance of a buffer bank: buffer_U, buffer_3_U, buffer_1_2_U
+      for (l = 0; BUFFERS[l]; l++)
+      {
+        length = strlen(BUFFERS[l]);
+        if (strncmp(cells[k], BUFFERS[l], length) || cells[k][length] != '_')
+          continue;
+        p = cells[k] + length + 1;
+        while (isdigit((unsigned char)*p) || *p == '_')
+          p++;
+        if (!strcmp(p, "U") && p[-1] == '_')
+          REPORT_BANKS[l]++;
+      }
+  }
+  free(cells);
+  free(html);
+}
+
+// latency of the layer in the report: its instance, else the next top level loop
+static long long Reported(const char *prefix, int *next_loop, const char **where)
+{
+  int k;
+
+  for (k = 0; k < NB_INSTANCES; k++)
+    if (!strncmp(INSTANCES[k].module, prefix, strlen(prefix)))
+    {
+      *where = "instance";
+      return INSTANCES[k].latency;
+    }
+  if (*next_loop < NB_REPORT_LOOPS)
+  {
+    *where = "inlined, top loop";
+    return REPORT_LOOPS[(*next_loop)++];
+  }
+  *where = "";
+  return -1;
+}
+
+static void PrintRow(const char *name, long long estimate, long long reported, const char *loops)
+{
+  if (reported > 0)
+    printf("%-31s %10lld %10lld %+7.1f%%   %s\n", name, estimate, reported, 100.0 * (estimate - reported) / reported, loops);
+  else
+    printf("%-31s %10lld %10s %8s   %s\n", name, estimate, "-", "-", loops);
+}
+
+static long Banks(array *a)
+{
+  long banks;
+  int d;
+
+  banks = 1;
+  for (d = 0; d < a->nb_dims; d++)
+    if (a->part_type[d] == PART_COMPLETE)
+      banks *= a->dims[d];
+    else if (a->part_type[d] != PART_NONE && a->part_factor[d] > 1)
+      banks *= a->part_factor[d];
+  return banks;
+}
+
+// array of buffer b read or written by a pipelined loop, banked otherwise in the report: II not modelled
+static int Unsupported(array *a, int b, char *reason, int size)
+{
+  if (!a->pipelined || !REPORT_BANKS[b] || REPORT_BANKS[b] == Banks(a))
+    return 0;
+  snprintf(reason + strlen(reason), size - strlen(reason), "%s%s (%s): %d banks in the report, %ld from the directives",
+           reason[0] ? ", " : "", a->name, BUFFERS[b], REPORT_BANKS[b], Banks(a));
+  return 1;
+}
+
+// directives on the output of a layer and the input of the next apply to the shared buffer
+static void ShareBuffer(array *out, array *in)
+{
+  int d;
+
+  if (out->nb_dims != in->nb_dims)
+    return;
+  for (d = 0; d < out->nb_dims; d++)
+  {
+    if (!out->part_type[d])
+    {
+      out->part_type[d] = in->part_type[d];
+      out->part_factor[d] = in->part_factor[d];
+    }
+    in->part_type[d] = out->part_type[d];
+    in->part_factor[d] = out->part_factor[d];
+  }
+  out->ports = in->ports = out->ports < in->ports ? out->ports : in->ports;
+  out->pinned = in->pinned = out->pinned || in->pinned;
+}
+
+int main(int argc, char *argv[])
+{
+  static const char *default_files[] = { "conv.c", "pool.c", "fc.c" };
+  const char **files, *report, *where;
+  function *layers[8], *f;
+  context ctx;
+  char loops[512], reason[512], *src;
+  long long reported, total;
+  double error_sum, error, tolerance;
+  int opt, nb_files, k, l, first, next_loop, nb_checked, nb_outside, nb_unsupported, allow_unsupported;
+
+  report = NULL;
+  tolerance = DEFAULT_TOLERANCE;
+  allow_unsupported = 0;
+  while ((opt = getopt(argc, argv, "Pr:t:uvh")) != -1)
+  {
+    switch (opt)
+    {
+    case 'P': USE_PRAGMAS = 0; break;
+    case 'r': report = optarg; break;
+    case 't': tolerance = atof(optarg); break;
+    case 'u': allow_unsupported = 1; break;
+    case 'v': VERBOSE = 1; break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (!report)
+    report = USE_PRAGMAS ? DEFAULT_REPORT : DEFAULT_REPORT_NOPRAGMA;
+  files = optind < argc ? (const char **)&argv[optind] : default_files;
+  nb_files = optind < argc ? argc - optind : 3;
+
+  src = ReadFile("lenet_cnn_float.h");
+  if (!src)
+  {
+    printf("Error: Unable to open file lenet_cnn_float.h.\n");
+    exit(1);
+  }
+  Lex(src, "lenet_cnn_float.h", NULL, NULL, 0);
+  free(src);
+
+  for (k = 0; k < nb_files; k++)
+  {
+    src = ReadFile(files[k]);
+    if (!src)
+    {
+      printf("Error: Unable to open file %s.\n", files[k]);
+      exit(1);
+    }
+    first = NB_TOKENS;
+    Lex(src, files[k], TOKENS, &NB_TOKENS, MAX_TOKENS);
+    free(src);
+    ParseFunctions(first);
+  }
+
+  for (l = 0; LAYERS[l]; l++)
+  {
+    // the function holding the loops of the layer, a wrapper calling another kernel is skipped
+    for (k = 0; k < NB_FUNCTIONS; k++)
+      if (!strncmp(FUNCTIONS[k].name, LAYERS[l], strlen(LAYERS[l])) && ContainsLoop(FUNCTIONS[k].body))
+        break;
+    if (k == NB_FUNCTIONS)
+    {
+      printf("Error: No %s* function in the parsed files.\n", LAYERS[l]);
+      exit(1);
+    }
+    layers[l] = &FUNCTIONS[k];
+    if (l > 0 && layers[l - 1]->nb_params && layers[l]->nb_params)
+      ShareBuffer(&layers[l - 1]->arrays[layers[l - 1]->nb_params - 1], &layers[l]->arrays[0]);
+  }
+
+  ReadReport(report);
+  printf("\nEstimate %s pragmas, compared with %s%s\n\n", USE_PRAGMAS ? "with" : "without", report,
+         REPORT_TOTAL < 0 ? " (not found)" : "");
+  printf("%-31s %10s %10s %8s   %s\n", "function", "estimate", "report", "error", "pipelined loops: II (limiting array) x trips");
+
+  total = 0;
+  next_loop = 0;
+  nb_checked = 0;
+  nb_outside = 0;
+  nb_unsupported = 0;
+  error_sum = 0;
+  for (l = 0; LAYERS[l]; l++)
+  {
+    f = layers[l];
+    ctx.nb_vars = 0;
+    NB_LINES = 0;
+    f->latency = BlockLatency(f, f->body, &ctx);
+    total += f->latency + CALL_STATES;
+
+    loops[0] = 0;
+    for (k = 0; k < f->nb_loops; k++)
+      snprintf(loops + strlen(loops), sizeof(loops) - strlen(loops), "%s%s: II %ld (%s) x %ld", k ? ", " : "",
+               f->loops[k].var, f->loops[k].ii, f->loops[k].limit >= 0 ? f->arrays[f->loops[k].limit].name : "-",
+               f->loops[k].trips);
+    reported = Reported(LAYERS[l], &next_loop, &where);
+    if (reported > 0 && strcmp(where, "instance"))
+      snprintf(loops + strlen(loops), sizeof(loops) - strlen(loops), "%s(%s)", f->nb_loops ? " " : "", where);
+
+    // input (the output of the previous layer) and output buffers, both checked so that both are reported
+    reason[0] = 0;
+    if (f->nb_params && ((l > 0 && Unsupported(&f->arrays[0], l - 1, reason, sizeof(reason))) |
+                         Unsupported(&f->arrays[f->nb_params - 1], l, reason, sizeof(reason))))
+    {
+      printf("%-31s %10s %10lld %8s   unsupported partitioning\n", f->name, "-", reported, "-");
+      printf("    %s\n", reason);
+      nb_unsupported++;
+      continue;
+    }
+    if (reported > 0)
+    {
+      error = (double)llabs(f->latency - reported) / reported;
+      error_sum += error;
+      nb_checked++;
+      if (error > tolerance)
+      {
+        snprintf(loops + strlen(loops), sizeof(loops) - strlen(loops), "%sOUTSIDE TOLERANCE", loops[0] ? ", " : "");
+        nb_outside++;
+      }
+    }
+    PrintRow(f->name, f->latency, reported, loops[0] ? loops : "not pipelined");
+    for (k = 0; k < NB_LINES; k++)
+      printf("    %s\n", LINES[k]);
+  }
+
+  // the sum is only an estimate of lenet_cnn when every layer is
+  if (nb_unsupported)
+    printf("%-31s %10s %10lld %8s   %d unsupported layers\n", "lenet_cnn (sum + calls)", "-", REPORT_TOTAL, "-",
+           nb_unsupported);
+  else if (REPORT_TOTAL > 0 && (double)llabs(total - REPORT_TOTAL) / REPORT_TOTAL > tolerance)
+  {
+    PrintRow("lenet_cnn (sum + calls)", total, REPORT_TOTAL, "OUTSIDE TOLERANCE");
+    nb_outside++;
+  }
+  else
+    PrintRow("lenet_cnn (sum + calls)", total, REPORT_TOTAL, "");
+
+  if (!nb_checked)
+  {
+    printf("\nError: No layer checked against %s.\n\n", report);
+    return 1;
+  }
+  printf("\nMean absolute error over %d layers: %.1f%%, %d outside the %.0f%% tolerance, %d unsupported\n\n",
+         nb_checked, 100 * error_sum / nb_checked, nb_outside, 100 * tolerance, nb_unsupported);
+  // neither the unsupported layers nor the total were checked
+  if (nb_unsupported && !allow_unsupported)
+  {
+    printf("Error: %d layers with an unsupported partitioning, -u to accept them.\n\n", nb_unsupported);
+    return 1;
+  }
+  return nb_outside ? 1 : 0;
+}
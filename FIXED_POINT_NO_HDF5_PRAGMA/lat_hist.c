@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    lat_hist.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-image latency histograms (HDR style) for the evaluators
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "lat_hist.h"
+
+unsigned long long HistNow(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void HistReset(lat_hist *hist)
+{
+  memset(hist, 0, sizeof(lat_hist));
+  hist->min = ~0ULL;
+}
+
+// values below HIST_SUB_BUCKETS map to themselves, above to the top
+// HIST_SUB_BITS + 1 bits of the value
+static int BucketIndex(unsigned long long ns)
+{
+  int shift;
+
+  if (ns < HIST_SUB_BUCKETS)
+    return (int)ns;
+  shift = 63 - __builtin_clzll(ns) - HIST_SUB_BITS;
+  return (shift + 1) * HIST_SUB_BUCKETS + (int)(ns >> shift) - HIST_SUB_BUCKETS;
+}
+
+static unsigned long long BucketUpperBound(int index)
+{
+  int shift;
+
+  if (index < HIST_SUB_BUCKETS)
+    return index;
+  shift = index / HIST_SUB_BUCKETS - 1;
+  return ((unsigned long long)(index % HIST_SUB_BUCKETS + HIST_SUB_BUCKETS + 1) << shift) - 1;
+}
+
+void HistRecord(lat_hist *hist, unsigned long long ns)
+{
+  hist->counts[BucketIndex(ns)]++;
+  hist->total++;
+  hist->sum += ns;
+  if (ns < hist->min)
+    hist->min = ns;
+  if (ns > hist->max)
+    hist->max = ns;
+}
+
+unsigned long long HistPercentile(const lat_hist *hist, double percentile)
+{
+  unsigned long long rank, seen;
+  int k;
+
+  if (!hist->total)
+    return 0;
+  if (percentile >= 100)
+    return hist->max;
+
+  rank = (unsigned long long)(percentile / 100 * hist->total + 0.999999);
+  if (rank < 1)
+    rank = 1;
+  seen = 0;
+  for (k = 0; k < HIST_BUCKETS; k++)
+  {
+    seen += hist->counts[k];
+    if (seen >= rank)
+      break;
+  }
+  return BucketUpperBound(k) < hist->max ? BucketUpperBound(k) : hist->max;
+}
+
+void HistPrintHeader(const char *title)
+{
+  printf("%-16s %10s %10s %10s %10s %10s %10s\n", title, "p50", "p90", "p99", "p99.9", "max", "mean");
+}
+
+void HistPrint(const char *name, const lat_hist *hist)
+{
+  printf("%-16s %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", name, HistPercentile(hist, 50) / 1000.0,
+         HistPercentile(hist, 90) / 1000.0, HistPercentile(hist, 99) / 1000.0, HistPercentile(hist, 99.9) / 1000.0,
+         hist->max / 1000.0, hist->total ? hist->sum / hist->total / 1000 : 0);
+}
@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    lat_hist.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-image latency histograms (HDR style) for the evaluators
+  * @brief   Values in ns go to log-linear buckets: 2^HIST_SUB_BITS linear
+  *          sub-buckets per power of two, so a percentile is reported with a
+  *          relative error below 2^-HIST_SUB_BITS (0.8%) from 1 ns to hours,
+  *          in a fixed size array with no allocation in the timed loop.
+  *          Also used by the FLOAT evaluator (FLOAT/Makefile).
+  */
+
+#ifndef LAT_HIST_H
+#define LAT_HIST_H
+
+#define HIST_SUB_BITS       7
+#define HIST_SUB_BUCKETS    (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS        ((64 - HIST_SUB_BITS + 1) * HIST_SUB_BUCKETS)
+
+typedef struct {
+  unsigned long long counts[HIST_BUCKETS];
+  unsigned long long total;
+  unsigned long long min, max;
+  double sum;
+} lat_hist;
+
+// CLOCK_MONOTONIC in ns (vDSO, read from the TSC on x86)
+unsigned long long HistNow(void);
+
+void HistReset(lat_hist *hist);
+void HistRecord(lat_hist *hist, unsigned long long ns);
+
+// upper bound of the bucket holding the given percentile (0..100), exact max for 100
+unsigned long long HistPercentile(const lat_hist *hist, double percentile);
+
+// one table line per histogram: p50 p90 p99 p99.9 max mean, in us
+void HistPrintHeader(const char *title);
+void HistPrint(const char *name, const lat_hist *hist);
+
+#endif
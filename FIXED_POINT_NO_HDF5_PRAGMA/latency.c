@@ -0,0 +1,340 @@
+/**
+  ******************************************************************************
+  * @file    latency.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Single image latency mode: layer kernels restricted to a range of
+  *          output channels and the persistent thread team running them
+  * @brief   The *_part kernels are CPU copies of the loops of conv.c, pool.c
+  *          and fc.c with the outer loop over first..last-1; the HLS sources
+  *          keep their constant bounds. lenet_latency checks every image
+  *          against lenet_cnn, so the copies stay bit-exact.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#include "lenet_cnn_float.h"
+#include "workers.h"
+#include "latency.h"
+
+// range of items of worker w out of n
+#define PART_FIRST(total, w, n)   ((total) * (w) / (n))
+#define PART_LAST(total, w, n)    ((total) * ((w) + 1) / (n))
+
+static void Conv1_28x28x1_5x5x20_1_0_part(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],           // IN
+                                          short kernel[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM],   // IN
+                                          short bias[CONV1_NBOUTPUT],                                      // IN
+                                          short output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH],         // OUT
+                                          short first, short last)
+{
+  unsigned short o, h, w, x, y;
+  int conv_px_sum;
+
+  for (o = first; o < last; o++) {
+    for (h = 0; h < CONV1_HEIGHT; h++) {
+      for (w = 0; w < CONV1_WIDTH; w++) {
+        conv_px_sum = 0;
+        for (y = 0; y < CONV1_DIM; y++)
+          for (x = 0; x < CONV1_DIM; x++)
+            conv_px_sum = conv_px_sum + input[0][h+y][w+x] * kernel[o][0][y][x];
+
+        // neuron activation, same test as Conv1_28x28x1_5x5x20_1_0
+        if (conv_px_sum + bias[o] <= 0)
+          output[o][h][w] = 0;
+        else
+          output[o][h][w] = (conv_px_sum >> FIXED_POINT) + bias[o];
+      }
+    }
+  }
+}
+
+static void Pool1_24x24x20_2x2x20_2_0_part(short input[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH],        // IN
+                                           short output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH],       // OUT
+                                           short first, short last)
+{
+  unsigned short i, h, w;
+  short maxPool;
+
+  for (i = first; i < last; i++) {
+    for (h = 0; h < CONV1_HEIGHT; h += 2) {
+      for (w = 0; w < CONV1_WIDTH; w += 2) {
+        maxPool = input[i][h][w];
+        if (maxPool < input[i][h+1][w]) maxPool = input[i][h+1][w];
+        if (maxPool < input[i][h][w+1]) maxPool = input[i][h][w+1];
+        if (maxPool < input[i][h+1][w+1]) maxPool = input[i][h+1][w+1];
+        output[i][h>>1][w>>1] = maxPool;
+      }
+    }
+  }
+}
+
+static void Conv2_12x12x20_5x5x40_1_0_part(short input[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH],             // IN
+                                           short kernel[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM], // IN
+                                           short bias[CONV2_NBOUTPUT],                                         // IN
+                                           short output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH],            // OUT
+                                           short first, short last)
+{
+  unsigned short f, d, h, w, x, y;
+  int conv_px_sum;
+
+  for (f = first; f < last; f++) {
+    for (d = 0; d < POOL1_NBOUTPUT; d++) {
+      for (h = 0; h < CONV2_HEIGHT; h++) {
+        for (w = 0; w < CONV2_WIDTH; w++) {
+          conv_px_sum = 0;
+          for (y = 0; y < CONV2_DIM; y++)
+            for (x = 0; x < CONV2_DIM; x++)
+              conv_px_sum = conv_px_sum + input[d][h+y][w+x] * kernel[f][d][y][x];
+
+          // shifted back per input channel and accumulated in short, as Conv2_12x12x20_5x5x40_1_0
+          conv_px_sum = conv_px_sum >> FIXED_POINT;
+          if (d == 0)
+            output[f][h][w] = conv_px_sum;
+          else
+            output[f][h][w] += conv_px_sum;
+        }
+      }
+    }
+
+    // neuron activation
+    for (h = 0; h < CONV2_HEIGHT; h++)
+      for (w = 0; w < CONV2_WIDTH; w++)
+        output[f][h][w] = output[f][h][w] + bias[f] <= 0 ? 0 : output[f][h][w] + bias[f];
+  }
+}
+
+static void Pool2_8x8x40_2x2x40_2_0_part(short input[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH],          // IN
+                                         short output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],         // OUT
+                                         short first, short last)
+{
+  unsigned short j, h, w;
+  short maxPool;
+
+  for (j = first; j < last; j++) {
+    for (h = 0; h < CONV2_HEIGHT; h += 2) {
+      for (w = 0; w < CONV2_WIDTH; w += 2) {
+        maxPool = input[j][h][w];
+        if (maxPool < input[j][h+1][w]) maxPool = input[j][h+1][w];
+        if (maxPool < input[j][h][w+1]) maxPool = input[j][h][w+1];
+        if (maxPool < input[j][h+1][w+1]) maxPool = input[j][h+1][w+1];
+        output[j][h>>1][w>>1] = maxPool;
+      }
+    }
+  }
+}
+
+static void Fc1_40_400_part(short input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],                 // IN
+                            short kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                            short bias[FC1_NBOUTPUT],                                               // IN
+                            short output[FC1_NBOUTPUT],                                             // OUT
+                            short first, short last)
+{
+  unsigned short o, d, h, w;
+  short fc_sum;
+  int temp_sum;
+
+  for (o = first; o < last; o++) {
+    temp_sum = 0;
+    for (d = 0; d < POOL2_NBOUTPUT; d++)
+      for (h = 0; h < POOL2_HEIGHT; h++)
+        for (w = 0; w < POOL2_WIDTH; w++)
+          temp_sum = temp_sum + input[d][h][w] * kernel[o][d][h][w];
+
+    fc_sum = temp_sum >> FIXED_POINT;
+    output[o] = fc_sum + bias[o] <= 0 ? 0 : fc_sum + bias[o];
+  }
+}
+
+// Team of persistent threads
+
+// counter that threads wait on: spin first, then futex
+typedef struct {
+  _Atomic unsigned int value;
+  _Atomic int sleepers;
+} __attribute__((aligned(CACHE_LINE))) team_signal;
+
+typedef struct {
+  team_worker_stats stats;
+} __attribute__((aligned(CACHE_LINE))) team_worker;
+
+typedef struct {
+  lenet_team *team;
+  int worker;
+} team_thread_arg;
+
+struct lenet_team {
+  int nb_threads;
+  int spin;
+  pthread_t threads[MAX_WORKERS];
+  team_thread_arg thread_args[MAX_WORKERS];
+  team_worker workers[MAX_WORKERS];
+
+  team_signal start;          // generation, incremented for every image
+  team_signal phase;          // barrier generation
+  _Atomic int arrived;        // threads at the current barrier
+  _Atomic int shutdown;
+
+  // current job, written by the caller before start is incremented
+  unsigned char (*input)[IMG_HEIGHT][IMG_WIDTH];
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+};
+
+static void SignalWait(team_signal *signal, unsigned int seen, int spin, team_worker_stats *stats)
+{
+  int i;
+
+  for (i = 0; i < spin; i++) {
+    if (atomic_load_explicit(&signal->value, memory_order_acquire) != seen)
+      return;
+    CPU_RELAX();
+  }
+
+  // the futex call only sleeps if value still equals seen
+  atomic_fetch_add(&signal->sleepers, 1);
+  while (atomic_load(&signal->value) == seen) {
+    stats->parks++;
+    syscall(SYS_futex, (unsigned int *)&signal->value, FUTEX_WAIT_PRIVATE, seen, NULL, NULL, 0);
+  }
+  atomic_fetch_sub(&signal->sleepers, 1);
+}
+
+static void SignalPost(team_signal *signal)
+{
+  atomic_fetch_add(&signal->value, 1);
+  if (atomic_load(&signal->sleepers) > 0)
+    syscall(SYS_futex, (unsigned int *)&signal->value, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+// the last thread to arrive releases the others
+static void TeamBarrier(lenet_team *team, int worker)
+{
+  unsigned int phase;
+
+  phase = atomic_load(&team->phase.value);
+  if (atomic_fetch_add(&team->arrived, 1) == team->nb_threads - 1) {
+    atomic_store(&team->arrived, 0);
+    SignalPost(&team->phase);
+  } else {
+    SignalWait(&team->phase, phase, team->spin, &team->workers[worker].stats);
+  }
+}
+
+// share of one worker in one image, everything but FC2
+static void TeamSlice(lenet_team *team, int worker)
+{
+  int n = team->nb_threads;
+
+  Conv1_28x28x1_5x5x20_1_0_part(team->input, CONV1_KERNEL, CONV1_BIAS, team->conv1_output,
+                                PART_FIRST(CONV1_NBOUTPUT, worker, n), PART_LAST(CONV1_NBOUTPUT, worker, n));
+  Pool1_24x24x20_2x2x20_2_0_part(team->conv1_output, team->pool1_output,
+                                 PART_FIRST(CONV1_NBOUTPUT, worker, n), PART_LAST(CONV1_NBOUTPUT, worker, n));
+  TeamBarrier(team, worker);
+
+  Conv2_12x12x20_5x5x40_1_0_part(team->pool1_output, CONV2_KERNEL, CONV2_BIAS, team->conv2_output,
+                                 PART_FIRST(CONV2_NBOUTPUT, worker, n), PART_LAST(CONV2_NBOUTPUT, worker, n));
+  Pool2_8x8x40_2x2x40_2_0_part(team->conv2_output, team->pool2_output,
+                               PART_FIRST(CONV2_NBOUTPUT, worker, n), PART_LAST(CONV2_NBOUTPUT, worker, n));
+  TeamBarrier(team, worker);
+
+  Fc1_40_400_part(team->pool2_output, FC1_KERNEL, FC1_BIAS, team->fc1_output,
+                  PART_FIRST(FC1_NBOUTPUT, worker, n), PART_LAST(FC1_NBOUTPUT, worker, n));
+  TeamBarrier(team, worker);
+
+  team->workers[worker].stats.images++;
+}
+
+static void *TeamThread(void *arg)
+{
+  team_thread_arg *thread_arg = arg;
+  lenet_team *team = thread_arg->team;
+  unsigned int seen;
+
+  seen = 0;
+  while (1) {
+    SignalWait(&team->start, seen, team->spin, &team->workers[thread_arg->worker].stats);
+    seen = atomic_load(&team->start.value);
+    if (atomic_load(&team->shutdown))
+      return NULL;
+    TeamSlice(team, thread_arg->worker);
+  }
+}
+
+lenet_team *TeamCreate(int nb_threads, int spin)
+{
+  lenet_team *team;
+  int w;
+
+  if (nb_threads < 1)
+    nb_threads = 1;
+  if (nb_threads > MAX_WORKERS)
+    nb_threads = MAX_WORKERS;
+
+  team = aligned_alloc(CACHE_LINE, sizeof(lenet_team));
+  if (!team) {
+    printf("Error: Unable to allocate the thread team.\n");
+    exit(1);
+  }
+  memset(team, 0, sizeof(lenet_team));
+  team->nb_threads = nb_threads;
+  team->spin = spin;
+
+  for (w = 1; w < nb_threads; w++) {
+    team->thread_args[w].team = team;
+    team->thread_args[w].worker = w;
+    if (pthread_create(&team->threads[w], NULL, TeamThread, &team->thread_args[w]) != 0) {
+      printf("Error: Unable to start worker %d.\n", w);
+      exit(1);
+    }
+  }
+
+  return team;
+}
+
+void TeamDestroy(lenet_team *team)
+{
+  int w;
+
+  atomic_store(&team->shutdown, 1);
+  SignalPost(&team->start);
+  for (w = 1; w < team->nb_threads; w++)
+    pthread_join(team->threads[w], NULL);
+  free(team);
+}
+
+int TeamSize(lenet_team *team)
+{
+  return team->nb_threads;
+}
+
+void TeamStats(lenet_team *team, team_worker_stats stats[])
+{
+  int w;
+
+  for (w = 0; w < team->nb_threads; w++)
+    stats[w] = team->workers[w].stats;
+}
+
+void lenet_cnn_team(lenet_team *team,
+                    unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                    short output[FC2_NBOUTPUT])                             // OUT
+{
+  team->input = input;
+  SignalPost(&team->start);
+
+  // the last barrier of TeamSlice also means the workers are done with the buffers
+  TeamSlice(team, 0);
+  Fc2_400_10(team->fc1_output, FC2_KERNEL, FC2_BIAS, output);
+}
@@ -0,0 +1,39 @@
+/**
+  ******************************************************************************
+  * @file    latency.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Single image latency mode: one inference split across a team of
+  *          persistent threads
+  * @brief   Conv1 + Pool1 are split by filter (20), Conv2 + Pool2 by filter (40)
+  *          and FC1 by neuron (400), with a barrier after each of the three
+  *          steps; the caller runs FC2. Workers spin for a while waiting for
+  *          the next image or barrier, then park on a futex.
+  *          Results are bit-exact with lenet_cnn().
+  */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#define DEFAULT_SPIN    20000   // polls before parking
+
+typedef struct lenet_team lenet_team;
+
+typedef struct {
+  unsigned long long images;  // inferences the worker took part in
+  unsigned long long parks;   // futex waits (spin budget exhausted)
+} team_worker_stats;
+
+// nb_threads includes the caller, which acts as worker 0
+lenet_team *TeamCreate(int nb_threads, int spin);
+void TeamDestroy(lenet_team *team);
+int TeamSize(lenet_team *team);
+void TeamStats(lenet_team *team, team_worker_stats stats[]);  // OUT, one per worker
+
+// same result as lenet_cnn(), one image at a time per team
+void lenet_cnn_team(lenet_team *team,
+                    unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                    short output[FC2_NBOUTPUT]);                            // OUT
+
+#endif
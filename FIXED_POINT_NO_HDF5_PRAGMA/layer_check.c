@@ -0,0 +1,203 @@
+/**
+  ******************************************************************************
+  * @file    layer_check.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Runs two implementations of the network side by side on the test set,
+  *          compares every intermediate tensor and reports the first divergence
+  * @brief   usage: ./layer_check [-a abs_tol] [-r rel_tol] [-n max_images] engine_a engine_b
+  *          ./layer_check -l lists the engines; exit status is 1 when a tensor diverges
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "engine.h"
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-a abs_tol] [-r rel_tol] [-n max_images] engine_a engine_b\n", program);
+  printf("       elements diverge when |a - b| > abs_tol + rel_tol * max(|a|, |b|), default bit-exact\n\n");
+  printf("engines:\n");
+  ListEngines();
+}
+
+// [c][y][x] position of element i in a layer, or [i] for the fully connected layers
+static void FormatIndex(int layer, int i, char *text)
+{
+  int height, width;
+
+  switch (layer)
+  {
+  case LAYER_CONV1: height = CONV1_HEIGHT; width = CONV1_WIDTH; break;
+  case LAYER_POOL1: height = POOL1_HEIGHT; width = POOL1_WIDTH; break;
+  case LAYER_CONV2: height = CONV2_HEIGHT; width = CONV2_WIDTH; break;
+  case LAYER_POOL2: height = POOL2_HEIGHT; width = POOL2_WIDTH; break;
+  default:
+    sprintf(text, "[%d]", i);
+    return;
+  }
+  sprintf(text, "[%d][%d][%d]", i / (height * width), (i / width) % height, i % width);
+}
+
+// images per second and errors of one engine, without trace export
+static double Throughput(lenet_engine *engine, unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],
+                         unsigned char *labels, int nb_images, unsigned int *error)
+{
+  float logits[FC2_NBOUTPUT];
+  double tstart;
+  int m;
+
+  *error = 0;
+  tstart = TimeNow();
+  for (m = 0; m < nb_images; m++)
+    if (engine->run(images[m], logits, NULL) != labels[m])
+      (*error)++;
+
+  return nb_images / (TimeNow() - tstart);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  layer_trace *trace_a, *trace_b;
+  lenet_engine *engine_a, *engine_b;
+  float logits_a[FC2_NBOUTPUT], logits_b[FC2_NBOUTPUT];
+  float *out_a, *out_b, diff, tol, abs_tol, rel_tol;
+  float max_diff[NB_LAYERS];
+  double sum_diff[NB_LAYERS], rate_a, rate_b;
+  unsigned int diverging[NB_LAYERS], diverging_images[NB_LAYERS], error_a, error_b, prediction_diff;
+  int first_image, first_layer, first_index, image_diverges;
+  int opt, m, layer, size, i, nb_images, max_images;
+  char index_text[32];
+
+  abs_tol = 0;
+  rel_tol = 0;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "a:r:n:lh")) != -1)
+  {
+    switch (opt)
+    {
+    case 'a': abs_tol = atof(optarg); break;
+    case 'r': rel_tol = atof(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    case 'l':
+      ListEngines();
+      return 0;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind != 2)
+  {
+    Usage(argv[0]);
+    return 2;
+  }
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  engine_a = FindEngine(argv[optind]);
+  engine_b = FindEngine(argv[optind + 1]);
+  if (!engine_a || !engine_b)
+  {
+    printf("Error: Unknown engine %s.\n\n", !engine_a ? argv[optind] : argv[optind + 1]);
+    Usage(argv[0]);
+    return 2;
+  }
+
+  images = malloc(sizeof(*images) * max_images);
+  trace_a = malloc(sizeof(layer_trace));
+  trace_b = malloc(sizeof(layer_trace));
+  if (!images || !trace_a || !trace_b)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  printf("\n%s vs %s on %d images, element diverges when |a - b| > %g + %g * max(|a|, |b|)\n\n",
+         engine_a->name, engine_b->name, nb_images, abs_tol, rel_tol);
+
+  for (layer = 0; layer < NB_LAYERS; layer++)
+  {
+    max_diff[layer] = 0;
+    sum_diff[layer] = 0;
+    diverging[layer] = 0;
+    diverging_images[layer] = 0;
+  }
+  first_image = -1;
+  first_layer = 0;
+  first_index = 0;
+  prediction_diff = 0;
+
+  for (m = 0; m < nb_images; m++)
+  {
+    if (engine_a->run(images[m], logits_a, trace_a) != engine_b->run(images[m], logits_b, trace_b))
+      prediction_diff++;
+
+    for (layer = 0; layer < NB_LAYERS; layer++)
+    {
+      out_a = TraceLayer(trace_a, layer, &size);
+      out_b = TraceLayer(trace_b, layer, &size);
+      image_diverges = 0;
+      for (i = 0; i < size; i++)
+      {
+        diff = fabsf(out_a[i] - out_b[i]);
+        tol = abs_tol + rel_tol * fmaxf(fabsf(out_a[i]), fabsf(out_b[i]));
+        sum_diff[layer] += diff;
+        if (diff > max_diff[layer])
+          max_diff[layer] = diff;
+        if (diff > tol)
+        {
+          diverging[layer]++;
+          image_diverges = 1;
+          if (first_image < 0)
+          {
+            first_image = m;
+            first_layer = layer;
+            first_index = i;
+            printf("First divergence: image %d, layer %s, element ", m, LAYER_NAMES[layer]);
+            FormatIndex(layer, i, index_text);
+            printf("%s: %s %g, %s %g\n\n", index_text, engine_a->name, out_a[i], engine_b->name, out_b[i]);
+          }
+        }
+      }
+      diverging_images[layer] += image_diverges;
+    }
+  }
+
+  printf("%-6s %10s %12s %12s %14s %10s\n", "layer", "elements", "max |diff|", "mean |diff|", "diverging", "images");
+  for (layer = 0; layer < NB_LAYERS; layer++)
+  {
+    TraceLayer(trace_a, layer, &size);
+    printf("%-6s %10d %12g %12g %14u %10u\n", LAYER_NAMES[layer], size, max_diff[layer],
+           sum_diff[layer] / ((double)size * nb_images), diverging[layer], diverging_images[layer]);
+  }
+  if (first_image < 0)
+    printf("\nNo divergence\n");
+  else
+    printf("\nFirst divergence at image %d, layer %s, element %d\n", first_image, LAYER_NAMES[first_layer], first_index);
+
+  rate_a = Throughput(engine_a, images, labels, nb_images, &error_a);
+  rate_b = Throughput(engine_b, images, labels, nb_images, &error_b);
+
+  printf("Predictions differ on %u / %d images\n\n", prediction_diff, nb_images);
+  printf("%-12s %14s %12s\n", "engine", "errors", "images/s");
+  printf("%-12s %8u / %-5d %12.1f\n", engine_a->name, error_a, nb_images, rate_a);
+  printf("%-12s %8u / %-5d %12.1f\n\n", engine_b->name, error_b, nb_images, rate_b);
+
+  free(trace_b);
+  free(trace_a);
+  free(images);
+
+  return first_image < 0 ? 0 : 1;
+}
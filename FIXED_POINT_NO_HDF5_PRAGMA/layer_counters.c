@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file    layer_counters.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Test set through lenet_cnn with per-layer hardware counters (counters.h)
+  * @brief   usage: ./layer_counters [-n max_images]
+  *          Prints per image and per layer: time, cycles, instructions,
+  *          L1D / LLC misses, branch misses and IPC. Needs perf_event_paranoid
+  *          <= 2 (user space counting of the own process).
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "counters.h"
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-n max_images]\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES];
+  unsigned char input_norm[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  unsigned int error;
+  int opt, m, nb_images, max_images, nb_counters;
+
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  nb_counters = CountersOpen();
+  printf("%d / %d hardware counters available\n", nb_counters, NB_COUNTERS);
+
+  error = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    NormalizeImg((unsigned char *)images[m], (unsigned char *)input_norm, IMG_WIDTH, IMG_HEIGHT);
+    lenet_cnn(input_norm, fc2_output);
+    Softmax(fc2_output, softmax_output);
+    if (ClassifySoftmax(softmax_output) != labels[m])
+      error = error + 1;
+  }
+
+  CountersPrint(nb_images);
+  CountersClose();
+
+  printf("\n\nErrors : %d / %d", error, nb_images);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+  printf("\n\n");
+
+  return 0;
+}
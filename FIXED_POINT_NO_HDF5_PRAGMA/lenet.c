@@ -0,0 +1,240 @@
+/**
+  ******************************************************************************
+  * @file    lenet.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Reentrant inference library: lenet_cnn_local on a model and a context
+  *          in place of the global variables of lenet_cnn_float.c
+  * @brief   lenet_infer_batch runs Conv1 to Pool2 image by image and FC1 on
+  *          tiles of LIB_BATCH images, one pass over the FC1 weights (512 KB,
+  *          most of the model) per tile instead of per image.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "lenet_cnn_float.h"
+#include "lenet.h"
+#include "trace.h"
+
+#define LIB_ALIGN       64
+#define LIB_BATCH       16      // images sharing one pass over the FC1 weights
+
+_Static_assert(LENET_WIDTH == IMG_WIDTH && LENET_HEIGHT == IMG_HEIGHT && IMG_DEPTH == 1, "lenet.h image size");
+_Static_assert(LENET_NB_CLASSES == FC2_NBOUTPUT, "lenet.h number of classes");
+_Static_assert(LENET_FIXED_POINT == FIXED_POINT, "lenet.h fixed point");
+
+struct lenet_model {
+  lenet_weights weights;
+};
+
+struct lenet_ctx {
+  const lenet_model *model;
+  lenet_cache *cache;                       // NULL without cache
+  lenet_scratch scratch;
+  unsigned char input_norm[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  // batch tile: FC1 inputs and outputs of the cache misses, their hashes and results
+  short features[LIB_BATCH][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[LIB_BATCH][FC1_NBOUTPUT];
+  unsigned long long hashes[LIB_BATCH];
+  const unsigned char *pixels[LIB_BATCH];
+  lenet_result *results[LIB_BATCH];
+};
+
+// aligned_alloc needs a multiple of the alignment
+static void *AllocAligned(size_t size)
+{
+  return aligned_alloc(LIB_ALIGN, (size + LIB_ALIGN - 1) & ~(size_t)(LIB_ALIGN - 1));
+}
+
+lenet_model *lenet_model_create(void)
+{
+  lenet_model *model;
+
+  model = AllocAligned(sizeof(lenet_model));
+  if (!model)
+    return NULL;
+  CopyWeights(&model->weights);
+  return model;
+}
+
+void lenet_model_destroy(lenet_model *model)
+{
+  free(model);
+}
+
+lenet_ctx *lenet_ctx_create(const lenet_model *model)
+{
+  lenet_ctx *ctx;
+
+  if (!model)
+    return NULL;
+  ctx = AllocAligned(sizeof(lenet_ctx));
+  if (!ctx)
+    return NULL;
+  memset(ctx, 0, sizeof(lenet_ctx));
+  ctx->model = model;
+  return ctx;
+}
+
+void lenet_ctx_destroy(lenet_ctx *ctx)
+{
+  free(ctx);
+}
+
+void lenet_ctx_set_cache(lenet_ctx *ctx, lenet_cache *cache)
+{
+  if (ctx)
+    ctx->cache = cache;
+}
+
+// Fc1_40_400 on nb_images inputs, each kernel row is read once for all of them
+// and each weight loaded once for 4 images; same arithmetic, CPU only
+static void Fc1_40_400_batch(short input[][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],          // IN [nb_images]
+                             int nb_images,
+                             short kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                             short bias[FC1_NBOUTPUT],                                               // IN
+                             short output[][FC1_NBOUTPUT])                                           // OUT [nb_images]
+{
+  unsigned short o, i;
+  short fc_sum, *row, *in0, *in1, *in2, *in3;
+  int temp_sum[4], b, k, n;
+
+  for (o = 0; o < FC1_NBOUTPUT; o++) {
+    row = &kernel[o][0][0][0];
+    for (b = 0; b < nb_images; b += n) {
+      in0 = &input[b][0][0][0];
+      temp_sum[0] = temp_sum[1] = temp_sum[2] = temp_sum[3] = 0;
+      if (nb_images - b >= 4) {
+        n = 4;
+        in1 = &input[b+1][0][0][0];
+        in2 = &input[b+2][0][0][0];
+        in3 = &input[b+3][0][0][0];
+        for (i = 0; i < FC1_NBINPUT; i++) {
+          temp_sum[0] = temp_sum[0] + in0[i] * row[i];
+          temp_sum[1] = temp_sum[1] + in1[i] * row[i];
+          temp_sum[2] = temp_sum[2] + in2[i] * row[i];
+          temp_sum[3] = temp_sum[3] + in3[i] * row[i];
+        }
+      } else {
+        // last images of the batch one at a time
+        n = 1;
+        for (i = 0; i < FC1_NBINPUT; i++)
+          temp_sum[0] = temp_sum[0] + in0[i] * row[i];
+      }
+
+      // shifting back and neuron activation, as Fc1_40_400
+      for (k = 0; k < n; k++) {
+        fc_sum = temp_sum[k] >> FIXED_POINT;
+        output[b+k][o] = fc_sum + bias[o] <= 0 ? 0 : fc_sum + bias[o];
+      }
+    }
+  }
+}
+
+static void Classify(lenet_result *result)
+{
+  TRACE_BEGIN(TRACE_SOFTMAX);
+  Softmax(result->logits, result->softmax);
+  result->label = ClassifySoftmax(result->softmax);
+  TRACE_END(TRACE_SOFTMAX);
+  result->probability = result->softmax[result->label];
+}
+
+// 1 with result->logits filled from the cache, else the normalized image in ctx->input_norm
+static int Prepare(lenet_ctx *ctx, const unsigned char *pixels, lenet_result *result, unsigned long long *hash)
+{
+  *hash = 0;
+  if (ctx->cache)
+  {
+    *hash = CacheHash(pixels);
+    if (CacheLookup(ctx->cache, *hash, pixels, result->logits))
+      return 1;
+  }
+
+  TRACE_BEGIN(TRACE_NORMALIZE);
+  NormalizeImg((unsigned char *)pixels, (unsigned char *)ctx->input_norm, IMG_WIDTH, IMG_HEIGHT);
+  TRACE_END(TRACE_NORMALIZE);
+  return 0;
+}
+
+static void InferOne(lenet_ctx *ctx, const unsigned char *pixels, lenet_result *result)
+{
+  unsigned long long hash;
+
+  if (!Prepare(ctx, pixels, result, &hash))
+  {
+    // the kernels take non-const arrays but only read the weights
+    lenet_cnn_local((lenet_weights *)&ctx->model->weights, &ctx->scratch, ctx->input_norm, result->logits);
+
+    if (ctx->cache)
+      CacheInsert(ctx->cache, hash, pixels, result->logits);
+  }
+  Classify(result);
+}
+
+// FC1 of the tile as one matrix product, then FC2 and softmax image by image
+static void FlushTile(lenet_ctx *ctx, int count)
+{
+  lenet_weights *weights;
+  int k;
+
+  weights = (lenet_weights *)&ctx->model->weights;
+  TRACE_BEGIN(TRACE_FC1);
+  Fc1_40_400_batch(ctx->features, count, weights->fc1_kernel, weights->fc1_bias, ctx->fc1_output);
+  TRACE_END(TRACE_FC1);
+
+  for (k = 0; k < count; k++)
+  {
+    TRACE_BEGIN(TRACE_FC2);
+    Fc2_400_10(ctx->fc1_output[k], weights->fc2_kernel, weights->fc2_bias, ctx->results[k]->logits);
+    TRACE_END(TRACE_FC2);
+
+    if (ctx->cache)
+      CacheInsert(ctx->cache, ctx->hashes[k], ctx->pixels[k], ctx->results[k]->logits);
+    Classify(ctx->results[k]);
+  }
+}
+
+int lenet_infer(lenet_ctx *ctx, const unsigned char pixels[LENET_PIXELS], lenet_result *result)
+{
+  if (!ctx || !pixels || !result)
+    return LENET_EINVAL;
+
+  InferOne(ctx, pixels, result);
+  return LENET_OK;
+}
+
+int lenet_infer_batch(lenet_ctx *ctx, const unsigned char *pixels, int nb_images, lenet_result *results)
+{
+  const unsigned char *image;
+  int m, count;
+
+  if (!ctx || nb_images < 0 || (nb_images && (!pixels || !results)))
+    return LENET_EINVAL;
+
+  // cache hits are answered at once, the misses fill the tile
+  count = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    image = pixels + (size_t)m * LENET_PIXELS;
+    if (Prepare(ctx, image, &results[m], &ctx->hashes[count]))
+    {
+      Classify(&results[m]);
+      continue;
+    }
+    lenet_cnn_local_features((lenet_weights *)&ctx->model->weights, &ctx->scratch, ctx->input_norm);
+    memcpy(ctx->features[count], ctx->scratch.pool2_output, sizeof(ctx->features[count]));
+    ctx->pixels[count] = image;
+    ctx->results[count] = &results[m];
+    if (++count == LIB_BATCH)
+    {
+      FlushTile(ctx, count);
+      count = 0;
+    }
+  }
+  if (count)
+    FlushTile(ctx, count);
+  return LENET_OK;
+}
@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    lenet.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Reentrant inference library (liblenet.a / liblenet.so)
+  * @brief   A lenet_model holds the fixed point weights and is read-only once
+  *          created, so one model can be shared by any number of threads.
+  *          A lenet_ctx holds the activations of one inference: use one context
+  *          per thread. The library keeps no state of its own.
+  *
+  *          lenet_model *model = lenet_model_create();
+  *          lenet_ctx *ctx = lenet_ctx_create(model);
+  *          lenet_infer(ctx, pixels, &result);
+  *          lenet_ctx_destroy(ctx);
+  *          lenet_model_destroy(model);
+  *
+  *          An optional lenet_cache, shared by any number of contexts, returns
+  *          the logits of an image seen before (same 784 bytes) without
+  *          running the network.
+  */
+
+#ifndef LENET_H
+#define LENET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LENET_WIDTH         28
+#define LENET_HEIGHT        28
+#define LENET_PIXELS        (LENET_WIDTH*LENET_HEIGHT)      // one 8-bit grayscale image, row major
+#define LENET_NB_CLASSES    10
+#define LENET_FIXED_POINT   8                               // logits are in 1/256 units
+
+// only these functions are exported by liblenet.so
+#define LENET_API   __attribute__((visibility("default")))
+
+enum { LENET_OK = 0, LENET_EINVAL = -1 };
+
+typedef struct lenet_model lenet_model;
+typedef struct lenet_ctx lenet_ctx;
+typedef struct lenet_cache lenet_cache;
+
+typedef struct {
+  unsigned char label;                      // most probable digit
+  float probability;                        // its softmax probability
+  short logits[LENET_NB_CLASSES];           // FC2 outputs, fixed point
+  float softmax[LENET_NB_CLASSES];
+} lenet_result;
+
+typedef struct {
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+  int entries;
+  int capacity;
+} lenet_cache_stats;
+
+// weights of weights.h, NULL when out of memory
+LENET_API lenet_model *lenet_model_create(void);
+LENET_API void lenet_model_destroy(lenet_model *model);
+
+// scratch buffers for one thread, NULL when out of memory;
+// the model must outlive its contexts
+LENET_API lenet_ctx *lenet_ctx_create(const lenet_model *model);
+LENET_API void lenet_ctx_destroy(lenet_ctx *ctx);
+
+// bounded prediction cache keyed by a hash of the pixels, split in nb_shards
+// (power of two) independently locked shards with CLOCK eviction; NULL when
+// out of memory or on invalid sizes
+LENET_API lenet_cache *lenet_cache_create(int capacity, int nb_shards);
+LENET_API void lenet_cache_destroy(lenet_cache *cache);
+LENET_API void lenet_cache_get_stats(lenet_cache *cache, lenet_cache_stats *stats);   // OUT
+
+// checks cache before each inference of ctx and fills it on misses, NULL to
+// stop; the cache must outlive the contexts that use it
+LENET_API void lenet_ctx_set_cache(lenet_ctx *ctx, lenet_cache *cache);
+
+// classifies one image, LENET_OK or LENET_EINVAL
+LENET_API int lenet_infer(lenet_ctx *ctx,
+                          const unsigned char pixels[LENET_PIXELS],  // IN
+                          lenet_result *result);                     // OUT
+
+// classifies nb_images images stored one after the other, LENET_OK or LENET_EINVAL
+LENET_API int lenet_infer_batch(lenet_ctx *ctx,
+                                const unsigned char *pixels,         // IN, nb_images * LENET_PIXELS
+                                int nb_images,
+                                lenet_result *results);              // OUT, nb_images
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    lenet_async.cpp
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Batching executor of the coroutine interface (lenet_async.hpp)
+  */
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "lenet_async.hpp"
+
+namespace lenet {
+
+lenet_result Executor::ClassifyAwaiter::await_resume()
+{
+  if (status_ != LENET_OK)
+    throw std::invalid_argument("lenet: invalid image");
+  return result_;
+}
+
+Executor::Executor(int nb_workers, int max_batch, std::chrono::microseconds max_wait)
+  : max_batch_(max_batch < 1 ? 1 : max_batch), max_wait_(max_wait)
+{
+  model_ = lenet_model_create();
+  if (!model_)
+    throw std::bad_alloc();
+  if (nb_workers < 1)
+    nb_workers = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+  // allocated here so that a failure reaches the caller, not a worker thread
+  try
+  {
+    for (int w = 0; w < nb_workers; w++)
+    {
+      contexts_.push_back(lenet_ctx_create(model_));
+      if (!contexts_.back())
+        throw std::bad_alloc();
+    }
+    for (auto *ctx : contexts_)
+      workers_.emplace_back(&Executor::WorkerLoop, this, ctx);
+  }
+  catch (...)
+  {
+    Stop();
+    throw;
+  }
+}
+
+// the queued coroutines are still run before the workers leave
+Executor::~Executor()
+{
+  Stop();
+}
+
+void Executor::Stop()
+{
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    running_ = false;
+  }
+  not_empty_.notify_all();
+  for (auto &worker : workers_)
+    worker.join();
+  for (auto *ctx : contexts_)
+    lenet_ctx_destroy(ctx);
+  lenet_model_destroy(model_);
+}
+
+ExecutorStats Executor::Stats()
+{
+  std::lock_guard<std::mutex> guard(lock_);
+  return stats_;
+}
+
+void Executor::Submit(ClassifyAwaiter *awaiter)
+{
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    queue_.push_back(awaiter);
+  }
+  not_empty_.notify_one();
+}
+
+void Executor::WorkerLoop(lenet_ctx *ctx)
+{
+  std::vector<ClassifyAwaiter *> batch;
+  std::vector<std::coroutine_handle<>> handles;
+  std::vector<unsigned char> pixels(static_cast<size_t>(max_batch_) * LENET_PIXELS);
+  std::vector<lenet_result> results(max_batch_);
+
+  while (true)
+  {
+    batch.clear();
+    {
+      std::unique_lock<std::mutex> guard(lock_);
+      not_empty_.wait(guard, [this] { return !queue_.empty() || !running_; });
+      if (queue_.empty())
+        break;
+
+      // the first arrival waits at most max_wait for the batch to fill
+      if ((int)queue_.size() < max_batch_ && running_)
+        not_empty_.wait_for(guard, max_wait_, [this] { return (int)queue_.size() >= max_batch_ || !running_; });
+
+      while (!queue_.empty() && (int)batch.size() < max_batch_)
+      {
+        batch.push_back(queue_.front());
+        queue_.pop_front();
+      }
+      stats_.images += batch.size();
+      stats_.batches++;
+    }
+
+    // invalid images are answered one by one, the rest in a single call
+    int n = 0;
+    for (auto *awaiter : batch)
+      if (awaiter->pixels_)
+        std::memcpy(&pixels[static_cast<size_t>(n++) * LENET_PIXELS], awaiter->pixels_, LENET_PIXELS);
+    lenet_infer_batch(ctx, pixels.data(), n, results.data());
+
+    n = 0;
+    for (auto *awaiter : batch)
+    {
+      if (awaiter->pixels_)
+        awaiter->result_ = results[n++];
+      else
+        awaiter->status_ = LENET_EINVAL;
+    }
+
+    // an awaiter may be destroyed by its own resumption: handles first
+    handles.clear();
+    for (auto *awaiter : batch)
+      handles.push_back(awaiter->handle_);
+    for (auto handle : handles)
+      handle.resume();
+  }
+}
+
+}
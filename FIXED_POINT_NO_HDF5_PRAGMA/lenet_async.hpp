@@ -0,0 +1,94 @@
+/**
+  ******************************************************************************
+  * @file    lenet_async.hpp
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   C++20 coroutine interface over liblenet (lenet.h)
+  * @brief   lenet::Executor owns the model and a few worker threads, each with
+  *          its own lenet_ctx. classify() returns an awaitable: the awaiting
+  *          coroutine is queued, the workers take the queue in batches (up to
+  *          max_batch, or what has arrived after max_wait) and resume every
+  *          coroutine of the batch on the worker thread once its result is
+  *          written. No thread is blocked per call.
+  *
+  *          lenet::Executor lenet;
+  *          lenet_result result = co_await lenet.classify(pixels);
+  *
+  *          The pixels must stay valid until the coroutine is resumed. The
+  *          executor must outlive the coroutines that await it.
+  */
+
+#ifndef LENET_ASYNC_HPP
+#define LENET_ASYNC_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lenet.h"
+
+namespace lenet {
+
+struct ExecutorStats {
+  unsigned long long images = 0;
+  unsigned long long batches = 0;
+};
+
+class Executor {
+public:
+  // one awaiting coroutine, lives in its frame while suspended
+  class ClassifyAwaiter {
+  public:
+    ClassifyAwaiter(Executor &executor, const unsigned char *pixels) : executor_(executor), pixels_(pixels) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { handle_ = handle; executor_.Submit(this); }
+    lenet_result await_resume();    // throws std::invalid_argument for NULL pixels
+
+  private:
+    friend class Executor;
+    Executor &executor_;
+    const unsigned char *pixels_;
+    std::coroutine_handle<> handle_;
+    lenet_result result_{};
+    int status_ = LENET_OK;
+  };
+
+  // nb_workers 0: one per online cpu; throws std::bad_alloc when the model or a
+  // context cannot be allocated, std::system_error when a worker cannot start
+  explicit Executor(int nb_workers = 0, int max_batch = 32,
+                    std::chrono::microseconds max_wait = std::chrono::microseconds(200));
+  ~Executor();
+
+  Executor(const Executor &) = delete;
+  Executor &operator=(const Executor &) = delete;
+
+  ClassifyAwaiter classify(const unsigned char pixels[LENET_PIXELS]) { return ClassifyAwaiter(*this, pixels); }
+
+  ExecutorStats Stats();
+
+private:
+  void Submit(ClassifyAwaiter *awaiter);
+  void WorkerLoop(lenet_ctx *ctx);
+  void Stop();
+
+  lenet_model *model_;
+  int max_batch_;
+  std::chrono::microseconds max_wait_;
+  std::mutex lock_;
+  std::condition_variable not_empty_;
+  std::deque<ClassifyAwaiter *> queue_;
+  bool running_ = true;
+  ExecutorStats stats_;
+  std::vector<lenet_ctx *> contexts_;      // one per worker, created before it starts
+  std::vector<std::thread> workers_;
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+/**
+  ******************************************************************************
+  * @file    lenet_bench.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-layer microbenchmarks of the fixed point (this tree) and FLOAT layers (make bench)
+  * @brief   usage: ./lenet_bench [-c cpu] [-w warmup_samples] [-r samples] [-t tree] [-l layer]
+  *          The thread is pinned to one cpu. Each case is calibrated so that a
+  *          sample lasts at least MIN_SAMPLE_NS, run for the warm-up samples,
+  *          then timed over the samples; ns/call is the median sample (min also
+  *          printed). MAC/s counts the multiply-accumulates of the layer, GB/s
+  *          its input, weight, bias and output bytes once per call.
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-c cpu] [-w warmup_samples] [-r samples] [-t fixed|float] [-l layer]\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+  bench_case cases[MAX_BENCH_CASES];
+  char *tree, *layer;
+  int opt, cpu, warmup, nb_samples, nb_cases, k;
+  double median, min;
+
+  cpu = sched_getcpu();
+  warmup = BENCH_WARMUP;
+  nb_samples = BENCH_SAMPLES;
+  tree = NULL;
+  layer = NULL;
+  while ((opt = getopt(argc, argv, "c:w:r:t:l:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'c': cpu = atoi(optarg); break;
+    case 'w': warmup = atoi(optarg); break;
+    case 'r': nb_samples = atoi(optarg); break;
+    case 't': tree = optarg; break;
+    case 'l': layer = optarg; break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_samples < 1 || nb_samples > BENCH_MAX_SAMPLES)
+    nb_samples = BENCH_SAMPLES;
+  if (warmup < 0)
+    warmup = 0;
+
+  BenchPin(cpu);
+
+  nb_cases = FixedBenchCases(cases);
+  nb_cases += FloatBenchCases(cases + nb_cases);
+
+  printf("cpu %d, %d warm-up samples, %d samples of at least %d us\n\n", cpu, warmup, nb_samples, BENCH_MIN_SAMPLE_NS / 1000);
+  printf("%-6s %-26s %12s %12s %10s %8s\n", "tree", "layer", "ns/call", "min ns", "GMAC/s", "GB/s");
+  for (k = 0; k < nb_cases; k++)
+  {
+    if ((tree && strcmp(tree, cases[k].tree)) || (layer && !strstr(cases[k].layer, layer)))
+      continue;
+    BenchRun(&cases[k], warmup, nb_samples, &median, &min);
+    printf("%-6s %-26s %12.1f %12.1f", cases[k].tree, cases[k].layer, median, min);
+    if (cases[k].macs)
+      printf(" %10.3f", cases[k].macs / median);
+    else
+      printf(" %10s", "-");
+    printf(" %8.2f\n", cases[k].bytes / median);
+  }
+  printf("\n");
+
+  return 0;
+}
@@ -0,0 +1,241 @@
+/**
+  ******************************************************************************
+  * @file    lenet_cache.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Prediction cache of liblenet (lenet.h): logits of the images already
+  *          classified, keyed by a 64-bit hash of the 784 pixels
+  * @brief   The hash selects a shard, each shard has its own mutex, a chained
+  *          hash index and a fixed array of entries evicted in CLOCK order: an
+  *          entry hit since the last pass of the hand gets a second chance.
+  *          Entries keep the pixels, so a hash collision is a miss, never a
+  *          wrong prediction.
+  */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "lenet_cnn_float.h"
+#include "lenet.h"
+
+#define CACHE_NONE      -1
+
+typedef struct {
+  unsigned long long hash;
+  int next;                                 // chain of the hash bucket
+  unsigned char referenced;                 // CLOCK bit
+  unsigned char pixels[LENET_PIXELS];
+  short logits[LENET_NB_CLASSES];
+} cache_entry;
+
+typedef struct {
+  pthread_mutex_t lock;
+  cache_entry *entries;
+  int *buckets;                             // first entry of each bucket
+  int nb_entries;
+  int nb_buckets;                           // power of two
+  int used;
+  int hand;
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long evictions;
+} __attribute__((aligned(64))) cache_shard;
+
+struct lenet_cache {
+  cache_shard *shards;
+  int nb_shards;
+  int capacity;
+};
+
+// 8 bytes at a time, multiply and xor-shift mixing (784 = 98 words)
+unsigned long long CacheHash(const unsigned char *pixels)
+{
+  unsigned long long hash, word;
+  int k;
+
+  hash = 0x9e3779b97f4a7c15ULL;
+  for (k = 0; k < LENET_PIXELS; k += 8)
+  {
+    memcpy(&word, pixels + k, 8);
+    hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 32;
+  }
+  hash ^= hash >> 29;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  return hash ^ (hash >> 32);
+}
+
+lenet_cache *lenet_cache_create(int capacity, int nb_shards)
+{
+  lenet_cache *cache;
+  cache_shard *shard;
+  int s, k;
+
+  if (capacity < 1 || nb_shards < 1 || (nb_shards & (nb_shards - 1)))
+    return NULL;
+  cache = calloc(1, sizeof(lenet_cache));
+  if (!cache)
+    return NULL;
+  cache->shards = aligned_alloc(64, sizeof(cache_shard) * nb_shards);
+  if (!cache->shards)
+  {
+    free(cache);
+    return NULL;
+  }
+  memset(cache->shards, 0, sizeof(cache_shard) * nb_shards);
+  cache->nb_shards = nb_shards;
+  cache->capacity = 0;
+
+  for (s = 0; s < nb_shards; s++)
+  {
+    shard = &cache->shards[s];
+    pthread_mutex_init(&shard->lock, NULL);
+    shard->nb_entries = (capacity + nb_shards - 1) / nb_shards;
+    for (shard->nb_buckets = 1; shard->nb_buckets < 2 * shard->nb_entries; shard->nb_buckets *= 2)
+      ;
+    shard->entries = calloc(shard->nb_entries, sizeof(cache_entry));
+    shard->buckets = malloc(sizeof(int) * shard->nb_buckets);
+    if (!shard->entries || !shard->buckets)
+    {
+      cache->nb_shards = s + 1;
+      lenet_cache_destroy(cache);
+      return NULL;
+    }
+    for (k = 0; k < shard->nb_buckets; k++)
+      shard->buckets[k] = CACHE_NONE;
+    cache->capacity += shard->nb_entries;
+  }
+
+  return cache;
+}
+
+void lenet_cache_destroy(lenet_cache *cache)
+{
+  int s;
+
+  if (!cache)
+    return;
+  for (s = 0; s < cache->nb_shards; s++)
+  {
+    pthread_mutex_destroy(&cache->shards[s].lock);
+    free(cache->shards[s].entries);
+    free(cache->shards[s].buckets);
+  }
+  free(cache->shards);
+  free(cache);
+}
+
+void lenet_cache_get_stats(lenet_cache *cache, lenet_cache_stats *stats)
+{
+  cache_shard *shard;
+  int s;
+
+  memset(stats, 0, sizeof(lenet_cache_stats));
+  if (!cache)
+    return;
+  stats->capacity = cache->capacity;
+  for (s = 0; s < cache->nb_shards; s++)
+  {
+    shard = &cache->shards[s];
+    pthread_mutex_lock(&shard->lock);
+    stats->hits += shard->hits;
+    stats->misses += shard->misses;
+    stats->evictions += shard->evictions;
+    stats->entries += shard->used;
+    pthread_mutex_unlock(&shard->lock);
+  }
+}
+
+// low bits pick the shard, the next ones the bucket
+static cache_shard *ShardOf(lenet_cache *cache, unsigned long long hash)
+{
+  return &cache->shards[hash & (cache->nb_shards - 1)];
+}
+
+static int BucketOf(cache_shard *shard, unsigned long long hash)
+{
+  return (int)((hash >> 16) & (shard->nb_buckets - 1));
+}
+
+static int FindEntry(cache_shard *shard, unsigned long long hash, const unsigned char *pixels)
+{
+  int e;
+
+  for (e = shard->buckets[BucketOf(shard, hash)]; e != CACHE_NONE; e = shard->entries[e].next)
+    if (shard->entries[e].hash == hash && memcmp(shard->entries[e].pixels, pixels, LENET_PIXELS) == 0)
+      return e;
+  return CACHE_NONE;
+}
+
+static void Unlink(cache_shard *shard, int victim)
+{
+  int *link;
+
+  for (link = &shard->buckets[BucketOf(shard, shard->entries[victim].hash)]; *link != victim;
+       link = &shard->entries[*link].next)
+    ;
+  *link = shard->entries[victim].next;
+}
+
+// 1 and the cached logits on a hit
+int CacheLookup(lenet_cache *cache, unsigned long long hash, const unsigned char *pixels, short logits[FC2_NBOUTPUT])
+{
+  cache_shard *shard = ShardOf(cache, hash);
+  int e;
+
+  pthread_mutex_lock(&shard->lock);
+  e = FindEntry(shard, hash, pixels);
+  if (e != CACHE_NONE)
+  {
+    shard->entries[e].referenced = 1;
+    memcpy(logits, shard->entries[e].logits, sizeof(shard->entries[e].logits));
+    shard->hits++;
+  }
+  else
+    shard->misses++;
+  pthread_mutex_unlock(&shard->lock);
+
+  return e != CACHE_NONE;
+}
+
+void CacheInsert(lenet_cache *cache, unsigned long long hash, const unsigned char *pixels, const short logits[FC2_NBOUTPUT])
+{
+  cache_shard *shard = ShardOf(cache, hash);
+  cache_entry *entry;
+  int e, bucket;
+
+  pthread_mutex_lock(&shard->lock);
+  // another context may have inserted the same image meanwhile
+  if (FindEntry(shard, hash, pixels) != CACHE_NONE)
+  {
+    pthread_mutex_unlock(&shard->lock);
+    return;
+  }
+
+  if (shard->used < shard->nb_entries)
+    e = shard->used++;
+  else
+  {
+    while (shard->entries[shard->hand].referenced)
+    {
+      shard->entries[shard->hand].referenced = 0;
+      shard->hand = (shard->hand + 1) % shard->nb_entries;
+    }
+    e = shard->hand;
+    shard->hand = (shard->hand + 1) % shard->nb_entries;
+    Unlink(shard, e);
+    shard->evictions++;
+  }
+
+  entry = &shard->entries[e];
+  entry->hash = hash;
+  entry->referenced = 0;
+  memcpy(entry->pixels, pixels, LENET_PIXELS);
+  memcpy(entry->logits, logits, sizeof(entry->logits));
+  bucket = BucketOf(shard, hash);
+  entry->next = shard->buckets[bucket];
+  shard->buckets[bucket] = e;
+  pthread_mutex_unlock(&shard->lock);
+}
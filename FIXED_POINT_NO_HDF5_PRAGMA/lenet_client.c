@@ -0,0 +1,272 @@
+/**
+  ******************************************************************************
+  * @file    lenet_client.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Test set client of lenet_server
+  * @brief   usage: ./lenet_client [-u socket] [-t connections] [-w window] [-n max_images] [-s] [-q]
+  *          Each connection thread keeps up to window requests in flight.
+  *          Prints errors, images/s and round trip percentiles, then the server
+  *          statistics. -s only prints the statistics, -q stops the server.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "lenet_cnn_float.h"
+#include "server.h"
+
+#define MAX_CLIENT_CONNS    64
+#define DEFAULT_WINDOW      16
+#define STATS_ID            0xffffffff
+
+typedef struct {
+  char *socket_path;
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char *predicted;
+  double *sent;                 // per image, s
+  double *latency;              // per image, us
+  int nb_images;
+  int window;
+  int thread;
+  int nb_threads;
+} client_job;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-u socket] [-t connections] [-w window] [-n max_images] [-s] [-q]\n", program);
+}
+
+static int Connect(char *path)
+{
+  struct sockaddr_un addr;
+  int fd;
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+  {
+    printf("Error: Unable to connect to %s.\n", path);
+    exit(1);
+  }
+  return fd;
+}
+
+static void WriteAll(int fd, const void *data, size_t size)
+{
+  const unsigned char *p = data;
+  ssize_t done;
+
+  while (size > 0)
+  {
+    done = write(fd, p, size);
+    if (done < 0 && errno == EINTR)
+      continue;
+    if (done <= 0)
+    {
+      printf("Error: Connection to the server lost.\n");
+      exit(1);
+    }
+    p += done;
+    size -= done;
+  }
+}
+
+static void ReadAll(int fd, void *data, size_t size)
+{
+  unsigned char *p = data;
+  ssize_t done;
+
+  while (size > 0)
+  {
+    done = read(fd, p, size);
+    if (done < 0 && errno == EINTR)
+      continue;
+    if (done <= 0)
+    {
+      printf("Error: Connection to the server lost.\n");
+      exit(1);
+    }
+    p += done;
+    size -= done;
+  }
+}
+
+static void SendImage(int fd, client_job *job, int m)
+{
+  unsigned char message[sizeof(srv_header) + LENET_PIXELS];
+  srv_header *header = (srv_header *)message;
+
+  memset(header, 0, sizeof(srv_header));
+  header->type = SRV_INFER;
+  header->id = m;
+  memcpy(message + sizeof(srv_header), job->images[m], LENET_PIXELS);
+  job->sent[m] = TimeNow();
+  WriteAll(fd, message, sizeof(message));
+}
+
+// images thread, thread + nb_threads, ... with up to window of them in flight
+static void *ClientThread(void *arg)
+{
+  client_job *job = arg;
+  srv_reply reply;
+  int fd, next, in_flight;
+
+  fd = Connect(job->socket_path);
+  next = job->thread;
+  in_flight = 0;
+  while (next < job->nb_images || in_flight > 0)
+  {
+    while (next < job->nb_images && in_flight < job->window)
+    {
+      SendImage(fd, job, next);
+      next += job->nb_threads;
+      in_flight++;
+    }
+    ReadAll(fd, &reply, sizeof(reply));
+    // queue of the server full: sent again, still in flight
+    if (reply.status == SRV_EBUSY && reply.id < (uint32_t)job->nb_images)
+    {
+      SendImage(fd, job, reply.id);
+      continue;
+    }
+    if (reply.status != SRV_OK || reply.id >= (uint32_t)job->nb_images)
+    {
+      printf("Error: Bad reply %u from the server.\n", reply.id);
+      exit(1);
+    }
+    job->latency[reply.id] = (TimeNow() - job->sent[reply.id]) * 1000000;
+    job->predicted[reply.id] = reply.label;
+    in_flight--;
+  }
+  close(fd);
+  return NULL;
+}
+
+static void Request(char *path, int type)
+{
+  srv_header header;
+  srv_reply reply;
+  uint32_t len;
+  char *text;
+  int fd;
+
+  fd = Connect(path);
+  memset(&header, 0, sizeof(header));
+  header.type = type;
+  header.id = STATS_ID;
+  WriteAll(fd, &header, sizeof(header));
+  ReadAll(fd, &reply, sizeof(reply));
+  if (type == SRV_STATS)
+  {
+    ReadAll(fd, &len, sizeof(len));
+    text = malloc(len + 1);
+    if (!text)
+    {
+      printf("Error: Unable to allocate %u bytes.\n", len);
+      exit(1);
+    }
+    ReadAll(fd, text, len);
+    text[len] = 0;
+    printf("\nServer statistics:\n%s", text);
+    free(text);
+  }
+  close(fd);
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return x < y ? -1 : x > y;
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES], predicted[NB_TEST_IMAGES];
+  static double sent[NB_TEST_IMAGES], latency[NB_TEST_IMAGES];
+  client_job jobs[MAX_CLIENT_CONNS];
+  pthread_t threads[MAX_CLIENT_CONNS];
+  char *socket_path;
+  unsigned int error;
+  int opt, m, t, nb_threads, window, nb_images, max_images, stats_only, shutdown;
+  double tstart, tdiff;
+
+  socket_path = SRV_DEFAULT_SOCKET;
+  nb_threads = 1;
+  window = DEFAULT_WINDOW;
+  max_images = NB_TEST_IMAGES;
+  stats_only = 0;
+  shutdown = 0;
+  while ((opt = getopt(argc, argv, "u:t:w:n:sqh")) != -1)
+  {
+    switch (opt)
+    {
+    case 'u': socket_path = optarg; break;
+    case 't': nb_threads = atoi(optarg); break;
+    case 'w': window = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    case 's': stats_only = 1; break;
+    case 'q': shutdown = 1; break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_threads < 1 || nb_threads > MAX_CLIENT_CONNS)
+    nb_threads = 1;
+  if (window < 1)
+    window = 1;
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  if (!stats_only)
+  {
+    nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+    tstart = TimeNow();
+    for (t = 0; t < nb_threads; t++)
+    {
+      jobs[t] = (client_job){ socket_path, images, predicted, sent, latency, nb_images, window, t, nb_threads };
+      if (pthread_create(&threads[t], NULL, ClientThread, &jobs[t]) != 0)
+      {
+        printf("Error: Unable to start connection %d.\n", t);
+        exit(1);
+      }
+    }
+    for (t = 0; t < nb_threads; t++)
+      pthread_join(threads[t], NULL);
+    tdiff = TimeNow() - tstart;
+
+    error = 0;
+    for (m = 0; m < nb_images; m++)
+      if (predicted[m] != labels[m])
+        error = error + 1;
+    qsort(latency, nb_images, sizeof(double), CompareDouble);
+
+    printf("\n%d images over %d connections, window %d: %f s, %.1f images/s\n", nb_images, nb_threads, window,
+           tdiff, nb_images / tdiff);
+    printf("Round trip: p50 %.0f us, p90 %.0f us, p99 %.0f us, max %.0f us\n", latency[nb_images / 2],
+           latency[nb_images * 90 / 100], latency[nb_images * 99 / 100], latency[nb_images - 1]);
+    printf("\n\nErrors : %d / %d", error, nb_images);
+    printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+    printf("\n");
+  }
+
+  Request(socket_path, SRV_STATS);
+  if (shutdown)
+    Request(socket_path, SRV_SHUTDOWN);
+  printf("\n");
+
+  return 0;
+}
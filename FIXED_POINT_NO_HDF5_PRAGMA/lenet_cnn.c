@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file    lenet_cnn.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Top level HLS function, shared by the test loop of lenet_cnn_float.c
+  *          and the evaluation tools
+  */
+
+#include <string.h>
+
+#include "lenet_cnn_float.h"
+#include "counters.h"
+#include "trace.h"
+
+// Top Level HLS function
+void lenet_cnn(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], // IN
+               short output[FC2_NBOUTPUT])                            // OUT
+{
+
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+
+  // bare calls unless built with -DLAYER_COUNTERS (counters.h) or -DLENET_TRACE (trace.h)
+  TRACE_BEGIN(TRACE_CONV1);
+  LAYER_COUNT(LAYER_CONV1, Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output));
+  TRACE_END(TRACE_CONV1);
+  TRACE_BEGIN(TRACE_POOL1);
+  LAYER_COUNT(LAYER_POOL1, Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output));
+  TRACE_END(TRACE_POOL1);
+  TRACE_BEGIN(TRACE_CONV2);
+  LAYER_COUNT(LAYER_CONV2, Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output));
+  TRACE_END(TRACE_CONV2);
+  TRACE_BEGIN(TRACE_POOL2);
+  LAYER_COUNT(LAYER_POOL2, Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output));
+  TRACE_END(TRACE_POOL2);
+  TRACE_BEGIN(TRACE_FC1);
+  LAYER_COUNT(LAYER_FC1, Fc1_40_400(pool2_output, FC1_KERNEL, FC1_BIAS, fc1_output));
+  TRACE_END(TRACE_FC1);
+  TRACE_BEGIN(TRACE_FC2);
+  LAYER_COUNT(LAYER_FC2, Fc2_400_10(fc1_output, FC2_KERNEL, FC2_BIAS, output));
+  TRACE_END(TRACE_FC2);
+}
+
+void CopyWeights(lenet_weights *weights)
+{
+  memcpy(weights->conv1_kernel, CONV1_KERNEL, sizeof(CONV1_KERNEL));
+  memcpy(weights->conv2_kernel, CONV2_KERNEL, sizeof(CONV2_KERNEL));
+  memcpy(weights->fc1_kernel, FC1_KERNEL, sizeof(FC1_KERNEL));
+  memcpy(weights->fc2_kernel, FC2_KERNEL, sizeof(FC2_KERNEL));
+  memcpy(weights->conv1_bias, CONV1_BIAS, sizeof(CONV1_BIAS));
+  memcpy(weights->conv2_bias, CONV2_BIAS, sizeof(CONV2_BIAS));
+  memcpy(weights->fc1_bias, FC1_BIAS, sizeof(FC1_BIAS));
+  memcpy(weights->fc2_bias, FC2_BIAS, sizeof(FC2_BIAS));
+}
+
+void lenet_cnn_local_features(lenet_weights *weights,                                 // IN
+                              lenet_scratch *scratch,                                 // IN
+                              unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH])  // IN
+{
+  TRACE_BEGIN(TRACE_CONV1);
+  Conv1_28x28x1_5x5x20_1_0(input, weights->conv1_kernel, weights->conv1_bias, scratch->conv1_output);
+  TRACE_END(TRACE_CONV1);
+  TRACE_BEGIN(TRACE_POOL1);
+  Pool1_24x24x20_2x2x20_2_0(scratch->conv1_output, scratch->pool1_output);
+  TRACE_END(TRACE_POOL1);
+  TRACE_BEGIN(TRACE_CONV2);
+  Conv2_12x12x20_5x5x40_1_0(scratch->pool1_output, weights->conv2_kernel, weights->conv2_bias, scratch->conv2_output);
+  TRACE_END(TRACE_CONV2);
+  TRACE_BEGIN(TRACE_POOL2);
+  Pool2_8x8x40_2x2x40_2_0(scratch->conv2_output, scratch->pool2_output);
+  TRACE_END(TRACE_POOL2);
+}
+
+void lenet_cnn_local(lenet_weights *weights,                                 // IN
+                     lenet_scratch *scratch,                                 // IN
+                     unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                     short output[FC2_NBOUTPUT])                             // OUT
+{
+  lenet_cnn_local_features(weights, scratch, input);
+  TRACE_BEGIN(TRACE_FC1);
+  Fc1_40_400(scratch->pool2_output, weights->fc1_kernel, weights->fc1_bias, scratch->fc1_output);
+  TRACE_END(TRACE_FC1);
+  TRACE_BEGIN(TRACE_FC2);
+  Fc2_400_10(scratch->fc1_output, weights->fc2_kernel, weights->fc2_bias, output);
+  TRACE_END(TRACE_FC2);
+}
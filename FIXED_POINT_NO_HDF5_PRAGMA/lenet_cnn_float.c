@@ -19,31 +19,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <unistd.h>
 
 // Xilinx time measurement
 //#include "sds_lib.h"
 
 #include "lenet_cnn_float.h"
-#include "weights.h"
+#include "lat_hist.h"
+#include "trace.h"
+#include "results.h"
 
-// Top Level HLS function
-void lenet_cnn(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], // IN
-               short output[FC2_NBOUTPUT])                            // OUT
-{
-
-  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
-  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
-  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
-  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
-  short fc1_output[FC1_NBOUTPUT];
-
-  Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output);
-  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
-  Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
-  Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
-  Fc1_40_400(pool2_output, FC1_KERNEL, FC1_BIAS, fc1_output);
-  Fc2_400_10(fc1_output, FC2_KERNEL, FC2_BIAS, output);
-}
+#define DEFAULT_PROGRESS    1.0     // s between progress lines in quiet mode
 
 // GLOBAL VARIABLES
 unsigned char REF_IMG[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
@@ -51,12 +37,23 @@ unsigned char INPUT_NORM[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
 short FC2_OUTPUT[FC2_NBOUTPUT];
 float SOFTMAX_OUTPUT[FC2_NBOUTPUT];
 
+// per-image latency of each phase and of the whole image (ns)
+lat_hist IO_HIST, PREPROCESS_HIST, INFERENCE_HIST, SOFTMAX_HIST, IMAGE_HIST;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-q] [-o results.csv] [-b] [-p seconds]\n", program);
+}
+
 /**
   ******************************************************************************
   * @brief   main code deploying a LeNet inference CNN on MNIST dataset
+  * @brief   -q: no per-image output, progress on stderr every -p seconds
+  *          (default 1, 0 for none). -o: prediction, logits and latency of
+  *          every image written at the end as CSV, or binary with -b (results.h).
   */
 
-int main()
+int main(int argc, char *argv[])
 {
   short k, m;
   char *test_labels_filename = "mnist/t10k-labels-idx1-ubyte";
@@ -66,13 +63,39 @@ int main()
   unsigned int error;
   unsigned char labels_legend[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
   char img_filename[120];
-  char img_count[10];
   float max;
   struct timeval start, end;
-  double tdiff, tmin, tmax, tavg;
+  double tdiff;
+  unsigned long long tread, tnorm, tinfer, tsoftmax, tend;
   unsigned long long xilinx_start, xilinx_end, xilinx_time, xilinx_time_max, xilinx_time_min, xilinx_time_avg;
+  char *results_filename;
+  double progress_interval;
+  int opt, quiet, binary;
+  result_log *log;
+  result_record *record;
+  result_progress *progress;
+
+  quiet = 0;
+  binary = 0;
+  results_filename = NULL;
+  progress_interval = DEFAULT_PROGRESS;
+  while ((opt = getopt(argc, argv, "qo:bp:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'q': quiet = 1; break;
+    case 'o': results_filename = optarg; break;
+    case 'b': binary = 1; break;
+    case 'p': progress_interval = atof(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  log = results_filename ? ResultsCreate() : NULL;
 
-  printf("\e[1;1H\e[2J");
+  if (!quiet)
+    printf("\e[1;1H\e[2J");
 
   printf("\nOpening labels file \n");
   label_file = fopen(test_labels_filename, "r");
@@ -87,13 +110,16 @@ int main()
 
   printf("\nProcessing \n");
   m = 0;                 // test image counter
-  tavg = 0;              // average processing time (us)
   xilinx_time_avg = 0;   // Xilinx average processing time (cpu cycles)
-  tmin = 1000000;        // minimum processing time (us)
-  tmax = 0;              // maximum processing time (us)
   xilinx_time_min = 1e9; // Xilinx minimum processing time (cpu cycles)
   xilinx_time_max = 0;   // Xilinx maximum processing time (cpu cycles)
   error = 0;             // number of mispredictions
+  HistReset(&IO_HIST);
+  HistReset(&PREPROCESS_HIST);
+  HistReset(&INFERENCE_HIST);
+  HistReset(&SOFTMAX_HIST);
+  HistReset(&IMAGE_HIST);
+  progress = quiet && progress_interval > 0 ? ProgressStart(progress_interval) : NULL;
 
   // MAIN TEST LOOP
   gettimeofday(&start, NULL);
@@ -105,40 +131,50 @@ int main()
     if (feof(label_file))
       break;
 
-    strcpy(img_filename, "mnist/t10k-images-idx3-ubyte[");
-    //    strcpy(img_filename, "mnist/train-images-idx3-ubyte[");
-    sprintf(img_count, "%d", m);
-    if (m < 10)
-      strcat(img_filename, "0000");
-    else if (m < 100)
-      strcat(img_filename, "000");
-    else if (m < 1000)
-      strcat(img_filename, "00");
-    else if (m < 10000)
-      strcat(img_filename, "0");
-    strcat(img_filename, img_count);
-    strcat(img_filename, "].pgm");
-
-    /* */printf("\033[%d;%dH%s\n", 7, 0, img_filename);
+    MakeImgFilename(img_filename, m);
+
+    if (!quiet)
+      /* */printf("\033[%d;%dH%s\n", 7, 0, img_filename);
 
+    tread = HistNow();
+    TRACE_BEGIN(TRACE_LOAD);
     ReadPgmFile(img_filename, (unsigned char *)REF_IMG);
+    TRACE_END(TRACE_LOAD);
 
+    tnorm = HistNow();
+    TRACE_BEGIN(TRACE_NORMALIZE);
     NormalizeImg((unsigned char *)REF_IMG, (unsigned char *)INPUT_NORM, IMG_WIDTH, IMG_WIDTH);
+    TRACE_END(TRACE_NORMALIZE);
 
     // xilinx_start = sds_clock_counter();
 
     // main cnn function with reduced parameters (result of hdf5 removal)
+    tinfer = HistNow();
     lenet_cnn(INPUT_NORM, FC2_OUTPUT);
 
     // xilinx_end = sds_clock_counter();
 
+    tsoftmax = HistNow();
+    TRACE_BEGIN(TRACE_SOFTMAX);
     Softmax(FC2_OUTPUT, SOFTMAX_OUTPUT);
-    /* */ printf("\n\nSoftmax output: \n"); 
+    TRACE_END(TRACE_SOFTMAX);
+    tend = HistNow();
+
+    // the console output is left out of the phases
+    HistRecord(&IO_HIST, tnorm - tread);
+    HistRecord(&PREPROCESS_HIST, tinfer - tnorm);
+    HistRecord(&INFERENCE_HIST, tsoftmax - tinfer);
+    HistRecord(&SOFTMAX_HIST, tend - tsoftmax);
+    HistRecord(&IMAGE_HIST, tend - tread);
+
+    if (!quiet)
+      /* */ printf("\n\nSoftmax output: \n");
     max = 0;
     number = 0;
     for (k = 0; k < FC2_NBOUTPUT; k++)
     {
-      /* */ printf("%.2f%% ", SOFTMAX_OUTPUT[k] * 100);
+      if (!quiet)
+        /* */ printf("%.2f%% ", SOFTMAX_OUTPUT[k] * 100);
       if (SOFTMAX_OUTPUT[k] > max)
       {
         max = SOFTMAX_OUTPUT[k];
@@ -146,10 +182,23 @@ int main()
       }
     }
 
-    /* */ printf("\n\nPredicted: %d \t Actual: %d\n", labels_legend[number], label);
+    if (!quiet)
+      /* */ printf("\n\nPredicted: %d \t Actual: %d\n", labels_legend[number], label);
     if (labels_legend[number] != label)
       error = error + 1;
 
+    if (log)
+    {
+      record = ResultsNext(log);
+      record->latency = tend - tread;
+      for (k = 0; k < FC2_NBOUTPUT; k++)
+        record->logits[k] = FC2_OUTPUT[k];
+      record->label = label;
+      record->predicted = labels_legend[number];
+    }
+    if (progress)
+      ProgressUpdate(progress, m + 1, error);
+
     //xilinx_time = xilinx_end - xilinx_start;
 
     if (xilinx_time < xilinx_time_min)
@@ -162,10 +211,20 @@ int main()
 
   } // END MAIN TEST LOOP
   gettimeofday(&end, NULL);
+  if (progress)
+    ProgressStop(progress);
 
   tdiff = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec) / 1000000;
   printf("TOTAL PROCESSING TIME (gettimeofday): %f s\n", tdiff);
 
+  printf("\n");
+  HistPrintHeader("Latency (us)");
+  HistPrint("I/O", &IO_HIST);
+  HistPrint("preprocessing", &PREPROCESS_HIST);
+  HistPrint("inference", &INFERENCE_HIST);
+  HistPrint("softmax", &SOFTMAX_HIST);
+  HistPrint("image", &IMAGE_HIST);
+
   printf("\n\nErrors : %d / %d", error, m);
   printf("\n\nSuccess rate = %f%%", (1 - ((float)error / m)) * 100);
 
@@ -173,6 +232,13 @@ int main()
 
   printf("\n\n");
 
+  if (log)
+  {
+    ResultsWrite(log, results_filename, binary);
+    printf("%d results written to %s\n\n", m, results_filename);
+    ResultsDestroy(log);
+  }
+
   fclose(label_file);
 
   return 0;
@@ -46,11 +46,28 @@
 #define FC2_NBOUTPUT	10
 #define FIXED_POINT		8
 
+#define NB_TEST_IMAGES	10000
+#define BASELINE_ERRORS	201     // reference fixed point result on the 10k test set (97.98%)
+
+// Weights and biases, defined once in weights.c (weights.h)
+extern short CONV1_KERNEL[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM];
+extern short CONV2_KERNEL[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+extern short FC1_KERNEL[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+extern short FC2_KERNEL[FC2_NBOUTPUT][FC1_NBOUTPUT];
+extern short CONV1_BIAS[CONV1_NBOUTPUT];
+extern short CONV2_BIAS[CONV2_NBOUTPUT];
+extern short FC1_BIAS[FC1_NBOUTPUT];
+extern short FC2_BIAS[FC2_NBOUTPUT];
+
 void ReadPgmFile(char *filename, unsigned char *pix); 
 void WritePgmFile(char *filename, float *pix, short width, short height); 
 void ReadTestLabels(char *filename, short size); 
 void RescaleImg(unsigned char *input, short width,short height, float *output, short new_width, short new_height); 
 void NormalizeImg(unsigned char *input, unsigned char *output, short width, short height);  
+void MakeImgFilename(char *img_filename, int m); 
+int ReadLabels(char *labels_filename, unsigned char *labels, int max_labels); 
+int LoadTestSet(char *labels_filename, unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], unsigned char *labels, int max_images); 
+double TimeNow(void); 
 
 void Conv1_28x28x1_5x5x20_1_0(	unsigned char	input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], 	                // IN
 				                short 		    kernel[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM], 	// IN
@@ -79,5 +96,138 @@ void Fc2_400_10(	short 	input[FC1_NBOUTPUT], 			        // IN
 			        short 	bias[FC2_NBOUTPUT],			            // IN
 			        short 	output[FC2_NBOUTPUT]); 			        // OUT
 
-void Softmax(short vector_in[FC2_NBOUTPUT], float vector_out[FC2_NBOUTPUT]); 
-
+void Softmax(short vector_in[FC2_NBOUTPUT], float vector_out[FC2_NBOUTPUT]);
+unsigned char ClassifySoftmax(float vector_in[FC2_NBOUTPUT]); 
+
+// Top Level HLS function (lenet_cnn.c)
+void lenet_cnn(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+               short output[FC2_NBOUTPUT]);                            // OUT
+
+// Prediction cache of liblenet (lenet_cache.c, lenet.h)
+struct lenet_cache;
+unsigned long long CacheHash(const unsigned char *pixels);
+int CacheLookup(struct lenet_cache *cache, unsigned long long hash, const unsigned char *pixels,  // IN
+                short logits[FC2_NBOUTPUT]);                                                      // OUT
+void CacheInsert(struct lenet_cache *cache, unsigned long long hash, const unsigned char *pixels, // IN
+                 const short logits[FC2_NBOUTPUT]);                                               // IN
+
+// copy of every weight and bias, so that threads can read a replica local to their memory node
+typedef struct {
+  short conv1_kernel[CONV1_NBOUTPUT][IMG_DEPTH][CONV1_DIM][CONV1_DIM];
+  short conv2_kernel[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+  short fc1_kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc2_kernel[FC2_NBOUTPUT][FC1_NBOUTPUT];
+  short conv1_bias[CONV1_NBOUTPUT];
+  short conv2_bias[CONV2_NBOUTPUT];
+  short fc1_bias[FC1_NBOUTPUT];
+  short fc2_bias[FC2_NBOUTPUT];
+} lenet_weights;
+
+// activations of one inference, kept off the stack so that they can live in a core local arena
+typedef struct {
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+} lenet_scratch;
+
+void CopyWeights(lenet_weights *weights);   // OUT, from the weights.h arrays
+
+// lenet_cnn with caller provided weights and activation buffers
+void lenet_cnn_local(lenet_weights *weights,                                 // IN
+                     lenet_scratch *scratch,                                 // IN
+                     unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                     short output[FC2_NBOUTPUT]);                            // OUT
+
+// its Conv1 to Pool2 part, the input of FC1 in scratch->pool2_output
+void lenet_cnn_local_features(lenet_weights *weights,                                 // IN
+                              lenet_scratch *scratch,                                 // IN
+                              unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH]); // IN
+
+
+// Multiplier-free FC1 / Conv2 variants (quant.c)
+// ternary: 2-bit codes {0, +1, -1} packed 4 per byte, one scale per neuron applied after accumulation
+// pow2:    4-bit codes sign|exponent packed 2 per byte, weight = +/- 2^(code&7 - 1), code 0 = zero
+#define FC1_NBINPUT             (POOL2_NBOUTPUT*POOL2_HEIGHT*POOL2_WIDTH)   // 640
+#define FC1_TERNARY_BYTES       (FC1_NBINPUT/4)                             // 160 bytes per neuron
+#define FC1_POW2_BYTES          (FC1_NBINPUT/2)                             // 320 bytes per neuron
+#define CONV2_NBINPUT           (POOL1_NBOUTPUT*CONV2_DIM*CONV2_DIM)        // 500
+#define CONV2_POW2_BYTES        ((CONV2_NBINPUT+1)/2)                       // 250 bytes per filter
+#define POW2_MAX_EXP            6
+
+void QuantizeFc1Ternary(short           kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        unsigned char   packed[FC1_NBOUTPUT][FC1_TERNARY_BYTES],                            // OUT
+                        short           scale[FC1_NBOUTPUT]);                                               // OUT
+
+void QuantizeFc1Pow2(   short           kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        unsigned char   packed[FC1_NBOUTPUT][FC1_POW2_BYTES]);                              // OUT
+
+void QuantizeConv2Pow2( short           kernel[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM],      // IN
+                        unsigned char   packed[CONV2_NBOUTPUT][CONV2_POW2_BYTES]);                          // OUT
+
+void Fc1_40_400_ternary(short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        unsigned char   kernel[FC1_NBOUTPUT][FC1_TERNARY_BYTES],            // IN
+                        short           scale[FC1_NBOUTPUT],                                // IN
+                        short           bias[FC1_NBOUTPUT],                                 // IN
+                        short           output[FC1_NBOUTPUT]);                              // OUT
+
+void Fc1_40_400_pow2(   short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        unsigned char   kernel[FC1_NBOUTPUT][FC1_POW2_BYTES],               // IN
+                        short           bias[FC1_NBOUTPUT],                                 // IN
+                        short           output[FC1_NBOUTPUT]);                              // OUT
+
+void Conv2_12x12x20_5x5x40_1_0_pow2(short           input[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH],  // IN
+                                    unsigned char   kernel[CONV2_NBOUTPUT][CONV2_POW2_BYTES],           // IN
+                                    short           bias[CONV2_NBOUTPUT],                               // IN
+                                    short           output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH]); // OUT
+
+// Compressed sparse row FC1 (sparse.c), 2 bytes per kept weight
+// row_ptr[o]..row_ptr[o+1]-1 index the entries of neuron o: int8 weight and uint8 column delta,
+// the column in the flattened [POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH] input starts at 0 and
+// advances by the delta of each entry; gaps over 255 get zero weight entries of delta 255
+#define FC1_MAX_NNZ             (FC1_NBOUTPUT*FC1_NBINPUT)                  // 256000
+#define FC1_MAX_ENTRIES         (FC1_MAX_NNZ + FC1_NBOUTPUT*(FC1_NBINPUT/255 + 1))
+
+unsigned int PruneFc1(  short           kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        short           threshold,                                                          // IN
+                        unsigned int    row_ptr[FC1_NBOUTPUT+1],                                            // OUT
+                        unsigned char   col_delta[FC1_MAX_ENTRIES],                                         // OUT
+                        signed char     values[FC1_MAX_ENTRIES]);                                           // OUT
+
+void Fc1_40_400_csr(    short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        unsigned int    row_ptr[FC1_NBOUTPUT+1],                            // IN
+                        unsigned char   col_delta[FC1_MAX_ENTRIES],                         // IN
+                        signed char     values[FC1_MAX_ENTRIES],                            // IN
+                        short           bias[FC1_NBOUTPUT],                                 // IN
+                        short           output[FC1_NBOUTPUT]);                              // OUT
+
+// Early exit head on the Pool2 features (exit_head.c)
+#define EXIT_HEAD_FILE          "exit_head.txt"                             // written by lenet_keras_20_40.py
+#define EXIT_DEFAULT_THRESHOLD  0.999
+
+void BuildExitHead(     short           fc1_kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        short           fc1_bias[FC1_NBOUTPUT],                                             // IN
+                        short           fc2_kernel[FC2_NBOUTPUT][FC1_NBOUTPUT],                             // IN
+                        short           fc2_bias[FC2_NBOUTPUT],                                             // IN
+                        short           exit_kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // OUT
+                        short           exit_bias[FC2_NBOUTPUT]);                                           // OUT
+
+int LoadExitHead(       char            *filename,                                                          // IN
+                        short           exit_kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // OUT
+                        short           exit_bias[FC2_NBOUTPUT]);                                           // OUT
+
+void ExitHead_40_10(    short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],                   // IN
+                        short           kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],    // IN
+                        short           bias[FC2_NBOUTPUT],                                                 // IN
+                        short           output[FC2_NBOUTPUT]);                                              // OUT
+
+float ExitConfidence(   short           logits[FC2_NBOUTPUT],                                               // IN
+                        unsigned char   *number);                                                           // OUT
+
+unsigned char EarlyExitRun(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],                           // IN
+                        short           exit_kernel[FC2_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        short           exit_bias[FC2_NBOUTPUT],                                            // IN
+                        float           threshold,                                                          // IN
+                        short           output[FC2_NBOUTPUT],                                               // OUT
+                        int             *exited);                                                           // OUT
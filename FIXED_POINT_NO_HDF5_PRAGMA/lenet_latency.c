@@ -0,0 +1,132 @@
+/**
+  ******************************************************************************
+  * @file    lenet_latency.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Single image latency: serial lenet_cnn against the thread team of latency.c
+  * @brief   usage: ./lenet_latency [-j threads] [-s spin] [-n max_images]
+  *          images are classified one at a time, latency percentiles are reported
+  *          for both modes and every team output is checked against the serial one
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "workers.h"
+#include "latency.h"
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-j threads] [-s spin] [-n max_images]\n", program);
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+// sorts latency in place
+static void PrintPercentiles(char *name, double *latency, int nb_images, unsigned int error)
+{
+  qsort(latency, nb_images, sizeof(double), CompareDouble);
+  printf("%-8s %9.1f %9.1f %9.1f %9.1f %8u / %-5d\n", name, latency[nb_images / 2], latency[nb_images * 90 / 100],
+         latency[nb_images * 99 / 100], latency[nb_images - 1], error, nb_images);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  double *serial_latency, *team_latency;
+  short serial_output[FC2_NBOUTPUT], team_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  team_worker_stats stats[MAX_WORKERS];
+  lenet_team *team;
+  unsigned int serial_error, team_error, mismatch;
+  int opt, m, w, nb_threads, spin, nb_images, max_images;
+  double tstart;
+
+  nb_threads = DefaultWorkers();
+  spin = DEFAULT_SPIN;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "j:s:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j': nb_threads = atoi(optarg); break;
+    case 's': spin = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_threads < 1 || nb_threads > MAX_WORKERS)
+    nb_threads = DefaultWorkers();
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  images = malloc(sizeof(*images) * max_images);
+  serial_latency = malloc(sizeof(double) * max_images);
+  team_latency = malloc(sizeof(double) * max_images);
+  if (!images || !serial_latency || !team_latency)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  team = TeamCreate(nb_threads, spin);
+
+  serial_error = 0;
+  team_error = 0;
+  mismatch = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    tstart = TimeNow();
+    lenet_cnn(images[m], serial_output);
+    serial_latency[m] = (TimeNow() - tstart) * 1000000;
+
+    tstart = TimeNow();
+    lenet_cnn_team(team, images[m], team_output);
+    team_latency[m] = (TimeNow() - tstart) * 1000000;
+
+    if (memcmp(serial_output, team_output, sizeof(team_output)))
+      mismatch++;
+    Softmax(serial_output, softmax_output);
+    if (ClassifySoftmax(softmax_output) != labels[m])
+      serial_error++;
+    Softmax(team_output, softmax_output);
+    if (ClassifySoftmax(softmax_output) != labels[m])
+      team_error++;
+  }
+
+  printf("\n%d images, team of %d threads, %d polls before parking\n\n", nb_images, nb_threads, spin);
+  printf("%-8s %9s %9s %9s %9s %14s\n", "mode", "p50 (us)", "p90 (us)", "p99 (us)", "max (us)", "errors");
+  PrintPercentiles("serial", serial_latency, nb_images, serial_error);
+  PrintPercentiles("team", team_latency, nb_images, team_error);
+
+  TeamStats(team, stats);
+  printf("\n%6s %10s %10s\n", "worker", "images", "parks");
+  for (w = 0; w < nb_threads; w++)
+    printf("%6d %10llu %10llu\n", w, stats[w].images, stats[w].parks);
+
+  if (mismatch)
+    printf("\nWarning: team and serial outputs differ on %u images\n", mismatch);
+  printf("\n");
+
+  TeamDestroy(team);
+  free(team_latency);
+  free(serial_latency);
+  free(images);
+
+  return mismatch ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+/**
+  ******************************************************************************
+  * @file    lenet_parallel.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Multi-threaded version of the test loop of lenet_cnn_float.c
+  * @brief   usage: ./lenet_parallel [-j threads] [-g grain] [-t] [-n max_images]
+  *          Images are read, normalized and classified by a work-stealing pool
+  *          (workers.c) with per-worker buffers in place of REF_IMG, INPUT_NORM,
+  *          FC2_OUTPUT and SOFTMAX_OUTPUT. Predictions and latencies are stored
+  *          per image and reduced in image order after the pool has finished, so
+  *          the error count does not depend on the number of threads.
+  *          -t pins the workers along the cache topology (topology.c), allocates
+  *          their buffers in a first-touched arena and gives them the weight
+  *          replica of their NUMA node; ./lenet_parallel -T prints the placement.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "workers.h"
+#include "topology.h"
+#include "trace.h"
+
+#define DEFAULT_GRAIN   16
+
+#define ARENA_SIZE      (1 << 20)   // per worker, rounded to pages by mmap
+
+// buffers of one worker, the global variables of the serial test loop
+typedef struct {
+  unsigned char ref_img[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char input_norm[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  char img_filename[120];
+  lenet_scratch scratch;
+  lenet_weights *weights;
+} __attribute__((aligned(CACHE_LINE))) eval_buffers;
+
+typedef struct {
+  eval_buffers *buffers[MAX_WORKERS];   // one per worker
+  topo_arena *arenas[MAX_WORKERS];      // with -t, where the buffers live
+  int cpus[MAX_WORKERS];                // with -t, cpu of each worker, -1 when not pinned
+  cpu_topology *topology;               // NULL without -t
+  unsigned char *predicted;             // one per image
+  double *latency;                      // one per image (us)
+} eval_job;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-j threads] [-g grain] [-t] [-n max_images]\n", program);
+  printf("       %s -T prints the cpu topology and the worker placement\n", program);
+}
+
+// with -t: pin, then allocate and touch the buffers from the pinned thread
+static void PlaceWorkerBuffers(void *arg, int worker)
+{
+  eval_job *job = arg;
+  cpu_info *info;
+
+  info = PlaceWorker(job->topology, worker);
+  job->cpus[worker] = PinThread(info->cpu) == 0 ? info->cpu : -1;
+
+  job->arenas[worker] = ArenaCreate(ARENA_SIZE);
+  if (!job->arenas[worker])
+  {
+    printf("Error: Unable to allocate the arena of worker %d.\n", worker);
+    exit(1);
+  }
+  job->buffers[worker] = ArenaAlloc(job->arenas[worker], sizeof(eval_buffers));
+  job->buffers[worker]->weights = NodeWeights(info->node);
+}
+
+static void EvalImages(void *arg, int worker, int begin, int end)
+{
+  eval_job *job = arg;
+  eval_buffers *buf = job->buffers[worker];
+  double tstart;
+  int m;
+
+  for (m = begin; m < end; m++)
+  {
+    tstart = TimeNow();
+
+    TRACE_BEGIN(TRACE_LOAD);
+    MakeImgFilename(buf->img_filename, m);
+    ReadPgmFile(buf->img_filename, (unsigned char *)buf->ref_img);
+    TRACE_END(TRACE_LOAD);
+    TRACE_BEGIN(TRACE_NORMALIZE);
+    NormalizeImg((unsigned char *)buf->ref_img, (unsigned char *)buf->input_norm, IMG_WIDTH, IMG_WIDTH);
+    TRACE_END(TRACE_NORMALIZE);
+
+    lenet_cnn_local(buf->weights, &buf->scratch, buf->input_norm, buf->fc2_output);
+
+    TRACE_BEGIN(TRACE_SOFTMAX);
+    Softmax(buf->fc2_output, buf->softmax_output);
+    job->predicted[m] = ClassifySoftmax(buf->softmax_output);
+    TRACE_END(TRACE_SOFTMAX);
+
+    job->latency[m] = (TimeNow() - tstart) * 1000000;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char labels[NB_TEST_IMAGES];
+  unsigned char predicted[NB_TEST_IMAGES];
+  double latency[NB_TEST_IMAGES];
+  ws_worker_stats stats[MAX_WORKERS];
+  static eval_job job;
+  static cpu_topology topology;
+  eval_buffers *shared_buffers;
+  lenet_weights *shared_weights;
+  unsigned int error;
+  int opt, m, w, nb_threads, grain, placed, nb_images, max_images;
+  double tstart, tdiff, tmin, tmax, tavg;
+
+  nb_threads = DefaultWorkers();
+  grain = DEFAULT_GRAIN;
+  placed = 0;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "j:g:tTn:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j': nb_threads = atoi(optarg); break;
+    case 'g': grain = atoi(optarg); break;
+    case 't': placed = 1; break;
+    case 'T':
+      ReadTopology(&topology);
+      PrintTopology(&topology);
+      return 0;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_threads < 1 || nb_threads > MAX_WORKERS)
+    nb_threads = DefaultWorkers();
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  // without -t, buffers side by side and a single copy of the weights
+  shared_buffers = NULL;
+  shared_weights = NULL;
+  if (placed)
+  {
+    ReadTopology(&topology);
+    job.topology = &topology;
+  }
+  else
+  {
+    shared_buffers = aligned_alloc(CACHE_LINE, sizeof(eval_buffers) * nb_threads);
+    shared_weights = malloc(sizeof(lenet_weights));
+    if (!shared_buffers || !shared_weights)
+    {
+      printf("Error: Unable to allocate %d workers.\n", nb_threads);
+      exit(1);
+    }
+    CopyWeights(shared_weights);
+    for (w = 0; w < nb_threads; w++)
+    {
+      job.buffers[w] = &shared_buffers[w];
+      job.buffers[w]->weights = shared_weights;
+    }
+  }
+  job.predicted = predicted;
+  job.latency = latency;
+
+  nb_images = ReadLabels("mnist/t10k-labels-idx1-ubyte", labels, max_images);
+
+  printf("\nProcessing %d images on %d threads (grain %d%s)\n", nb_images, nb_threads, grain,
+         placed ? ", topology placement" : "");
+  tstart = TimeNow();
+  RunWorkStealing(nb_threads, nb_images, grain, placed ? PlaceWorkerBuffers : NULL, EvalImages, &job, stats);
+  tdiff = TimeNow() - tstart;
+
+  // in image order, independent of which worker processed which image
+  error = 0;
+  tavg = 0;
+  tmin = 1000000;
+  tmax = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    if (predicted[m] != labels[m])
+      error = error + 1;
+    tavg += latency[m];
+    if (latency[m] < tmin)
+      tmin = latency[m];
+    if (latency[m] > tmax)
+      tmax = latency[m];
+  }
+  tavg /= nb_images;
+
+  printf("TOTAL PROCESSING TIME: %f s, %.1f images/s\n", tdiff, nb_images / tdiff);
+  printf("\n%6s %8s %8s %8s %5s %5s\n", "worker", "images", "chunks", "steals", "cpu", "node");
+  for (w = 0; w < nb_threads; w++)
+  {
+    printf("%6d %8u %8u %8u", w, stats[w].items, stats[w].chunks, stats[w].steals);
+    if (placed && job.buffers[w])
+      printf(" %5d %5d\n", job.cpus[w], PlaceWorker(&topology, w)->node);
+    else
+      printf(" %5s %5s\n", "-", "-");
+  }
+
+  printf("\nLatency per image: min %.1f us, avg %.1f us, max %.1f us", tmin, tavg, tmax);
+  printf("\n\nErrors : %d / %d", error, nb_images);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+  printf("\n\n");
+
+  for (w = 0; w < nb_threads; w++)
+    ArenaDestroy(job.arenas[w]);
+  FreeNodeWeights();
+  free(shared_weights);
+  free(shared_buffers);
+
+  return 0;
+}
@@ -0,0 +1,118 @@
+/**
+  ******************************************************************************
+  * @file    lenet_pipeline.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Throughput and per stage counters of the layer pipeline (pipeline.c)
+  * @brief   usage: ./lenet_pipeline [-d depth] [-b bound] [-p] [-n max_images]
+  *          -p pins every stage thread on its own core; predictions are checked
+  *          against the serial loop
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "pipeline.h"
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-d depth] [-b bound] [-p] [-n max_images]\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  unsigned char predicted[NB_TEST_IMAGES], serial_predicted[NB_TEST_IMAGES];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  stage_stats stats[NB_STAGES];
+  unsigned int error, mismatch;
+  int opt, m, s, depth, bound, pin, slowest, nb_images, max_images;
+  double tstart, tserial, tpipeline, per_item;
+
+  depth = DEFAULT_DEPTH;
+  bound = DEFAULT_BOUND;
+  pin = 0;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "d:b:pn:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'd': depth = atoi(optarg); break;
+    case 'b': bound = atoi(optarg); break;
+    case 'p': pin = 1; break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  images = malloc(sizeof(*images) * max_images);
+  if (!images)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  tstart = TimeNow();
+  for (m = 0; m < nb_images; m++)
+  {
+    lenet_cnn(images[m], fc2_output);
+    Softmax(fc2_output, softmax_output);
+    serial_predicted[m] = ClassifySoftmax(softmax_output);
+  }
+  tserial = TimeNow() - tstart;
+
+  tstart = TimeNow();
+  RunPipeline(images, nb_images, depth, bound, pin, predicted, stats);
+  tpipeline = TimeNow() - tstart;
+
+  error = 0;
+  mismatch = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    if (predicted[m] != labels[m])
+      error++;
+    if (predicted[m] != serial_predicted[m])
+      mismatch++;
+  }
+
+  // occupancy: share of the wall time a stage spends computing, waiting upstream or downstream
+  slowest = 0;
+  printf("\n%d frames in flight, %d frames queued per stage at most%s\n\n", depth, bound, pin ? ", pinned" : "");
+  printf("%-6s %8s %10s %6s %8s %8s %10s\n", "stage", "images", "us/image", "busy", "starved", "stalled", "avg queue");
+  for (s = 0; s < NB_STAGES; s++)
+  {
+    per_item = stats[s].busy / stats[s].items;
+    if (per_item > stats[slowest].busy / stats[slowest].items)
+      slowest = s;
+    printf("%-6s %8llu %10.2f %5.1f%% %7.1f%% %7.1f%% %10.2f\n", STAGE_NAMES[s], stats[s].items, per_item * 1000000,
+           stats[s].busy * 100 / tpipeline, stats[s].starved * 100 / tpipeline, stats[s].stalled * 100 / tpipeline,
+           stats[s].queue_sum / stats[s].items);
+  }
+
+  printf("\nSlowest stage %s: at most %.1f images/s with one core per stage\n", STAGE_NAMES[slowest],
+         stats[slowest].items / stats[slowest].busy);
+  printf("serial   %10.1f images/s\n", nb_images / tserial);
+  printf("pipeline %10.1f images/s\n", nb_images / tpipeline);
+  if (mismatch)
+    printf("Warning: pipeline and serial predictions differ on %u images\n", mismatch);
+
+  printf("\n\nErrors : %d / %d", error, nb_images);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+  printf("\n\n");
+
+  free(images);
+
+  return mismatch ? 1 : 0;
+}
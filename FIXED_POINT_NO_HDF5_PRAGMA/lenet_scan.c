@@ -0,0 +1,226 @@
+/**
+  ******************************************************************************
+  * @file    lenet_scan.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Dense digit scanning of a large image with the fully convolutional mode (scan.h)
+  * @brief   usage: ./lenet_scan [-i image.pgm] [-x columns] [-y rows] [-t threshold] [-c]
+  *          Scans a binary PGM of any size, or by default a canvas of
+  *          columns x rows test images tiled side by side: the window of each
+  *          tile is then in the score map, and the tiles are classified from
+  *          it against their labels. Prints the map of the windows classified
+  *          with a softmax probability above the threshold (default 0.99).
+  *          -c also runs lenet_cnn on the crop of every window, checks that
+  *          the scores are bit-exact and compares the times.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "scan.h"
+
+#define DEFAULT_COLUMNS     8
+#define DEFAULT_ROWS        4
+#define DEFAULT_THRESHOLD   0.99
+#define MAX_MAP_PRINT       160     // widest map printed
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-i image.pgm] [-x columns] [-y rows] [-t threshold] [-c]\n", program);
+}
+
+// binary (P5) PGM of any size
+static unsigned char *ReadPgmImage(char *filename, int *width, int *height)
+{
+  FILE *pgm_file;
+  unsigned char *pix;
+  char magic[3];
+  int max;
+
+  pgm_file = fopen(filename, "rb");
+  if (!pgm_file)
+  {
+    printf("Error: Unable to open file %s.\n", filename);
+    exit(1);
+  }
+  if (fscanf(pgm_file, "%2s %d %d %d", magic, width, height, &max) != 4 || strcmp(magic, "P5") || max > 255 ||
+      *width <= 0 || *height <= 0)
+  {
+    printf("Error: %s is not an 8-bit binary PGM file.\n", filename);
+    exit(1);
+  }
+  fgetc(pgm_file);
+  pix = malloc((size_t)*width * *height);
+  if (!pix || fread(pix, 1, (size_t)*width * *height, pgm_file) != (size_t)*width * *height)
+  {
+    printf("Error: Unable to read %dx%d pixels from %s.\n", *width, *height, filename);
+    exit(1);
+  }
+  fclose(pgm_file);
+  return pix;
+}
+
+// softmax of the FC2 output of window k of the score map
+static unsigned char ClassifyWindow(short *scores, int map_size, int k, float *probability)
+{
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  unsigned char number;
+  int c;
+
+  for (c = 0; c < FC2_NBOUTPUT; c++)
+    fc2_output[c] = scores[c * map_size + k];
+  Softmax(fc2_output, softmax_output);
+  number = ClassifySoftmax(softmax_output);
+  *probability = softmax_output[number];
+  return number;
+}
+
+// lenet_cnn on the crop of every window, returns the number of windows whose scores differ
+static int CheckWindows(unsigned char *image, int width, short *scores, int map_width, int map_height)
+{
+  unsigned char crop[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  short fc2_output[FC2_NBOUTPUT];
+  int x, y, r, c, mismatch, map_size;
+
+  map_size = map_width * map_height;
+  mismatch = 0;
+  for (y = 0; y < map_height; y++)
+    for (x = 0; x < map_width; x++)
+    {
+      for (r = 0; r < IMG_HEIGHT; r++)
+        memcpy(crop[0][r], image + (SCAN_STRIDE * y + r) * width + SCAN_STRIDE * x, IMG_WIDTH);
+      lenet_cnn(crop, fc2_output);
+      for (c = 0; c < FC2_NBOUTPUT; c++)
+        if (fc2_output[c] != scores[c * map_size + y * map_width + x])
+          break;
+      if (c < FC2_NBOUTPUT)
+        mismatch++;
+    }
+  return mismatch;
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char tiles[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES];
+  unsigned char *image;
+  short *scores;
+  char *image_filename;
+  lenet_scan *scan;
+  float probability, threshold;
+  double tstart, tscan, twindows;
+  unsigned int error;
+  int opt, check, columns, rows, width, height, map_width, map_height, map_size, nb_tiles, x, y, r, t, mismatch;
+  unsigned char number;
+
+  image_filename = NULL;
+  columns = DEFAULT_COLUMNS;
+  rows = DEFAULT_ROWS;
+  threshold = DEFAULT_THRESHOLD;
+  check = 0;
+  while ((opt = getopt(argc, argv, "i:x:y:t:ch")) != -1)
+  {
+    switch (opt)
+    {
+    case 'i': image_filename = optarg; break;
+    case 'x': columns = atoi(optarg); break;
+    case 'y': rows = atoi(optarg); break;
+    case 't': threshold = atof(optarg); break;
+    case 'c': check = 1; break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (columns < 1)
+    columns = DEFAULT_COLUMNS;
+  if (rows < 1)
+    rows = DEFAULT_ROWS;
+  if (columns * rows > NB_TEST_IMAGES)
+    rows = NB_TEST_IMAGES / columns;
+
+  nb_tiles = 0;
+  if (image_filename)
+    image = ReadPgmImage(image_filename, &width, &height);
+  else
+  {
+    // test images side by side, IMG_WIDTH is a multiple of SCAN_STRIDE
+    nb_tiles = LoadTestSet("mnist/t10k-labels-idx1-ubyte", tiles, labels, columns * rows);
+    width = columns * IMG_WIDTH;
+    height = rows * IMG_HEIGHT;
+    image = calloc((size_t)width * height, 1);
+    if (!image)
+    {
+      printf("Error: Unable to allocate the %dx%d canvas.\n", width, height);
+      exit(1);
+    }
+    for (t = 0; t < nb_tiles; t++)
+      for (r = 0; r < IMG_HEIGHT; r++)
+        memcpy(image + ((t / columns) * IMG_HEIGHT + r) * width + (t % columns) * IMG_WIDTH, tiles[t][0][r], IMG_WIDTH);
+  }
+
+  scan = ScanCreate(width, height);
+  ScanMapSize(scan, &map_width, &map_height);
+  map_size = map_width * map_height;
+  scores = malloc(sizeof(short) * FC2_NBOUTPUT * map_size);
+  if (!scores)
+  {
+    printf("Error: Unable to allocate the score map.\n");
+    exit(1);
+  }
+
+  tstart = TimeNow();
+  lenet_cnn_scan(scan, image, scores);
+  tscan = TimeNow() - tstart;
+  printf("\n%dx%d image: %dx%d windows at stride %d, dense scan %.2f ms (%.1f us per window)\n\n", width, height,
+         map_width, map_height, SCAN_STRIDE, tscan * 1000, tscan * 1000000 / map_size);
+
+  if (map_width <= MAX_MAP_PRINT)
+  {
+    for (y = 0; y < map_height; y++)
+    {
+      for (x = 0; x < map_width; x++)
+      {
+        number = ClassifyWindow(scores, map_size, y * map_width + x, &probability);
+        putchar(probability >= threshold ? '0' + number : '.');
+      }
+      putchar('\n');
+    }
+    printf("(class of the windows with a probability >= %.3f)\n", threshold);
+  }
+
+  if (check)
+  {
+    tstart = TimeNow();
+    mismatch = CheckWindows(image, width, scores, map_width, map_height);
+    twindows = TimeNow() - tstart;
+    printf("\nlenet_cnn per window %.2f ms, dense scan %.2f ms: %.1fx, %d / %d windows differ\n", twindows * 1000,
+           tscan * 1000, twindows / tscan, mismatch, map_size);
+  }
+
+  if (nb_tiles)
+  {
+    // window of tile t at (IMG_WIDTH / SCAN_STRIDE) * (column, row)
+    error = 0;
+    for (t = 0; t < nb_tiles; t++)
+    {
+      x = (t % columns) * (IMG_WIDTH / SCAN_STRIDE);
+      y = (t / columns) * (IMG_HEIGHT / SCAN_STRIDE);
+      if (ClassifyWindow(scores, map_size, y * map_width + x, &probability) != labels[t])
+        error = error + 1;
+    }
+    printf("\n\nErrors : %d / %d", error, nb_tiles);
+    printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_tiles)) * 100);
+  }
+  printf("\n\n");
+
+  ScanDestroy(scan);
+  free(scores);
+  free(image);
+  return 0;
+}
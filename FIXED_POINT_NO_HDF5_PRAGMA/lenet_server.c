@@ -0,0 +1,810 @@
+/**
+  ******************************************************************************
+  * @file    lenet_server.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Inference daemon: the model is loaded once, images arrive over a
+  *          Unix domain socket (server.h) and are classified in batches
+  * @brief   usage: ./lenet_server [-u socket] [-b max_batch] [-d max_wait_us] [-j workers]
+  *                               [-r ring_name] [-s ring_slots] [-E] [-C cache_entries]
+  *          The main thread polls the connections and queues complete requests.
+  *          A worker takes the queue as soon as it holds max_batch requests or
+  *          the oldest one has waited max_wait_us, runs lenet_infer_batch on its
+  *          own lenet_ctx and writes the replies. Neither blocks on a client:
+  *          the sockets are non-blocking, replies the socket does not take are
+  *          kept in a buffer of the connection and flushed by the poll loop,
+  *          and a connection with more than OUTPUT_LIMIT bytes pending is
+  *          closed. A request arriving on a full queue is answered SRV_EBUSY.
+  *          Queue depth, batch sizes and
+  *          request latency (queued to replied) are answered to SRV_STATS and
+  *          printed on exit (SIGINT, SIGTERM or SRV_SHUTDOWN).
+  *          -r also serves a shared memory ring (shm_ring.h) from a thread of
+  *          its own: batches of submitted slots are classified in place, up to
+  *          max_batch and without waiting for a deadline. -E skips the
+  *          inference on the ring, to measure the transport alone.
+  *          -C shares a prediction cache (lenet_cache_create) between all the
+  *          workers, so that repeated images skip the network.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "lenet_cnn_float.h"
+#include "server.h"
+#include "shm_ring.h"
+
+#define MAX_CONNS           64
+#define MAX_SRV_WORKERS     16
+#define QUEUE_SLOTS         4096
+#define POLL_TIMEOUT        200     // ms, how often the stop flag is checked
+#define STATS_TEXT          4096
+#define OUTPUT_LIMIT        (256 << 10)     // bytes of replies pending before a connection is dropped
+#define FIRST_CONN          2               // fds[0] listens, fds[1] is the wake-up pipe
+
+#define HIST_BUCKETS        80      // 4 buckets per octave of microseconds
+#define HIST_PER_OCTAVE     4
+#define DEPTH_BUCKETS       14      // powers of two of queued requests
+#define CACHE_SHARDS        16
+
+// one client; freed when the poll loop and every queued request have released it
+typedef struct {
+  int fd;
+  atomic_int refs;
+  pthread_mutex_t write_lock;             // output buffer and closed
+  unsigned char *output;                  // replies not taken by the socket yet
+  int output_used, output_size;
+  int closed;                             // by the peer, the poll loop or for falling behind
+  unsigned char buffer[sizeof(srv_header) + LENET_PIXELS];
+  int used;
+} srv_conn;
+
+typedef struct {
+  srv_conn *conn;
+  uint32_t id;
+  double arrival;
+  unsigned char pixels[LENET_PIXELS];
+} srv_request;
+
+typedef struct {
+  unsigned long long requests;
+  unsigned long long busy_replies;          // SRV_EBUSY, queue full
+  unsigned long long batches;
+  unsigned long long deadline_batches;      // sent before being full
+  unsigned long long batch_sizes[SRV_MAX_BATCH + 1];
+  unsigned long long depth[DEPTH_BUCKETS];  // queue depth seen by each new request
+  unsigned int max_depth;
+  unsigned long long latency[HIST_BUCKETS];
+  double busy;                              // s spent in lenet_infer_batch
+  unsigned long long ring_images;
+  unsigned long long ring_batches;
+  double ring_busy;
+} srv_stats;
+
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t not_empty;
+  srv_request *slots;
+  int head, count;
+  int max_batch;
+  double max_wait;                          // s
+  int running;
+  const lenet_model *model;
+  lenet_cache *cache;                       // NULL without -C
+  srv_stats stats;
+  double start;
+} srv_queue;
+
+typedef struct {
+  srv_queue *queue;
+  shm_ring ring;
+  int echo;                                 // -E, no inference
+} srv_ring;
+
+static volatile sig_atomic_t STOP;
+static int WAKE[2];                         // written when a connection gets pending output
+static atomic_ullong DROPPED;
+
+static const double percentiles[] = { 50, 90, 99, 99.9 };
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-u socket] [-b max_batch] [-d max_wait_us] [-j workers] [-r ring_name] [-s ring_slots] [-E] [-C cache_entries]\n", program);
+}
+
+static void OnSignal(int sig)
+{
+  (void)sig;
+  STOP = 1;
+}
+
+static int LatencyBucket(double us)
+{
+  int bucket;
+
+  if (us < 1)
+    return 0;
+  bucket = (int)(log2(us) * HIST_PER_OCTAVE);
+  return bucket >= HIST_BUCKETS ? HIST_BUCKETS - 1 : bucket;
+}
+
+// upper bound of a bucket in microseconds
+static double BucketLimit(int bucket)
+{
+  return pow(2, (double)(bucket + 1) / HIST_PER_OCTAVE);
+}
+
+static void ReleaseConn(srv_conn *conn)
+{
+  if (atomic_fetch_sub(&conn->refs, 1) != 1)
+    return;
+  close(conn->fd);
+  pthread_mutex_destroy(&conn->write_lock);
+  free(conn->output);
+  free(conn);
+}
+
+// as much of the output as the socket takes without blocking; write_lock held
+static void Flush(srv_conn *conn)
+{
+  ssize_t sent;
+  int done;
+
+  done = 0;
+  while (done < conn->output_used)
+  {
+    sent = send(conn->fd, conn->output + done, conn->output_used - done, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (sent < 0 && errno == EINTR)
+      continue;
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      break;
+    if (sent <= 0)
+    {
+      // closed by the peer, the poll loop sees it too
+      conn->closed = 1;
+      conn->output_used = 0;
+      return;
+    }
+    done += sent;
+  }
+  memmove(conn->output, conn->output + done, conn->output_used - done);
+  conn->output_used -= done;
+}
+
+// queues a message of the connection and sends what the socket takes; a client
+// that leaves more than OUTPUT_LIMIT bytes unread is shut down, never waited for
+static void Reply(srv_conn *conn, const void *data, int size)
+{
+  unsigned char *output;
+  int pending, wake, new_size;
+
+  pthread_mutex_lock(&conn->write_lock);
+  pending = conn->output_used;
+  if (!conn->closed && conn->output_used + size > conn->output_size && conn->output_used + size <= OUTPUT_LIMIT)
+  {
+    new_size = conn->output_size ? conn->output_size : 4096;
+    while (new_size < conn->output_used + size)
+      new_size *= 2;
+    output = realloc(conn->output, new_size);
+    if (output)
+    {
+      conn->output = output;
+      conn->output_size = new_size;
+    }
+  }
+  if (!conn->closed && conn->output_used + size > conn->output_size)
+  {
+    conn->closed = 1;
+    conn->output_used = 0;
+    shutdown(conn->fd, SHUT_RDWR);
+    atomic_fetch_add(&DROPPED, 1);
+  }
+  if (!conn->closed)
+  {
+    memcpy(conn->output + conn->output_used, data, size);
+    conn->output_used += size;
+    Flush(conn);
+  }
+  wake = !pending && conn->output_used;
+  pthread_mutex_unlock(&conn->write_lock);
+
+  // the poll loop adds POLLOUT for it
+  if (wake && write(WAKE[1], "", 1) < 0 && errno != EAGAIN)
+    printf("Warning: Unable to wake the poll loop.\n");
+}
+
+// printf at text + *len, cut at the end of text[size] and *len kept within it
+static void __attribute__((format(printf, 4, 5))) Append(char *text, int size, int *len, const char *format, ...)
+{
+  va_list args;
+  int n;
+
+  if (*len >= size - 1)
+    return;
+  va_start(args, format);
+  n = vsnprintf(text + *len, size - *len, format, args);
+  va_end(args);
+  if (n > 0)
+    *len = *len + n < size - 1 ? *len + n : size - 1;
+}
+
+static int FormatStats(srv_queue *queue, char *text, int size)
+{
+  lenet_cache_stats cache_stats;
+  srv_stats stats;
+  unsigned long long count, total, target;
+  int len, k, p, depth;
+
+  pthread_mutex_lock(&queue->lock);
+  stats = queue->stats;
+  depth = queue->count;
+  pthread_mutex_unlock(&queue->lock);
+
+  len = 0;
+  Append(text, size, &len, "uptime %.1f s, %llu requests, %llu batches (%llu on deadline), inference busy %.1f%%\n",
+         TimeNow() - queue->start, stats.requests, stats.batches, stats.deadline_batches,
+         stats.busy * 100 / (TimeNow() - queue->start));
+  if (stats.busy_replies || atomic_load(&DROPPED))
+    Append(text, size, &len, "overload: %llu requests answered busy, %llu connections dropped for unread replies\n",
+           stats.busy_replies, (unsigned long long)atomic_load(&DROPPED));
+  Append(text, size, &len, "queue depth: now %d, max %u, seen by new requests:", depth, stats.max_depth);
+  for (k = 0; k < DEPTH_BUCKETS; k++)
+    if (stats.depth[k])
+      Append(text, size, &len, " <%d:%llu", 1 << k, stats.depth[k]);
+  Append(text, size, &len, "\nbatch sizes:");
+  for (k = 1; k <= SRV_MAX_BATCH; k++)
+    if (stats.batch_sizes[k])
+      Append(text, size, &len, " %d:%llu", k, stats.batch_sizes[k]);
+  Append(text, size, &len, "\nlatency (queued to replied), upper bounds:");
+  // requests are counted when queued, the histogram when replied
+  total = 0;
+  for (k = 0; k < HIST_BUCKETS; k++)
+    total += stats.latency[k];
+  count = 0;
+  k = 0;
+  for (p = 0; p < (int)(sizeof(percentiles) / sizeof(percentiles[0])); p++)
+  {
+    target = (unsigned long long)ceil(total * percentiles[p] / 100);
+    while (k < HIST_BUCKETS - 1 && count + stats.latency[k] < target)
+      count += stats.latency[k++];
+    Append(text, size, &len, " p%g %.0f us", percentiles[p], BucketLimit(k));
+  }
+  Append(text, size, &len, "\n");
+  if (stats.ring_batches)
+    Append(text, size, &len, "ring: %llu images, %llu batches (%.1f images per batch), inference busy %.1f%%\n",
+           stats.ring_images, stats.ring_batches, (double)stats.ring_images / stats.ring_batches,
+           stats.ring_busy * 100 / (TimeNow() - queue->start));
+  if (queue->cache)
+  {
+    lenet_cache_get_stats(queue->cache, &cache_stats);
+    Append(text, size, &len, "cache: %llu hits, %llu misses, %llu evictions, %d / %d entries\n",
+           cache_stats.hits, cache_stats.misses, cache_stats.evictions, cache_stats.entries, cache_stats.capacity);
+  }
+
+  return len;
+}
+
+// CLOCK_MONOTONIC deadline for pthread_cond_timedwait
+static struct timespec Deadline(double t)
+{
+  struct timespec ts;
+
+  ts.tv_sec = (time_t)t;
+  ts.tv_nsec = (long)((t - ts.tv_sec) * 1000000000);
+  return ts;
+}
+
+// full batch, or whatever is queued once the oldest request has waited max_wait
+static int TakeBatch(srv_queue *queue, srv_request batch[])
+{
+  struct timespec deadline;
+  int n, k, timed_out;
+
+  pthread_mutex_lock(&queue->lock);
+  while (queue->count == 0 && queue->running)
+    pthread_cond_wait(&queue->not_empty, &queue->lock);
+
+  timed_out = 0;
+  while (queue->count > 0 && queue->count < queue->max_batch && queue->running)
+  {
+    deadline = Deadline(queue->slots[queue->head].arrival + queue->max_wait);
+    if (pthread_cond_timedwait(&queue->not_empty, &queue->lock, &deadline) == ETIMEDOUT)
+    {
+      timed_out = 1;
+      break;
+    }
+  }
+
+  n = queue->count < queue->max_batch ? queue->count : queue->max_batch;
+  for (k = 0; k < n; k++)
+  {
+    batch[k] = queue->slots[queue->head];
+    queue->head = (queue->head + 1) % QUEUE_SLOTS;
+  }
+  queue->count -= n;
+  if (n)
+  {
+    queue->stats.batches++;
+    queue->stats.batch_sizes[n]++;
+    if (timed_out)
+      queue->stats.deadline_batches++;
+  }
+  pthread_mutex_unlock(&queue->lock);
+
+  return n;
+}
+
+static void *WorkerThread(void *arg)
+{
+  srv_queue *queue = arg;
+  srv_request *batch;
+  unsigned char *pixels;
+  lenet_result *results;
+  srv_reply *replies;
+  lenet_ctx *ctx;
+  int n, k, first, r;
+  double tstart, tend, treplied;
+  unsigned long long latency[HIST_BUCKETS];
+
+  ctx = lenet_ctx_create(queue->model);
+  lenet_ctx_set_cache(ctx, queue->cache);
+  batch = malloc(sizeof(srv_request) * queue->max_batch);
+  pixels = malloc(LENET_PIXELS * queue->max_batch);
+  results = malloc(sizeof(lenet_result) * queue->max_batch);
+  replies = malloc(sizeof(srv_reply) * queue->max_batch);
+  if (!ctx || !batch || !pixels || !results || !replies)
+  {
+    printf("Error: Unable to allocate a worker.\n");
+    exit(1);
+  }
+
+  while ((n = TakeBatch(queue, batch)) > 0)
+  {
+    for (k = 0; k < n; k++)
+      memcpy(pixels + k * LENET_PIXELS, batch[k].pixels, LENET_PIXELS);
+
+    tstart = TimeNow();
+    lenet_infer_batch(ctx, pixels, n, results);
+    tend = TimeNow();
+
+    // one send per run of requests from the same connection
+    memset(latency, 0, sizeof(latency));
+    for (first = 0; first < n; first = k)
+    {
+      for (k = first; k < n && batch[k].conn == batch[first].conn; k++)
+      {
+        r = k - first;
+        replies[r].id = batch[k].id;
+        replies[r].status = SRV_OK;
+        replies[r].label = results[k].label;
+        replies[r].reserved[0] = replies[r].reserved[1] = 0;
+        memcpy(replies[r].logits, results[k].logits, sizeof(replies[r].logits));
+      }
+      Reply(batch[first].conn, replies, sizeof(srv_reply) * (k - first));
+    }
+    treplied = TimeNow();
+    for (k = 0; k < n; k++)
+    {
+      latency[LatencyBucket((treplied - batch[k].arrival) * 1000000)]++;
+      ReleaseConn(batch[k].conn);
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    queue->stats.busy += tend - tstart;
+    for (k = 0; k < HIST_BUCKETS; k++)
+      queue->stats.latency[k] += latency[k];
+    pthread_mutex_unlock(&queue->lock);
+  }
+
+  lenet_ctx_destroy(ctx);
+  free(batch);
+  free(pixels);
+  free(results);
+  free(replies);
+  return NULL;
+}
+
+// the ring is drained in slot order, batches cut at max_batch and at the end of the ring
+static void *RingThread(void *arg)
+{
+  srv_ring *ring = arg;
+  ring_header *header = ring->ring.header;
+  lenet_ctx *ctx;
+  uint32_t head, done, mask;
+  int n, images, batches, spin;
+  double tstart, busy;
+
+  ctx = lenet_ctx_create(ring->queue->model);
+  if (!ctx)
+  {
+    printf("Error: Unable to allocate the ring worker.\n");
+    exit(1);
+  }
+  lenet_ctx_set_cache(ctx, ring->queue->cache);
+  mask = header->nb_slots - 1;
+  done = atomic_load(&header->done.value);
+  spin = RingSpin();
+
+  while (!STOP)
+  {
+    head = RingWait(&header->head, done, spin, POLL_TIMEOUT);
+    if (head == done)
+      continue;
+
+    images = 0;
+    batches = 0;
+    tstart = TimeNow();
+    while (done != head)
+    {
+      n = head - done;
+      if (n > ring->queue->max_batch)
+        n = ring->queue->max_batch;
+      if (n > (int)(header->nb_slots - (done & mask)))
+        n = header->nb_slots - (done & mask);
+      if (!ring->echo)
+        lenet_infer_batch(ctx, ring->ring.pixels[done & mask], n, &ring->ring.results[done & mask]);
+      done += n;
+      RingPost(&header->done, done);
+      images += n;
+      batches++;
+    }
+    busy = TimeNow() - tstart;
+
+    pthread_mutex_lock(&ring->queue->lock);
+    ring->queue->stats.ring_images += images;
+    ring->queue->stats.ring_batches += batches;
+    ring->queue->stats.ring_busy += busy;
+    pthread_mutex_unlock(&ring->queue->lock);
+  }
+
+  // wakes a producer waiting for results
+  atomic_store(&header->stop, 1);
+  RingPost(&header->done, done);
+  lenet_ctx_destroy(ctx);
+  return NULL;
+}
+
+// 0 when the queue is full: the poll loop never waits for the workers
+static int Enqueue(srv_queue *queue, srv_conn *conn, uint32_t id, unsigned char *pixels)
+{
+  srv_request *slot;
+  int k;
+
+  pthread_mutex_lock(&queue->lock);
+  if (queue->count == QUEUE_SLOTS)
+  {
+    queue->stats.busy_replies++;
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+  }
+
+  for (k = 0; k < DEPTH_BUCKETS - 1 && queue->count >= (1 << k); k++)
+    ;
+  queue->stats.depth[k]++;
+  if ((unsigned int)queue->count + 1 > queue->stats.max_depth)
+    queue->stats.max_depth = queue->count + 1;
+  queue->stats.requests++;
+
+  slot = &queue->slots[(queue->head + queue->count) % QUEUE_SLOTS];
+  atomic_fetch_add(&conn->refs, 1);
+  slot->conn = conn;
+  slot->id = id;
+  slot->arrival = TimeNow();
+  memcpy(slot->pixels, pixels, LENET_PIXELS);
+  queue->count++;
+
+  pthread_cond_signal(&queue->not_empty);
+  pthread_mutex_unlock(&queue->lock);
+  return 1;
+}
+
+// complete messages of the buffer; 0 when the connection must be closed
+static int HandleMessage(srv_queue *queue, srv_conn *conn)
+{
+  srv_header *header = (srv_header *)conn->buffer;
+  srv_reply reply;
+  unsigned char message[sizeof(srv_reply) + sizeof(uint32_t) + STATS_TEXT];
+  uint32_t len;
+
+  memset(&reply, 0, sizeof(reply));
+  reply.id = header->id;
+  switch (header->type)
+  {
+  case SRV_INFER:
+    if (Enqueue(queue, conn, header->id, conn->buffer + sizeof(srv_header)))
+      return 1;
+    reply.status = SRV_EBUSY;
+    Reply(conn, &reply, sizeof(reply));
+    return 1;
+  case SRV_STATS:
+    // one message, so that no worker reply comes in between
+    len = FormatStats(queue, (char *)message + sizeof(reply) + sizeof(len), STATS_TEXT);
+    memcpy(message, &reply, sizeof(reply));
+    memcpy(message + sizeof(reply), &len, sizeof(len));
+    Reply(conn, message, sizeof(reply) + sizeof(len) + len);
+    return 1;
+  case SRV_SHUTDOWN:
+    Reply(conn, &reply, sizeof(reply));
+    STOP = 1;
+    return 1;
+  default:
+    reply.status = SRV_EBADREQ;
+    Reply(conn, &reply, sizeof(reply));
+    return 0;
+  }
+}
+
+static int MessageSize(srv_conn *conn)
+{
+  if (conn->used < (int)sizeof(srv_header))
+    return sizeof(srv_header);
+  return ((srv_header *)conn->buffer)->type == SRV_INFER ? sizeof(srv_header) + LENET_PIXELS : sizeof(srv_header);
+}
+
+// 0 when the peer has closed the connection
+static int ReadConn(srv_queue *queue, srv_conn *conn)
+{
+  ssize_t got;
+  int need;
+
+  need = MessageSize(conn);
+  got = read(conn->fd, conn->buffer + conn->used, need - conn->used);
+  if (got < 0 && (errno == EINTR || errno == EAGAIN))
+    return 1;
+  if (got <= 0)
+    return 0;
+  conn->used += got;
+
+  if (conn->used == (int)sizeof(srv_header))
+    need = MessageSize(conn);
+  if (conn->used < need)
+    return 1;
+  conn->used = 0;
+  return HandleMessage(queue, conn);
+}
+
+static int OpenSocket(char *path)
+{
+  struct sockaddr_un addr;
+  int fd;
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0 || strlen(path) >= sizeof(addr.sun_path))
+  {
+    printf("Error: Unable to create socket %s.\n", path);
+    exit(1);
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  unlink(path);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, MAX_CONNS) < 0)
+  {
+    printf("Error: Unable to listen on %s.\n", path);
+    exit(1);
+  }
+  return fd;
+}
+
+// last flush without waiting, replies of queued requests dropped from now on
+static void CloseConn(struct pollfd fds[], srv_conn *conns[], int *nb_fds, int k)
+{
+  pthread_mutex_lock(&conns[k]->write_lock);
+  if (!conns[k]->closed)
+    Flush(conns[k]);
+  conns[k]->closed = 1;
+  pthread_mutex_unlock(&conns[k]->write_lock);
+  // queued requests keep the connection alive until replied
+  ReleaseConn(conns[k]);
+  fds[k] = fds[*nb_fds - 1];
+  conns[k] = conns[*nb_fds - 1];
+  (*nb_fds)--;
+}
+
+int main(int argc, char *argv[])
+{
+  static srv_queue queue;
+  static srv_ring ring;
+  pthread_t workers[MAX_SRV_WORKERS], ring_thread;
+  pthread_condattr_t attr;
+  struct pollfd fds[MAX_CONNS + FIRST_CONN];
+  srv_conn *conns[MAX_CONNS + FIRST_CONN];
+  char *socket_path, *ring_name, text[STATS_TEXT], drain[64];
+  lenet_model *model;
+  int opt, nb_workers, nb_fds, fd, k, w, ring_slots, cache_entries, closed;
+
+  socket_path = SRV_DEFAULT_SOCKET;
+  queue.max_batch = SRV_DEFAULT_BATCH;
+  queue.max_wait = SRV_DEFAULT_WAIT / 1000000.0;
+  nb_workers = 1;
+  ring_name = NULL;
+  ring_slots = RING_DEFAULT_SLOTS;
+  cache_entries = 0;
+  while ((opt = getopt(argc, argv, "u:b:d:j:r:s:EC:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'u': socket_path = optarg; break;
+    case 'b': queue.max_batch = atoi(optarg); break;
+    case 'd': queue.max_wait = atof(optarg) / 1000000; break;
+    case 'j': nb_workers = atoi(optarg); break;
+    case 'r': ring_name = optarg; break;
+    case 's': ring_slots = atoi(optarg); break;
+    case 'E': ring.echo = 1; break;
+    case 'C': cache_entries = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (queue.max_batch < 1 || queue.max_batch > SRV_MAX_BATCH)
+    queue.max_batch = SRV_DEFAULT_BATCH;
+  if (nb_workers < 1 || nb_workers > MAX_SRV_WORKERS)
+    nb_workers = 1;
+
+  model = lenet_model_create();
+  queue.slots = malloc(sizeof(srv_request) * QUEUE_SLOTS);
+  if (!model || !queue.slots)
+  {
+    printf("Error: Unable to load the model.\n");
+    exit(1);
+  }
+  queue.model = model;
+  if (cache_entries > 0)
+  {
+    queue.cache = lenet_cache_create(cache_entries, CACHE_SHARDS);
+    if (!queue.cache)
+    {
+      printf("Error: Unable to allocate a cache of %d entries.\n", cache_entries);
+      exit(1);
+    }
+  }
+  queue.running = 1;
+  queue.start = TimeNow();
+  pthread_mutex_init(&queue.lock, NULL);
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&queue.not_empty, &attr);
+  if (pipe(WAKE) < 0 || fcntl(WAKE[0], F_SETFL, O_NONBLOCK) < 0 || fcntl(WAKE[1], F_SETFL, O_NONBLOCK) < 0)
+  {
+    printf("Error: Unable to create the wake-up pipe.\n");
+    exit(1);
+  }
+
+  signal(SIGINT, OnSignal);
+  signal(SIGTERM, OnSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  for (w = 0; w < nb_workers; w++)
+    if (pthread_create(&workers[w], NULL, WorkerThread, &queue) != 0)
+    {
+      printf("Error: Unable to start worker %d.\n", w);
+      exit(1);
+    }
+
+  if (ring_name)
+  {
+    if (RingCreate(&ring.ring, ring_name, ring_slots) < 0)
+    {
+      printf("Error: Unable to create ring %s of %d slots (power of two).\n", ring_name, ring_slots);
+      exit(1);
+    }
+    ring.queue = &queue;
+    if (pthread_create(&ring_thread, NULL, RingThread, &ring) != 0)
+    {
+      printf("Error: Unable to start the ring worker.\n");
+      exit(1);
+    }
+    printf("Serving ring %s (%d slots%s)\n", ring_name, ring_slots, ring.echo ? ", no inference" : "");
+  }
+
+  fds[0].fd = OpenSocket(socket_path);
+  fds[0].events = POLLIN;
+  fds[1].fd = WAKE[0];
+  fds[1].events = POLLIN;
+  nb_fds = FIRST_CONN;
+  printf("Listening on %s (batch %d, wait %.0f us, %d workers)\n", socket_path, queue.max_batch,
+         queue.max_wait * 1000000, nb_workers);
+  fflush(stdout);
+
+  while (!STOP)
+  {
+    // connections with pending replies are also polled for output
+    for (k = nb_fds - 1; k >= FIRST_CONN; k--)
+    {
+      pthread_mutex_lock(&conns[k]->write_lock);
+      closed = conns[k]->closed;
+      fds[k].events = conns[k]->output_used ? POLLIN | POLLOUT : POLLIN;
+      pthread_mutex_unlock(&conns[k]->write_lock);
+      if (closed)
+        CloseConn(fds, conns, &nb_fds, k);
+    }
+
+    if (poll(fds, nb_fds, POLL_TIMEOUT) <= 0)
+      continue;
+    if (fds[1].revents & POLLIN)
+      while (read(WAKE[0], drain, sizeof(drain)) > 0)
+        ;
+
+    for (k = nb_fds - 1; k >= FIRST_CONN; k--)
+    {
+      if (fds[k].revents & POLLOUT)
+      {
+        pthread_mutex_lock(&conns[k]->write_lock);
+        Flush(conns[k]);
+        pthread_mutex_unlock(&conns[k]->write_lock);
+      }
+      if (!(fds[k].revents & (POLLIN | POLLHUP | POLLERR)) || ReadConn(&queue, conns[k]))
+        continue;
+      CloseConn(fds, conns, &nb_fds, k);
+    }
+
+    if (fds[0].revents & POLLIN)
+    {
+      fd = accept(fds[0].fd, NULL, NULL);
+      if (fd < 0)
+        continue;
+      if (nb_fds == MAX_CONNS + FIRST_CONN || fcntl(fd, F_SETFL, O_NONBLOCK) < 0)
+      {
+        close(fd);
+        continue;
+      }
+      conns[nb_fds] = calloc(1, sizeof(srv_conn));
+      if (!conns[nb_fds])
+      {
+        close(fd);
+        continue;
+      }
+      conns[nb_fds]->fd = fd;
+      atomic_init(&conns[nb_fds]->refs, 1);
+      pthread_mutex_init(&conns[nb_fds]->write_lock, NULL);
+      fds[nb_fds].fd = fd;
+      fds[nb_fds].events = POLLIN;
+      nb_fds++;
+    }
+  }
+
+  // workers drain the queue before leaving
+  pthread_mutex_lock(&queue.lock);
+  queue.running = 0;
+  pthread_cond_broadcast(&queue.not_empty);
+  pthread_mutex_unlock(&queue.lock);
+  for (w = 0; w < nb_workers; w++)
+    pthread_join(workers[w], NULL);
+  if (ring_name)
+  {
+    pthread_join(ring_thread, NULL);
+    RingDetach(&ring.ring);
+    shm_unlink(ring_name);
+  }
+
+  while (nb_fds > FIRST_CONN)
+    CloseConn(fds, conns, &nb_fds, nb_fds - 1);
+  close(fds[0].fd);
+  close(WAKE[0]);
+  close(WAKE[1]);
+  unlink(socket_path);
+
+  FormatStats(&queue, text, sizeof(text));
+  printf("\n%s\n", text);
+
+  free(queue.slots);
+  lenet_cache_destroy(queue.cache);
+  lenet_model_destroy(model);
+
+  return 0;
+}
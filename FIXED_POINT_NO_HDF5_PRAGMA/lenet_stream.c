@@ -0,0 +1,160 @@
+/**
+  ******************************************************************************
+  * @file    lenet_stream.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Incremental inference of a simulated camera feed of a digit display (stream.h)
+  * @brief   usage: ./lenet_stream [-f frames] [-s size] [-g glitch] [-d digit] [-r seed]
+  *          The feed shows one test image at a time and switches to the next
+  *          one with probability digit per frame (default 0.01). Between
+  *          switches, a frame shows with probability glitch (default 0.5) a
+  *          size x size patch of noise (default 4) at a random place, so that
+  *          consecutive frames are identical or differ by one or two small
+  *          patches. Every frame goes through lenet_cnn_stream and lenet_cnn:
+  *          prints the frames whose outputs differ, the recomputed work and
+  *          the time per frame by size of the change.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "stream.h"
+
+#define DEFAULT_FRAMES      2000
+#define DEFAULT_SIZE        4
+#define DEFAULT_GLITCH      0.5
+#define DEFAULT_DIGIT       0.01
+#define NB_FEED_IMAGES      100
+#define NB_BUCKETS          5
+
+// upper bounds of the changed pixels of each bucket
+static const int bucket_max[NB_BUCKETS] = {0, 16, 64, 256, IMG_HEIGHT * IMG_WIDTH};
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-f frames] [-s size] [-g glitch] [-d digit] [-r seed]\n", program);
+}
+
+static double Random01(void)
+{
+  return (double)rand() / ((double)RAND_MAX + 1);
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char digits[NB_FEED_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_FEED_IMAGES];
+  unsigned char frame[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  short stream_output[FC2_NBOUTPUT], full_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  double bucket_stream[NB_BUCKETS], bucket_full[NB_BUCKETS];
+  double tstart, tstream, tfull, digit, glitch;
+  unsigned int bucket_frames[NB_BUCKETS];
+  unsigned int error;
+  lenet_stream *stream;
+  stream_stats stats;
+  int opt, frames, size, seed, nb_digits, current, f, b, x0, y0, y, changed, mismatch, low;
+
+  frames = DEFAULT_FRAMES;
+  size = DEFAULT_SIZE;
+  glitch = DEFAULT_GLITCH;
+  digit = DEFAULT_DIGIT;
+  seed = 1;
+  while ((opt = getopt(argc, argv, "f:s:g:d:r:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'f': frames = atoi(optarg); break;
+    case 's': size = atoi(optarg); break;
+    case 'g': glitch = atof(optarg); break;
+    case 'd': digit = atof(optarg); break;
+    case 'r': seed = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (frames < 1)
+    frames = DEFAULT_FRAMES;
+  if (size < 1 || size > IMG_WIDTH)
+    size = DEFAULT_SIZE;
+  srand(seed);
+
+  nb_digits = LoadTestSet("mnist/t10k-labels-idx1-ubyte", digits, labels, NB_FEED_IMAGES);
+  stream = StreamCreate();
+  memset(bucket_stream, 0, sizeof(bucket_stream));
+  memset(bucket_full, 0, sizeof(bucket_full));
+  memset(bucket_frames, 0, sizeof(bucket_frames));
+  current = 0;
+  error = 0;
+  mismatch = 0;
+
+  for (f = 0; f < frames; f++)
+  {
+    if (f > 0 && Random01() < digit)
+      current = (current + 1) % nb_digits;
+    memcpy(frame, digits[current], sizeof(frame));
+    if (Random01() < glitch)
+    {
+      x0 = rand() % (IMG_WIDTH - size + 1);
+      y0 = rand() % (IMG_HEIGHT - size + 1);
+      for (y = y0; y < y0 + size; y++)
+        for (b = x0; b < x0 + size; b++)
+          frame[0][y][b] = rand() & 0xff;
+    }
+
+    tstart = TimeNow();
+    changed = lenet_cnn_stream(stream, frame, stream_output);
+    tstream = TimeNow() - tstart;
+    tstart = TimeNow();
+    lenet_cnn(frame, full_output);
+    tfull = TimeNow() - tstart;
+
+    if (memcmp(stream_output, full_output, sizeof(full_output)))
+    {
+      printf("Frame %d: stream output differs from lenet_cnn\n", f);
+      mismatch++;
+    }
+    Softmax(stream_output, softmax_output);
+    if (ClassifySoftmax(softmax_output) != labels[current])
+      error = error + 1;
+
+    for (b = 0; changed > bucket_max[b]; b++)
+      ;
+    bucket_frames[b]++;
+    bucket_stream[b] += tstream;
+    bucket_full[b] += tfull;
+  }
+
+  StreamStats(stream, &stats);
+  printf("\n%d frames, %llu full, %llu unchanged, %d differ from lenet_cnn\n", frames, stats.full, stats.unchanged,
+         mismatch);
+  printf("per frame: Conv1 %.1f%% and Conv2 %.1f%% of the positions recomputed, %.1f Pool1, %.1f Pool2 and %.1f FC1 "
+         "values changed, FC ran on %llu frames\n",
+         100.0 * stats.conv1_pixels / ((double)frames * CONV1_HEIGHT * CONV1_WIDTH),
+         100.0 * stats.conv2_pixels / ((double)frames * CONV2_HEIGHT * CONV2_WIDTH),
+         (double)stats.pool1_changes / frames, (double)stats.pool2_changes / frames,
+         (double)stats.fc1_changes / frames, stats.fc_frames);
+
+  printf("\n changed pixels   frames   stream (us)   lenet_cnn (us)   speedup\n");
+  low = 0;
+  for (b = 0; b < NB_BUCKETS; b++)
+  {
+    if (bucket_frames[b])
+      printf(" %5d .. %-5d  %8u   %11.2f   %14.2f   %6.1fx\n", low, bucket_max[b], bucket_frames[b],
+             bucket_stream[b] * 1000000 / bucket_frames[b], bucket_full[b] * 1000000 / bucket_frames[b],
+             bucket_stream[b] > 0 ? bucket_full[b] / bucket_stream[b] : 0);
+    low = bucket_max[b] + 1;
+  }
+
+  printf("\n\nErrors : %d / %d", error, frames);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / frames)) * 100);
+  printf("\n\n");
+
+  StreamDestroy(stream);
+  return 0;
+}
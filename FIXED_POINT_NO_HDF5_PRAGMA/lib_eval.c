@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file    lib_eval.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Test set evaluation through liblenet (lenet.h) only
+  * @brief   usage: ./lib_eval [-j threads] [-b batch] [-n max_images]
+  *          One shared lenet_model, one lenet_ctx per thread; each thread calls
+  *          lenet_infer_batch on its batches (lenet_infer with -b 1). The
+  *          logits are compared with a single threaded pass of lenet_infer.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "lenet_cnn_float.h"
+#include "lenet.h"
+
+#define MAX_THREADS     64
+#define DEFAULT_BATCH   32
+
+typedef struct {
+  const lenet_model *model;
+  const unsigned char *pixels;
+  lenet_result *results;
+  int nb_images;
+  int batch;
+  int thread;
+  int nb_threads;
+} lib_job;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-j threads] [-b batch] [-n max_images]\n", program);
+}
+
+// batches thread, thread + nb_threads, ...
+static void *EvalThread(void *arg)
+{
+  lib_job *job = arg;
+  lenet_ctx *ctx;
+  int first, count;
+
+  ctx = lenet_ctx_create(job->model);
+  if (!ctx)
+  {
+    printf("Error: Unable to create the context of thread %d.\n", job->thread);
+    exit(1);
+  }
+  for (first = job->thread * job->batch; first < job->nb_images; first += job->nb_threads * job->batch)
+  {
+    count = job->nb_images - first < job->batch ? job->nb_images - first : job->batch;
+    if (count == 1)
+      lenet_infer(ctx, job->pixels + (size_t)first * LENET_PIXELS, &job->results[first]);
+    else
+      lenet_infer_batch(ctx, job->pixels + (size_t)first * LENET_PIXELS, count, &job->results[first]);
+  }
+  lenet_ctx_destroy(ctx);
+  return NULL;
+}
+
+static double RunThreads(lib_job jobs[], int nb_threads)
+{
+  pthread_t threads[MAX_THREADS];
+  double tstart;
+  int t;
+
+  tstart = TimeNow();
+  for (t = 0; t < nb_threads; t++)
+    if (pthread_create(&threads[t], NULL, EvalThread, &jobs[t]) != 0)
+    {
+      printf("Error: Unable to start thread %d.\n", t);
+      exit(1);
+    }
+  for (t = 0; t < nb_threads; t++)
+    pthread_join(threads[t], NULL);
+  return TimeNow() - tstart;
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES];
+  static lenet_result reference[NB_TEST_IMAGES], results[NB_TEST_IMAGES];
+  lib_job jobs[MAX_THREADS];
+  lenet_model *model;
+  unsigned int error, mismatch;
+  int opt, m, t, nb_threads, batch, nb_images, max_images;
+  double tserial, tparallel;
+
+  nb_threads = sysconf(_SC_NPROCESSORS_ONLN);
+  batch = DEFAULT_BATCH;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "j:b:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j': nb_threads = atoi(optarg); break;
+    case 'b': batch = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_threads < 1 || nb_threads > MAX_THREADS)
+    nb_threads = 1;
+  if (batch < 1)
+    batch = 1;
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  model = lenet_model_create();
+  if (!model)
+  {
+    printf("Error: Unable to create the model.\n");
+    exit(1);
+  }
+
+  // single threaded reference through the same API, one image at a time (lenet_infer)
+  jobs[0] = (lib_job){ model, (unsigned char *)images, reference, nb_images, 1, 0, 1 };
+  tserial = RunThreads(jobs, 1);
+
+  for (t = 0; t < nb_threads; t++)
+    jobs[t] = (lib_job){ model, (unsigned char *)images, results, nb_images, batch, t, nb_threads };
+  tparallel = RunThreads(jobs, nb_threads);
+
+  error = 0;
+  mismatch = 0;
+  for (m = 0; m < nb_images; m++)
+  {
+    if (results[m].label != labels[m])
+      error = error + 1;
+    if (memcmp(results[m].logits, reference[m].logits, sizeof(results[m].logits)) != 0)
+      mismatch = mismatch + 1;
+  }
+
+  printf("\nProcessing %d images, batch %d\n", nb_images, batch);
+  printf("1 thread, batch 1 : %f s, %.1f images/s\n", tserial, nb_images / tserial);
+  printf("%-2d threads        : %f s, %.1f images/s\n", nb_threads, tparallel, nb_images / tparallel);
+  printf("Logits different from the single threaded lenet_infer pass: %u\n", mismatch);
+  printf("\n\nErrors : %d / %d", error, nb_images);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+  printf("\n\n");
+
+  lenet_model_destroy(model);
+
+  return mismatch ? 1 : 0;
+}
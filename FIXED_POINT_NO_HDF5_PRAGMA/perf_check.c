@@ -0,0 +1,346 @@
+/**
+  ******************************************************************************
+  * @file    perf_check.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Performance regression gate (make perf-check)
+  * @brief   usage: ./perf_check [-P] [-b baseline.json] [-o results.json] [-t tolerance] [-T tail_tolerance]
+  *                               [-r samples] [-p passes] [-c cpu] [-n max_images] [-u]
+  *          Runs the test set through lenet_cnn and writes the results as a
+  *          flat JSON object. By default only the accuracy is gated: the number
+  *          of images and errors must match the baseline (perf_baseline.json,
+  *          committed) exactly. Times depend on the machine, so they are only
+  *          gated with -P against a baseline recorded with -u on the same
+  *          machine (make perf-baseline, perf_local.json, not committed). -P
+  *          adds the per-layer benchmarks (bench.h) and the per-image latency
+  *          (lat_hist.h); other tenants of a shared machine only ever slow a
+  *          run down, so the gated values are the fastest sample of each layer
+  *          (median kept for information) and the fastest of the test set
+  *          passes. Times may grow and throughput drop by the tolerance
+  *          (default 20%), latency percentiles by the tail tolerance (default
+  *          50%). A metric missing from the results or from the baseline is a
+  *          failure. Exits with 1 on any failure; -u writes the results as the
+  *          new baseline instead of comparing.
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "lenet_cnn_float.h"
+#include "bench.h"
+#include "lat_hist.h"
+
+#define MAX_METRICS         64
+#define METRIC_NAME         80
+#define CHECK_SAMPLES       9
+#define CHECK_PASSES        3
+
+enum { METRIC_INFO, METRIC_LOWER, METRIC_HIGHER, METRIC_TAIL, METRIC_EXACT };
+
+typedef struct {
+  char name[METRIC_NAME];
+  double value;
+  int kind;                   // how it is compared with the baseline
+} perf_metric;
+
+static perf_metric METRICS[MAX_METRICS];
+static int NB_METRICS;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-P] [-b baseline.json] [-o results.json] [-t tolerance] [-T tail_tolerance] [-r samples] [-p passes] [-c cpu] [-n max_images] [-u]\n",
+         program);
+}
+
+static void AddMetric(const char *name, double value, int kind)
+{
+  if (NB_METRICS == MAX_METRICS)
+  {
+    printf("Error: More than %d metrics.\n", MAX_METRICS);
+    exit(1);
+  }
+  snprintf(METRICS[NB_METRICS].name, METRIC_NAME, "%s", name);
+  METRICS[NB_METRICS].value = value;
+  METRICS[NB_METRICS].kind = kind;
+  NB_METRICS++;
+}
+
+static void WriteJson(const char *filename)
+{
+  FILE *file;
+  int k;
+
+  file = fopen(filename, "w");
+  if (!file)
+  {
+    printf("Error: Unable to open file %s.\n", filename);
+    exit(1);
+  }
+  fprintf(file, "{\n");
+  for (k = 0; k < NB_METRICS; k++)
+    fprintf(file, "  \"%s\": %.6g%s\n", METRICS[k].name, METRICS[k].value, k + 1 < NB_METRICS ? "," : "");
+  fprintf(file, "}\n");
+  fclose(file);
+}
+
+// flat object of "name": number pairs, as written by WriteJson
+static int ReadJson(const char *filename, perf_metric metrics[])
+{
+  FILE *file;
+  char line[256], *start, *end;
+  int nb_metrics;
+
+  file = fopen(filename, "r");
+  if (!file)
+    return -1;
+  nb_metrics = 0;
+  while (fgets(line, sizeof(line), file) && nb_metrics < MAX_METRICS)
+  {
+    start = strchr(line, '"');
+    if (!start)
+      continue;
+    end = strchr(start + 1, '"');
+    if (!end || end - start - 1 >= METRIC_NAME || !strchr(end, ':'))
+      continue;
+    memcpy(metrics[nb_metrics].name, start + 1, end - start - 1);
+    metrics[nb_metrics].name[end - start - 1] = 0;
+    metrics[nb_metrics].value = strtod(strchr(end, ':') + 1, NULL);
+    nb_metrics++;
+  }
+  fclose(file);
+  return nb_metrics;
+}
+
+static void RunBenchmarks(int nb_samples)
+{
+  bench_case cases[MAX_BENCH_CASES];
+  char name[METRIC_NAME];
+  double median, min;
+  int nb_cases, k;
+
+  nb_cases = FixedBenchCases(cases);
+  nb_cases += FloatBenchCases(cases + nb_cases);
+  for (k = 0; k < nb_cases; k++)
+  {
+    BenchRun(&cases[k], BENCH_WARMUP, nb_samples, &median, &min);
+    snprintf(name, METRIC_NAME, "bench.%s.%s.min_ns", cases[k].tree, cases[k].layer);
+    AddMetric(name, min, METRIC_LOWER);
+    snprintf(name, METRIC_NAME, "bench.%s.%s.median_ns", cases[k].tree, cases[k].layer);
+    AddMetric(name, median, METRIC_INFO);
+  }
+}
+
+// one pass over the test set, returns the time of the pass
+static double TestSetPass(unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], unsigned char *labels,  // IN
+                          int nb_images, lat_hist *latency, unsigned int *error)                            // OUT
+{
+  unsigned char input_norm[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  unsigned long long tstart, tend;
+  double tpass;
+  int m;
+
+  HistReset(latency);
+  *error = 0;
+  tpass = TimeNow();
+  for (m = 0; m < nb_images; m++)
+  {
+    tstart = HistNow();
+    NormalizeImg((unsigned char *)images[m], (unsigned char *)input_norm, IMG_WIDTH, IMG_HEIGHT);
+    lenet_cnn(input_norm, fc2_output);
+    Softmax(fc2_output, softmax_output);
+    tend = HistNow();
+    HistRecord(latency, tend - tstart);
+    if (ClassifySoftmax(softmax_output) != labels[m])
+      *error = *error + 1;
+  }
+  return TimeNow() - tpass;
+}
+
+static void RunTestSet(int max_images, int nb_passes, int perf)
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES];
+  static lat_hist pass_latency, latency;
+  unsigned int pass_error, error;
+  int p, nb_images;
+  double tpass, tdiff;
+
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  tdiff = 0;
+  error = 0;
+  for (p = 0; p < nb_passes; p++)
+  {
+    tpass = TestSetPass(images, labels, nb_images, &pass_latency, &pass_error);
+    if (p == 0 || tpass < tdiff)
+    {
+      tdiff = tpass;
+      latency = pass_latency;
+    }
+    // deterministic: every pass makes the same predictions
+    if (p > 0 && pass_error != error)
+    {
+      printf("Error: %u then %u errors on the same images.\n", error, pass_error);
+      exit(1);
+    }
+    error = pass_error;
+  }
+
+  AddMetric("eval.images", nb_images, METRIC_EXACT);
+  AddMetric("eval.errors", error, METRIC_EXACT);
+  if (!perf)
+    return;
+  AddMetric("eval.images_per_s", nb_images / tdiff, METRIC_HIGHER);
+  AddMetric("eval.latency_p50_us", HistPercentile(&latency, 50) / 1000.0, METRIC_TAIL);
+  AddMetric("eval.latency_p99_us", HistPercentile(&latency, 99) / 1000.0, METRIC_TAIL);
+  // a handful of images out of 10000, too noisy on a shared machine to gate on
+  AddMetric("eval.latency_p99.9_us", HistPercentile(&latency, 99.9) / 1000.0, METRIC_INFO);
+  AddMetric("eval.latency_max_us", latency.max / 1000.0, METRIC_INFO);
+}
+
+// number of regressions, metrics missing on either side included
+static int Compare(perf_metric baseline[], int nb_baseline, double tolerance, double tail_tolerance)
+{
+  const char *status;
+  double base, change;
+  int k, b, regressions;
+
+  regressions = 0;
+  printf("\n%-48s %12s %12s %8s\n", "metric", "baseline", "current", "change");
+  for (k = 0; k < NB_METRICS; k++)
+  {
+    for (b = 0; b < nb_baseline; b++)
+      if (!strcmp(baseline[b].name, METRICS[k].name))
+        break;
+    if (b == nb_baseline)
+    {
+      printf("%-48s %12s %12.6g %8s  NOT IN BASELINE\n", METRICS[k].name, "-", METRICS[k].value, "-");
+      regressions++;
+      continue;
+    }
+    base = baseline[b].value;
+    change = base ? (METRICS[k].value - base) / base : 0;
+    status = "ok";
+    switch (METRICS[k].kind)
+    {
+    case METRIC_LOWER:
+      if (change > tolerance)
+        status = "REGRESSION";
+      break;
+    case METRIC_TAIL:
+      if (change > tail_tolerance)
+        status = "REGRESSION";
+      break;
+    case METRIC_HIGHER:
+      if (change < -tolerance)
+        status = "REGRESSION";
+      break;
+    case METRIC_EXACT:
+      if (METRICS[k].value != base)
+        status = "REGRESSION";
+      break;
+    default:
+      status = "info";
+    }
+    if (!strcmp(status, "REGRESSION"))
+      regressions++;
+    printf("%-48s %12.6g %12.6g %+7.1f%%  %s\n", METRICS[k].name, base, METRICS[k].value, 100 * change, status);
+  }
+  for (b = 0; b < nb_baseline; b++)
+  {
+    for (k = 0; k < NB_METRICS; k++)
+      if (!strcmp(baseline[b].name, METRICS[k].name))
+        break;
+    if (k == NB_METRICS)
+    {
+      printf("%-48s %12.6g %12s %8s  MISSING\n", baseline[b].name, baseline[b].value, "-", "-");
+      regressions++;
+    }
+  }
+  return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+  perf_metric baseline[MAX_METRICS];
+  char *baseline_filename, *results_filename;
+  double tolerance, tail_tolerance;
+  int opt, cpu, nb_samples, nb_passes, max_images, update, perf, nb_baseline, regressions;
+
+  baseline_filename = "perf_baseline.json";
+  results_filename = "perf_results.json";
+  tolerance = 0.2;
+  tail_tolerance = 0.5;
+  nb_samples = CHECK_SAMPLES;
+  nb_passes = 0;
+  cpu = sched_getcpu();
+  max_images = NB_TEST_IMAGES;
+  update = 0;
+  perf = 0;
+  while ((opt = getopt(argc, argv, "Pb:o:t:T:r:p:c:n:uh")) != -1)
+  {
+    switch (opt)
+    {
+    case 'b': baseline_filename = optarg; break;
+    case 'o': results_filename = optarg; break;
+    case 't': tolerance = atof(optarg); break;
+    case 'T': tail_tolerance = atof(optarg); break;
+    case 'r': nb_samples = atoi(optarg); break;
+    case 'p': nb_passes = atoi(optarg); break;
+    case 'c': cpu = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    case 'u': update = 1; break;
+    case 'P': perf = 1; break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_samples < 1 || nb_samples > BENCH_MAX_SAMPLES)
+    nb_samples = CHECK_SAMPLES;
+  // the accuracy needs one pass, the fastest of several is kept for the times
+  if (nb_passes < 1)
+    nb_passes = perf ? CHECK_PASSES : 1;
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  BenchPin(cpu);
+  if (perf)
+    RunBenchmarks(nb_samples);
+  RunTestSet(max_images, nb_passes, perf);
+
+  WriteJson(results_filename);
+  printf("Results written to %s\n", results_filename);
+  if (update)
+  {
+    WriteJson(baseline_filename);
+    printf("Baseline %s updated\n\n", baseline_filename);
+    return 0;
+  }
+
+  nb_baseline = ReadJson(baseline_filename, baseline);
+  if (nb_baseline < 0)
+  {
+    printf("Error: Unable to open baseline %s (create it with -u).\n", baseline_filename);
+    exit(1);
+  }
+  regressions = Compare(baseline, nb_baseline, tolerance, tail_tolerance);
+
+  if (perf)
+    printf("\nTolerance %.0f%% (time, throughput), %.0f%% (latency percentiles): ", 100 * tolerance, 100 * tail_tolerance);
+  else
+    printf("\nAccuracy only (-P to gate the times against a local baseline): ");
+  if (regressions)
+    printf("%d regressions\n\n", regressions);
+  else
+    printf("no regression\n\n");
+
+  return regressions ? 1 : 0;
+}
@@ -0,0 +1,252 @@
+/**
+  ******************************************************************************
+  * @file    pipeline.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Layer pipelined execution: one thread per layer, SPSC frame queues
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "lenet_cnn_float.h"
+#include "workers.h"
+#include "pipeline.h"
+#include "trace.h"
+
+#define SPIN_BEFORE_YIELD   1000
+
+const char *STAGE_NAMES[NB_STAGES] = { "conv1", "pool1", "conv2", "pool2", "fc1", "fc2" };
+
+// one image in flight and every activation computed from it
+typedef struct {
+  int index;
+  unsigned char (*input)[IMG_HEIGHT][IMG_WIDTH];
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+} __attribute__((aligned(CACHE_LINE))) frame;
+
+// bounded single producer / single consumer ring of frame pointers,
+// head and tail on their own cache lines; NULL marks the end of the stream
+typedef struct {
+  _Atomic unsigned int head __attribute__((aligned(CACHE_LINE)));   // next pop, written by the consumer
+  _Atomic unsigned int tail __attribute__((aligned(CACHE_LINE)));   // next push, written by the producer
+  unsigned int bound __attribute__((aligned(CACHE_LINE)));         // push waits at this length
+  frame *slots[QUEUE_CAPACITY];
+} spsc_queue;
+
+typedef struct {
+  int stage;
+  int pin;
+  spsc_queue *in;
+  spsc_queue *out;
+  unsigned char *predicted;
+  stage_stats stats;
+} __attribute__((aligned(CACHE_LINE))) stage_context;
+
+static void Backoff(int *polls)
+{
+  if (++(*polls) < SPIN_BEFORE_YIELD)
+    CPU_RELAX();
+  else
+    sched_yield();
+}
+
+// returns the seconds spent waiting for room
+static double QueuePush(spsc_queue *queue, frame *item)
+{
+  unsigned int tail;
+  double tstart;
+  int polls;
+
+  tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+  tstart = 0;
+  polls = 0;
+  while (tail - atomic_load_explicit(&queue->head, memory_order_acquire) >= queue->bound) {
+    if (!polls) {
+      tstart = TimeNow();
+      TRACE_BEGIN(TRACE_QUEUE_FULL);
+    }
+    Backoff(&polls);
+  }
+  if (polls)
+    TRACE_END(TRACE_QUEUE_FULL);
+  queue->slots[tail & (QUEUE_CAPACITY - 1)] = item;
+  atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+
+  return polls ? TimeNow() - tstart : 0;
+}
+
+// returns the seconds spent waiting for an item, *length is the queue length found
+static double QueuePop(spsc_queue *queue, frame **item, unsigned int *length)
+{
+  unsigned int head;
+  double tstart;
+  int polls;
+
+  head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+  tstart = 0;
+  polls = 0;
+  while ((*length = atomic_load_explicit(&queue->tail, memory_order_acquire) - head) == 0) {
+    if (!polls) {
+      tstart = TimeNow();
+      TRACE_BEGIN(TRACE_QUEUE_EMPTY);
+    }
+    Backoff(&polls);
+  }
+  if (polls)
+    TRACE_END(TRACE_QUEUE_EMPTY);
+  *item = queue->slots[head & (QUEUE_CAPACITY - 1)];
+  atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+
+  return polls ? TimeNow() - tstart : 0;
+}
+
+static void RunStage(stage_context *ctx, frame *f)
+{
+  // stages follow the layer order of the trace events
+  TRACE_BEGIN(TRACE_CONV1 + ctx->stage);
+  switch (ctx->stage) {
+  case STAGE_CONV1:
+    Conv1_28x28x1_5x5x20_1_0(f->input, CONV1_KERNEL, CONV1_BIAS, f->conv1_output);
+    break;
+  case STAGE_POOL1:
+    Pool1_24x24x20_2x2x20_2_0(f->conv1_output, f->pool1_output);
+    break;
+  case STAGE_CONV2:
+    Conv2_12x12x20_5x5x40_1_0(f->pool1_output, CONV2_KERNEL, CONV2_BIAS, f->conv2_output);
+    break;
+  case STAGE_POOL2:
+    Pool2_8x8x40_2x2x40_2_0(f->conv2_output, f->pool2_output);
+    break;
+  case STAGE_FC1:
+    Fc1_40_400(f->pool2_output, FC1_KERNEL, FC1_BIAS, f->fc1_output);
+    break;
+  default:
+    Fc2_400_10(f->fc1_output, FC2_KERNEL, FC2_BIAS, f->fc2_output);
+    TRACE_BEGIN(TRACE_SOFTMAX);
+    Softmax(f->fc2_output, f->softmax_output);
+    ctx->predicted[f->index] = ClassifySoftmax(f->softmax_output);
+    TRACE_END(TRACE_SOFTMAX);
+  }
+  TRACE_END(TRACE_CONV1 + ctx->stage);
+}
+
+static void PinToCore(int core)
+{
+  cpu_set_t cpus;
+
+  CPU_ZERO(&cpus);
+  CPU_SET(core % DefaultWorkers(), &cpus);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+static void *StageThread(void *arg)
+{
+  stage_context *ctx = arg;
+  unsigned int length;
+  frame *f;
+  double tstart;
+
+  if (ctx->pin)
+    PinToCore(ctx->stage);
+
+  while (1) {
+    ctx->stats.starved += QueuePop(ctx->in, &f, &length);
+    if (!f)
+      break;
+    ctx->stats.queue_sum += length;
+
+    tstart = TimeNow();
+    RunStage(ctx, f);
+    ctx->stats.busy += TimeNow() - tstart;
+    ctx->stats.items++;
+
+    ctx->stats.stalled += QueuePush(ctx->out, f);
+  }
+
+  // end of stream, the free queue does not need it
+  if (ctx->stage != STAGE_FC2)
+    QueuePush(ctx->out, NULL);
+
+  return NULL;
+}
+
+void RunPipeline(unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                 int nb_images, int depth, int bound, int pin,
+                 unsigned char predicted[],                                // OUT
+                 stage_stats stats[NB_STAGES])                             // OUT
+{
+  pthread_t threads[NB_STAGES];
+  stage_context *contexts;
+  spsc_queue *queues;   // queues[s] feeds stage s, queues[NB_STAGES] is the free queue
+  frame *frames, *f;
+  unsigned int length;
+  int s, m;
+
+  if (depth < 1)
+    depth = 1;
+  if (depth > QUEUE_CAPACITY - 1)
+    depth = QUEUE_CAPACITY - 1;
+  if (bound < 1)
+    bound = 1;
+  if (bound > QUEUE_CAPACITY)
+    bound = QUEUE_CAPACITY;
+
+  frames = aligned_alloc(CACHE_LINE, sizeof(frame) * depth);
+  queues = aligned_alloc(CACHE_LINE, sizeof(spsc_queue) * (NB_STAGES + 1));
+  contexts = aligned_alloc(CACHE_LINE, sizeof(stage_context) * NB_STAGES);
+  if (!frames || !queues || !contexts) {
+    printf("Error: Unable to allocate %d frames.\n", depth);
+    exit(1);
+  }
+  memset(queues, 0, sizeof(spsc_queue) * (NB_STAGES + 1));
+  memset(contexts, 0, sizeof(stage_context) * NB_STAGES);
+  for (s = 0; s < NB_STAGES; s++)
+    queues[s].bound = bound;
+  queues[NB_STAGES].bound = QUEUE_CAPACITY;
+
+  for (m = 0; m < depth; m++)
+    QueuePush(&queues[NB_STAGES], &frames[m]);
+
+  for (s = 0; s < NB_STAGES; s++) {
+    contexts[s].stage = s;
+    contexts[s].pin = pin;
+    contexts[s].in = &queues[s];
+    contexts[s].out = &queues[s + 1];
+    contexts[s].predicted = predicted;
+    if (pthread_create(&threads[s], NULL, StageThread, &contexts[s]) != 0) {
+      printf("Error: Unable to start stage %s.\n", STAGE_NAMES[s]);
+      exit(1);
+    }
+  }
+
+  // source: recycled frames from the free queue get the next image
+  for (m = 0; m < nb_images; m++) {
+    QueuePop(&queues[NB_STAGES], &f, &length);
+    f->index = m;
+    f->input = images[m];
+    QueuePush(&queues[0], f);
+  }
+  QueuePush(&queues[0], NULL);
+
+  for (s = 0; s < NB_STAGES; s++) {
+    pthread_join(threads[s], NULL);
+    stats[s] = contexts[s].stats;
+  }
+
+  free(contexts);
+  free(queues);
+  free(frames);
+}
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    pipeline.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Layer pipelined execution, the CPU counterpart of HLS DATAFLOW
+  * @brief   Conv1, Pool1, Conv2, Pool2, FC1 and FC2 each run on their own thread.
+  *          Frames (one image and all its activations) circulate through bounded
+  *          single producer / single consumer queues and come back to the source
+  *          through a free queue, so no buffer is allocated while running.
+  *          Every stage counts its busy time, the time it waits for input
+  *          (starved) and the time it waits for room downstream (stalled).
+  */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+enum { STAGE_CONV1, STAGE_POOL1, STAGE_CONV2, STAGE_POOL2, STAGE_FC1, STAGE_FC2, NB_STAGES };
+
+#define QUEUE_CAPACITY  64      // power of two, > frames in flight
+#define DEFAULT_DEPTH   8       // frames in flight
+#define DEFAULT_BOUND   2       // frames waiting between two stages, ping-pong as in HLS
+
+typedef struct {
+  unsigned long long items;
+  double busy;                  // seconds computing
+  double starved;               // seconds waiting for the upstream queue
+  double stalled;               // seconds waiting for room in the downstream queue
+  double queue_sum;             // input queue length summed at every pop
+} stage_stats;
+
+extern const char *STAGE_NAMES[NB_STAGES];
+
+// classifies images[0..nb_images-1] into predicted[], depth frames in flight and
+// at most bound frames queued before each stage;
+// pin places stage s on online core s modulo the number of cores
+void RunPipeline(unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                 int nb_images, int depth, int bound, int pin,
+                 unsigned char predicted[],                                // OUT
+                 stage_stats stats[NB_STAGES]);                            // OUT
+
+#endif
@@ -0,0 +1,157 @@
+/**
+  ******************************************************************************
+  * @file    prune_fc1.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   FC1 pruning threshold sweep: accuracy, CSR size and dense vs CSR speed
+  * @brief   usage: ./prune_fc1 [max_threshold] [max_images]
+  *          The default max_threshold is the largest |weight| of FC1, so the
+  *          sweep goes down to an empty FC1 and always passes the density at
+  *          which the CSR layer becomes faster than the dense one.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lenet_cnn_float.h"
+
+#define TIMING_RUNS             3
+
+// pruned FC1 in both formats, same weights
+short FC1_PRUNED[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+unsigned int FC1_ROW_PTR[FC1_NBOUTPUT+1];
+unsigned char FC1_COL_DELTA[FC1_MAX_ENTRIES];
+signed char FC1_VALUES[FC1_MAX_ENTRIES];
+
+// features entering FC1, computed once for all thresholds
+static void Features(unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],      // IN
+                     short output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH])   // OUT
+{
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+
+  Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output);
+  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+  Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
+  Pool2_8x8x40_2x2x40_2_0(conv2_output, output);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  short (*features)[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  short fc1_dense[FC1_NBOUTPUT], fc1_csr[FC1_NBOUTPUT];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  short threshold, max_threshold, *weights;
+  unsigned int nnz, error, mismatch, csr_bytes, crossover_bytes;
+  int m, run, nb_images, max_images;
+  double density, tstart, tdiff, tdense, tcsr, crossover;
+
+  // largest |weight|: empty FC1 at the end of the sweep
+  weights = &FC1_KERNEL[0][0][0][0];
+  max_threshold = 0;
+  for (m = 0; m < FC1_MAX_NNZ; m++)
+    if (abs(weights[m]) > max_threshold)
+      max_threshold = abs(weights[m]);
+  if (argc > 1)
+    max_threshold = atoi(argv[1]);
+  max_images = NB_TEST_IMAGES;
+  if (argc > 2)
+    max_images = atoi(argv[2]);
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  images = malloc(sizeof(*images) * max_images);
+  features = malloc(sizeof(*features) * max_images);
+  if (!images || !features)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+  for (m = 0; m < nb_images; m++)
+    Features(images[m], features[m]);
+
+  printf("\n%d images, dense FC1 %u bytes, baseline %d / %d errors\n\n", nb_images, (unsigned int)sizeof(FC1_KERNEL), BASELINE_ERRORS, NB_TEST_IMAGES);
+  printf("%9s %8s %8s %10s %14s %9s %11s %11s %8s\n", "threshold", "nnz", "density", "CSR bytes", "errors", "success", "dense (us)", "CSR (us)", "speedup");
+
+  crossover = 0;
+  crossover_bytes = 0;
+  for (threshold = 0; threshold <= max_threshold; threshold++)
+  {
+    nnz = PruneFc1(FC1_KERNEL, threshold, FC1_ROW_PTR, FC1_COL_DELTA, FC1_VALUES);
+    density = (double)nnz / FC1_MAX_NNZ;
+    csr_bytes = sizeof(FC1_ROW_PTR) + FC1_ROW_PTR[FC1_NBOUTPUT] * (sizeof(FC1_COL_DELTA[0]) + sizeof(FC1_VALUES[0]));
+
+    // dense copy of the same pruned weights, for the speed reference
+    memcpy(FC1_PRUNED, FC1_KERNEL, sizeof(FC1_KERNEL));
+    for (m = 0; m < FC1_MAX_NNZ; m++)
+      if ((&FC1_PRUNED[0][0][0][0])[m] <= threshold && (&FC1_PRUNED[0][0][0][0])[m] >= -threshold)
+        (&FC1_PRUNED[0][0][0][0])[m] = 0;
+
+    // best of TIMING_RUNS passes, the machine is not assumed to be idle
+    tdense = 1e9;
+    tcsr = 1e9;
+    for (run = 0; run < TIMING_RUNS; run++)
+    {
+      tstart = TimeNow();
+      for (m = 0; m < nb_images; m++)
+        Fc1_40_400(features[m], FC1_PRUNED, FC1_BIAS, fc1_dense);
+      tdiff = TimeNow() - tstart;
+      if (tdiff < tdense)
+        tdense = tdiff;
+
+      tstart = TimeNow();
+      for (m = 0; m < nb_images; m++)
+        Fc1_40_400_csr(features[m], FC1_ROW_PTR, FC1_COL_DELTA, FC1_VALUES, FC1_BIAS, fc1_csr);
+      tdiff = TimeNow() - tstart;
+      if (tdiff < tcsr)
+        tcsr = tdiff;
+    }
+
+    error = 0;
+    mismatch = 0;
+    for (m = 0; m < nb_images; m++)
+    {
+      Fc1_40_400(features[m], FC1_PRUNED, FC1_BIAS, fc1_dense);
+      Fc1_40_400_csr(features[m], FC1_ROW_PTR, FC1_COL_DELTA, FC1_VALUES, FC1_BIAS, fc1_csr);
+      if (memcmp(fc1_dense, fc1_csr, sizeof(fc1_csr)))
+        mismatch++;
+
+      Fc2_400_10(fc1_csr, FC2_KERNEL, FC2_BIAS, fc2_output);
+      Softmax(fc2_output, softmax_output);
+      if (ClassifySoftmax(softmax_output) != labels[m])
+        error++;
+    }
+
+    if (tcsr < tdense && density > crossover)
+    {
+      crossover = density;
+      crossover_bytes = csr_bytes;
+    }
+
+    printf("%9d %8u %7.2f%% %10u %8u / %-5d %8.2f%% %11.2f %11.2f %7.2fx\n", threshold, nnz, density * 100, csr_bytes,
+           error, nb_images, (1 - ((double)error / nb_images)) * 100,
+           tdense * 1000000 / nb_images, tcsr * 1000000 / nb_images, tdense / tcsr);
+    if (mismatch)
+      printf("Warning: CSR and dense FC1 outputs differ on %u images\n", mismatch);
+  }
+
+  if (crossover > 0)
+    printf("\nCrossover: CSR FC1 is faster than dense FC1 up to %.2f%% density (%u bytes) on this machine\n\n",
+           crossover * 100, crossover_bytes);
+  else
+    printf("\nCSR FC1 is never faster than dense FC1 in this threshold range\n\n");
+
+  free(features);
+  free(images);
+
+  return 0;
+}
@@ -0,0 +1,274 @@
+/**
+  ******************************************************************************
+  * @file    quant.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Ternary and power of two quantization of FC1 / Conv2 weights
+  * @brief   Matching kernels only use add/sub (ternary) or shifts (power of two),
+  *          so no DSP48 is needed for the MACs once synthesized
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lenet_cnn_float.h"
+
+// 2-bit ternary codes
+#define TERNARY_ZERO    0
+#define TERNARY_PLUS    1
+#define TERNARY_MINUS   3
+
+// 4-bit power of two codes: bit 3 = sign, bits 2..0 = exponent+1, 0 = zero weight
+#define POW2_SIGN       0x8
+#define POW2_EXP_MASK   0x7
+
+
+// nearest power of two of a weight, returned as a 4-bit code
+static unsigned char Pow2Code(short weight)
+{
+  unsigned char e;
+  short magnitude;
+
+  magnitude = weight < 0 ? -weight : weight;
+  if (magnitude == 0)
+    return 0;
+
+  // 2^e is kept while magnitude is below the midpoint 1.5*2^e
+  e = 0;
+  while (e < POW2_MAX_EXP && 2 * magnitude >= 3 << e)
+    e++;
+
+  return (weight < 0 ? POW2_SIGN : 0) | (e + 1);
+}
+
+void QuantizeFc1Ternary(short           kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        unsigned char   packed[FC1_NBOUTPUT][FC1_TERNARY_BYTES],                            // OUT
+                        short           scale[FC1_NBOUTPUT])                                                // OUT
+{
+  unsigned short o, i;
+  short *weights, magnitude, threshold;
+  int abs_sum, kept_sum, kept;
+  unsigned char code;
+
+  for (o = 0; o < FC1_NBOUTPUT; o++) {
+    weights = &kernel[o][0][0][0];
+
+    // threshold at 0.7 * mean |w| (ternary weight networks)
+    abs_sum = 0;
+    for (i = 0; i < FC1_NBINPUT; i++)
+      abs_sum += weights[i] < 0 ? -weights[i] : weights[i];
+    threshold = (short)((7 * abs_sum) / (10 * FC1_NBINPUT));
+
+    // scale is the mean magnitude of the weights kept
+    kept_sum = 0;
+    kept = 0;
+    for (i = 0; i < FC1_NBINPUT; i++) {
+      magnitude = weights[i] < 0 ? -weights[i] : weights[i];
+      if (magnitude > threshold) {
+        kept_sum += magnitude;
+        kept++;
+      }
+    }
+    scale[o] = kept ? (short)((kept_sum + kept / 2) / kept) : 0;
+
+    for (i = 0; i < FC1_TERNARY_BYTES; i++)
+      packed[o][i] = 0;
+
+    for (i = 0; i < FC1_NBINPUT; i++) {
+      if (weights[i] > threshold)
+        code = TERNARY_PLUS;
+      else if (weights[i] < -threshold)
+        code = TERNARY_MINUS;
+      else
+        code = TERNARY_ZERO;
+      packed[o][i >> 2] |= code << ((i & 3) << 1);
+    }
+  }
+}
+
+void QuantizeFc1Pow2(   short           kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        unsigned char   packed[FC1_NBOUTPUT][FC1_POW2_BYTES])                               // OUT
+{
+  unsigned short o, i;
+  short *weights;
+
+  for (o = 0; o < FC1_NBOUTPUT; o++) {
+    weights = &kernel[o][0][0][0];
+    for (i = 0; i < FC1_POW2_BYTES; i++)
+      packed[o][i] = Pow2Code(weights[2*i]) | (Pow2Code(weights[2*i+1]) << 4);
+  }
+}
+
+void QuantizeConv2Pow2( short           kernel[CONV2_NBOUTPUT][POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM],      // IN
+                        unsigned char   packed[CONV2_NBOUTPUT][CONV2_POW2_BYTES])                           // OUT
+{
+  unsigned short f, i;
+  short *weights;
+
+  for (f = 0; f < CONV2_NBOUTPUT; f++) {
+    weights = &kernel[f][0][0][0];
+    for (i = 0; i < CONV2_POW2_BYTES; i++)
+      packed[f][i] = 0;
+    for (i = 0; i < CONV2_NBINPUT; i++)
+      packed[f][i >> 1] |= Pow2Code(weights[i]) << ((i & 1) << 2);
+  }
+}
+
+void Fc1_40_400_ternary(short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        unsigned char   kernel[FC1_NBOUTPUT][FC1_TERNARY_BYTES],            // IN
+                        short           scale[FC1_NBOUTPUT],                                // IN
+                        short           bias[FC1_NBOUTPUT],                                 // IN
+                        short           output[FC1_NBOUTPUT])                               // OUT
+{
+  #pragma HLS ARRAY_PARTITION variable=input complete dim=2
+  #pragma HLS RESOURCE variable=output core=RAM_1P_LUTRAM
+  #pragma HLS RESOURCE variable=bias core=RAM_1P_LUTRAM
+
+  unsigned short o, i, b;
+  short *in, fc_sum;
+  unsigned char codes;
+  int temp_sum, mask, sign;
+
+  in = &input[0][0][0];
+
+  for (o = 0; o < FC1_NBOUTPUT; o++) { // 400
+    temp_sum = 0;
+
+    for (b = 0; b < FC1_TERNARY_BYTES; b++) { // 400*160 > 64000 iterations
+    #pragma HLS pipeline
+      codes = kernel[o][b];
+      // 4 weights per byte: low bit selects the input, high bit negates it, no multiplier
+      for (i = 0; i < 4; i++) {
+        mask = -(int)(codes & 1);
+        sign = -(int)((codes >> 1) & 1);
+        temp_sum += ((in[4*b + i] & mask) ^ sign) - sign;
+        codes >>= 2;
+      }
+    }
+
+    // single rescale per neuron, outside of the MAC loop
+    fc_sum = (temp_sum * scale[o]) >> FIXED_POINT;
+
+    // neuron activation
+    if (fc_sum + bias[o] <= 0) {
+      output[o] = 0;
+    } else {
+      output[o] = fc_sum + bias[o];
+    }
+  }
+}
+
+void Fc1_40_400_pow2(   short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        unsigned char   kernel[FC1_NBOUTPUT][FC1_POW2_BYTES],               // IN
+                        short           bias[FC1_NBOUTPUT],                                 // IN
+                        short           output[FC1_NBOUTPUT])                               // OUT
+{
+  #pragma HLS ARRAY_PARTITION variable=input complete dim=2
+  #pragma HLS RESOURCE variable=output core=RAM_1P_LUTRAM
+  #pragma HLS RESOURCE variable=bias core=RAM_1P_LUTRAM
+
+  unsigned short o, i, b;
+  short *in, fc_sum;
+  unsigned char codes, e;
+  int temp_sum, mask, sign;
+
+  in = &input[0][0][0];
+
+  for (o = 0; o < FC1_NBOUTPUT; o++) { // 400
+    temp_sum = 0;
+
+    for (b = 0; b < FC1_POW2_BYTES; b++) { // 400*320 > 128000 iterations
+    #pragma HLS pipeline
+      codes = kernel[o][b];
+      // 2 weights per byte, shift and add/sub instead of multiply
+      for (i = 0; i < 2; i++) {
+        e = codes & POW2_EXP_MASK;
+        mask = -(int)(e != 0);
+        sign = -(int)((codes & POW2_SIGN) >> 3);
+        temp_sum += ((((in[2*b + i] << e) >> 1) & mask) ^ sign) - sign;
+        codes >>= 4;
+      }
+    }
+
+    // shifting back after matrix*kernel multiplication
+    fc_sum = temp_sum >> FIXED_POINT;
+
+    // neuron activation
+    if (fc_sum + bias[o] <= 0) {
+      output[o] = 0;
+    } else {
+      output[o] = fc_sum + bias[o];
+    }
+  }
+}
+
+void Conv2_12x12x20_5x5x40_1_0_pow2(short           input[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH],  // IN
+                                    unsigned char   kernel[CONV2_NBOUTPUT][CONV2_POW2_BYTES],           // IN
+                                    short           bias[CONV2_NBOUTPUT],                               // IN
+                                    short           output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH])  // OUT
+{
+  #pragma HLS RESOURCE variable=bias core=RAM_1P_LUTRAM
+  #pragma HLS RESOURCE variable=output core=RAM_1P_LUTRAM
+
+  unsigned short f, d, h, w, x, y, i;
+  unsigned char code, e;
+  int conv_px_sum;
+  // decoded kernel of the current filter: shift amount, zero mask and sign mask
+  unsigned char kernel_shift[POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+  int kernel_mask[POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+  int kernel_sign[POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM];
+
+  for (f = 0; f < CONV2_NBOUTPUT; f++) { // 40
+    for (d = 0; d < POOL1_NBOUTPUT; d++) {
+      for (y = 0; y < CONV2_DIM; y++) {
+        for (x = 0; x < CONV2_DIM; x++) {
+          i = (d * CONV2_DIM + y) * CONV2_DIM + x;
+          code = (kernel[f][i >> 1] >> ((i & 1) << 2)) & 0xF;
+          e = code & POW2_EXP_MASK;
+          kernel_shift[d][y][x] = e;
+          kernel_mask[d][y][x] = -(int)(e != 0);
+          kernel_sign[d][y][x] = -(int)((code & POW2_SIGN) >> 3);
+        }
+      }
+    }
+
+    for (d = 0; d < POOL1_NBOUTPUT; d++) { // 40*20 > 800
+      for (h = 0; h < CONV2_HEIGHT; h++) {
+        for (w = 0; w < CONV2_WIDTH; w++) { // 40*20*8*8 > 51200 iterations
+          conv_px_sum = 0;
+
+          #pragma HLS pipeline
+          // 5x5 convolution with shifts instead of multiplications
+          for (y = 0; y < CONV2_DIM; y++) {
+            for (x = 0; x < CONV2_DIM; x++) {
+              conv_px_sum += ((((input[d][h+y][w+x] << kernel_shift[d][y][x]) >> 1) & kernel_mask[d][y][x])
+                              ^ kernel_sign[d][y][x]) - kernel_sign[d][y][x];
+            }
+          }
+
+          // shifting back after matrix*kernel multiplication
+          conv_px_sum = conv_px_sum >> FIXED_POINT;
+
+          // to initialize first element
+          if (d == 0) {
+            output[f][h][w] = conv_px_sum;
+          } else {
+            output[f][h][w] += conv_px_sum;
+          }
+        }
+      }
+    }
+
+    // neuron activation
+    for (h = 0; h < CONV2_HEIGHT; h++) {
+      for (w = 0; w < CONV2_WIDTH; w++) {
+        if (output[f][h][w] + bias[f] <= 0) {
+          output[f][h][w] = 0;
+        } else {
+          output[f][h][w] = output[f][h][w] + bias[f];
+        }
+      }
+    }
+  }
+}
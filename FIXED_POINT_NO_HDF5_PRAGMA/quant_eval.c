@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    quant_eval.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Accuracy of the ternary / power of two FC1 and Conv2 variants on the MNIST test set
+  * @brief   usage: ./quant_eval [max_images]
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lenet_cnn_float.h"
+
+enum { QUANT_NONE, QUANT_FC1_TERNARY, QUANT_FC1_POW2, QUANT_FC1_CONV2_POW2, QUANT_NB };
+
+static const char *quant_names[QUANT_NB] = {
+  "fixed point (reference)",
+  "FC1 ternary",
+  "FC1 pow2",
+  "FC1 + Conv2 pow2"
+};
+
+// packed weights, built once from weights.h
+unsigned char FC1_TERNARY[FC1_NBOUTPUT][FC1_TERNARY_BYTES];
+short FC1_TERNARY_SCALE[FC1_NBOUTPUT];
+unsigned char FC1_POW2[FC1_NBOUTPUT][FC1_POW2_BYTES];
+unsigned char CONV2_POW2[CONV2_NBOUTPUT][CONV2_POW2_BYTES];
+
+static void lenet_cnn_quant(int quant,
+                            unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], // IN
+                            short output[FC2_NBOUTPUT])                            // OUT
+{
+  short conv1_output[CONV1_NBOUTPUT][CONV1_HEIGHT][CONV1_WIDTH];
+  short pool1_output[POOL1_NBOUTPUT][POOL1_HEIGHT][POOL1_WIDTH];
+  short conv2_output[CONV2_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH];
+  short pool2_output[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH];
+  short fc1_output[FC1_NBOUTPUT];
+
+  Conv1_28x28x1_5x5x20_1_0(input, CONV1_KERNEL, CONV1_BIAS, conv1_output);
+  Pool1_24x24x20_2x2x20_2_0(conv1_output, pool1_output);
+
+  if (quant == QUANT_FC1_CONV2_POW2)
+    Conv2_12x12x20_5x5x40_1_0_pow2(pool1_output, CONV2_POW2, CONV2_BIAS, conv2_output);
+  else
+    Conv2_12x12x20_5x5x40_1_0(pool1_output, CONV2_KERNEL, CONV2_BIAS, conv2_output);
+
+  Pool2_8x8x40_2x2x40_2_0(conv2_output, pool2_output);
+
+  switch (quant)
+  {
+  case QUANT_FC1_TERNARY:
+    Fc1_40_400_ternary(pool2_output, FC1_TERNARY, FC1_TERNARY_SCALE, FC1_BIAS, fc1_output);
+    break;
+  case QUANT_FC1_POW2:
+  case QUANT_FC1_CONV2_POW2:
+    Fc1_40_400_pow2(pool2_output, FC1_POW2, FC1_BIAS, fc1_output);
+    break;
+  default:
+    Fc1_40_400(pool2_output, FC1_KERNEL, FC1_BIAS, fc1_output);
+  }
+
+  Fc2_400_10(fc1_output, FC2_KERNEL, FC2_BIAS, output);
+}
+
+int main(int argc, char *argv[])
+{
+  unsigned char (*images)[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char labels[NB_TEST_IMAGES];
+  short fc2_output[FC2_NBOUTPUT];
+  float softmax_output[FC2_NBOUTPUT];
+  unsigned int error, fc1_bytes;
+  int m, nb_images, max_images, quant;
+  double baseline_rate, rate, tstart, tdiff;
+
+  max_images = NB_TEST_IMAGES;
+  if (argc > 1)
+    max_images = atoi(argv[1]);
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  images = malloc(sizeof(*images) * max_images);
+  if (!images)
+  {
+    printf("Error: Unable to allocate %d images.\n", max_images);
+    exit(1);
+  }
+
+  printf("\nLoading test set \n");
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+
+  QuantizeFc1Ternary(FC1_KERNEL, FC1_TERNARY, FC1_TERNARY_SCALE);
+  QuantizeFc1Pow2(FC1_KERNEL, FC1_POW2);
+  QuantizeConv2Pow2(CONV2_KERNEL, CONV2_POW2);
+
+  baseline_rate = (1 - ((double)BASELINE_ERRORS / NB_TEST_IMAGES)) * 100;
+  printf("\n%d images, baseline %.2f%% (%d / %d errors)\n\n", nb_images, baseline_rate, BASELINE_ERRORS, NB_TEST_IMAGES);
+  printf("%-26s %12s %14s %10s %10s %10s\n", "configuration", "FC1 bytes", "errors", "success", "delta", "time (s)");
+
+  for (quant = 0; quant < QUANT_NB; quant++)
+  {
+    error = 0;
+    tstart = TimeNow();
+    for (m = 0; m < nb_images; m++)
+    {
+      lenet_cnn_quant(quant, images[m], fc2_output);
+      Softmax(fc2_output, softmax_output);
+      if (ClassifySoftmax(softmax_output) != labels[m])
+        error++;
+    }
+    tdiff = TimeNow() - tstart;
+
+    if (quant == QUANT_FC1_TERNARY)
+      fc1_bytes = sizeof(FC1_TERNARY) + sizeof(FC1_TERNARY_SCALE);
+    else if (quant == QUANT_NONE)
+      fc1_bytes = sizeof(FC1_KERNEL);
+    else
+      fc1_bytes = sizeof(FC1_POW2);
+
+    rate = (1 - ((double)error / nb_images)) * 100;
+    printf("%-26s %12u %8u / %-5d %9.2f%% %+9.2f%% %10.3f\n", quant_names[quant], fc1_bytes, error, nb_images, rate, rate - baseline_rate, tdiff);
+  }
+
+  printf("\nConv2 weights: %u bytes (short), %u bytes (pow2)\n\n", (unsigned int)sizeof(CONV2_KERNEL), (unsigned int)sizeof(CONV2_POW2));
+
+  free(images);
+
+  return 0;
+}
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file    ref_names.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Prefixes every function of a sibling copy of the network (../FLOAT,
+  *          ../FIXED_POINT_NO_HDF5_PRAGMA_SDSOC) with REF_PREFIX, so that it links
+  *          next to this one. Sibling sources are compiled with
+  *          -include ref_names.h -DREF_PREFIX=Float_
+  */
+
+#ifndef REF_PREFIX
+#error "REF_PREFIX must be defined before including ref_names.h"
+#endif
+
+#define REF_CAT2(a, b)  a##b
+#define REF_CAT(a, b)   REF_CAT2(a, b)
+
+#define Conv1_28x28x1_5x5x20_1_0    REF_CAT(REF_PREFIX, Conv1_28x28x1_5x5x20_1_0)
+#define Pool1_24x24x20_2x2x20_2_0   REF_CAT(REF_PREFIX, Pool1_24x24x20_2x2x20_2_0)
+#define Conv2_12x12x20_5x5x40_1_0   REF_CAT(REF_PREFIX, Conv2_12x12x20_5x5x40_1_0)
+#define Pool2_8x8x40_2x2x40_2_0     REF_CAT(REF_PREFIX, Pool2_8x8x40_2x2x40_2_0)
+#define Fc1_40_400                  REF_CAT(REF_PREFIX, Fc1_40_400)
+#define Fc2_400_10                  REF_CAT(REF_PREFIX, Fc2_400_10)
+#define Softmax                     REF_CAT(REF_PREFIX, Softmax)
+#define sumProduct                  REF_CAT(REF_PREFIX, sumProduct)
+#define maxPooling                  REF_CAT(REF_PREFIX, maxPooling)
+
+#define ReadPgmFile                 REF_CAT(REF_PREFIX, ReadPgmFile)
+#define WritePgmFile                REF_CAT(REF_PREFIX, WritePgmFile)
+#define ReadTestLabels              REF_CAT(REF_PREFIX, ReadTestLabels)
+#define RescaleImg                  REF_CAT(REF_PREFIX, RescaleImg)
+#define NormalizeImg                REF_CAT(REF_PREFIX, NormalizeImg)
+#define WriteWeights                REF_CAT(REF_PREFIX, WriteWeights)
+#define ReadConv1Weights            REF_CAT(REF_PREFIX, ReadConv1Weights)
+#define ReadConv1Bias               REF_CAT(REF_PREFIX, ReadConv1Bias)
+#define ReadConv2Weights            REF_CAT(REF_PREFIX, ReadConv2Weights)
+#define ReadConv2Bias               REF_CAT(REF_PREFIX, ReadConv2Bias)
+#define ReadFc1Weights              REF_CAT(REF_PREFIX, ReadFc1Weights)
+#define ReadFc1Bias                 REF_CAT(REF_PREFIX, ReadFc1Bias)
+#define ReadFc2Weights              REF_CAT(REF_PREFIX, ReadFc2Weights)
+#define ReadFc2Bias                 REF_CAT(REF_PREFIX, ReadFc2Bias)
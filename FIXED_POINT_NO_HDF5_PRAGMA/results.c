@@ -0,0 +1,213 @@
+/**
+  ******************************************************************************
+  * @file    results.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Quiet mode of the evaluators (results.h)
+  * @brief   The log grows by doubling, so ResultsNext is a store in the
+  *          common case. The progress thread sleeps on a condition variable
+  *          (CLOCK_MONOTONIC) so that ProgressStop does not wait for the end
+  *          of an interval.
+  */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "results.h"
+
+#define RESULTS_CAPACITY    16384           // records, the 10000 test images fit
+#define RESULTS_BUFFER      (1 << 20)       // stdio buffer of the result file
+
+struct result_log {
+  result_record *records;
+  unsigned int count, capacity;
+};
+
+struct result_progress {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  int running;
+  double interval;
+  atomic_uint done, errors;
+};
+
+result_log *ResultsCreate(void)
+{
+  result_log *log;
+
+  log = malloc(sizeof(result_log));
+  if (log)
+    log->records = malloc(sizeof(result_record) * RESULTS_CAPACITY);
+  if (!log || !log->records)
+  {
+    printf("Error: Unable to allocate the result log.\n");
+    exit(1);
+  }
+  log->count = 0;
+  log->capacity = RESULTS_CAPACITY;
+  return log;
+}
+
+void ResultsDestroy(result_log *log)
+{
+  free(log->records);
+  free(log);
+}
+
+result_record *ResultsNext(result_log *log)
+{
+  result_record *record;
+
+  if (log->count == log->capacity)
+  {
+    log->capacity *= 2;
+    log->records = realloc(log->records, sizeof(result_record) * log->capacity);
+    if (!log->records)
+    {
+      printf("Error: Unable to grow the result log to %u records.\n", log->capacity);
+      exit(1);
+    }
+  }
+  record = &log->records[log->count];
+  memset(record, 0, sizeof(result_record));
+  record->index = log->count++;
+  return record;
+}
+
+void ResultsWrite(result_log *log, char *filename, int binary)
+{
+  result_header header;
+  result_record *record;
+  FILE *file;
+  unsigned int i;
+  int k;
+
+  file = fopen(filename, binary ? "wb" : "w");
+  if (!file)
+  {
+    printf("Error: Unable to open file %s.\n", filename);
+    exit(1);
+  }
+  setvbuf(file, NULL, _IOFBF, RESULTS_BUFFER);
+
+  if (binary)
+  {
+    memcpy(header.magic, RESULTS_MAGIC, sizeof(header.magic));
+    header.version = RESULTS_VERSION;
+    header.nb_logits = RESULTS_NBLOGITS;
+    header.record_size = sizeof(result_record);
+    header.count = log->count;
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite(log->records, sizeof(result_record), log->count, file);
+  }
+  else
+  {
+    fprintf(file, "index,label,predicted,latency_ns");
+    for (k = 0; k < RESULTS_NBLOGITS; k++)
+      fprintf(file, ",logit%d", k);
+    fprintf(file, "\n");
+    for (i = 0; i < log->count; i++)
+    {
+      record = &log->records[i];
+      fprintf(file, "%u,%u,%u,%llu", record->index, record->label, record->predicted, record->latency);
+      // %.9g round-trips a float
+      for (k = 0; k < RESULTS_NBLOGITS; k++)
+        fprintf(file, ",%.9g", record->logits[k]);
+      fprintf(file, "\n");
+    }
+  }
+
+  if (ferror(file) | fclose(file))
+  {
+    printf("Error: Unable to write file %s.\n", filename);
+    exit(1);
+  }
+}
+
+static double MonotonicNow(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void *ProgressThread(void *arg)
+{
+  result_progress *progress;
+  struct timespec deadline;
+  double start, next, now;
+  unsigned int done, errors;
+
+  progress = arg;
+  start = MonotonicNow();
+  next = start + progress->interval;
+  pthread_mutex_lock(&progress->lock);
+  while (progress->running)
+  {
+    deadline.tv_sec = (time_t)next;
+    deadline.tv_nsec = (long)((next - deadline.tv_sec) * 1000000000);
+    if (pthread_cond_timedwait(&progress->wake, &progress->lock, &deadline) != ETIMEDOUT)
+      continue;
+    now = MonotonicNow();
+    next = now + progress->interval;
+    done = atomic_load_explicit(&progress->done, memory_order_relaxed);
+    errors = atomic_load_explicit(&progress->errors, memory_order_relaxed);
+    fprintf(stderr, "%u images, %u errors, %.0f images/s\n", done, errors, done / (now - start));
+  }
+  pthread_mutex_unlock(&progress->lock);
+  return NULL;
+}
+
+result_progress *ProgressStart(double interval)
+{
+  result_progress *progress;
+  pthread_condattr_t attr;
+
+  progress = malloc(sizeof(result_progress));
+  if (!progress)
+  {
+    printf("Error: Unable to allocate the progress thread.\n");
+    exit(1);
+  }
+  pthread_mutex_init(&progress->lock, NULL);
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(&progress->wake, &attr);
+  pthread_condattr_destroy(&attr);
+  progress->running = 1;
+  progress->interval = interval;
+  atomic_init(&progress->done, 0);
+  atomic_init(&progress->errors, 0);
+  if (pthread_create(&progress->thread, NULL, ProgressThread, progress))
+  {
+    printf("Error: Unable to start the progress thread.\n");
+    exit(1);
+  }
+  return progress;
+}
+
+void ProgressUpdate(result_progress *progress, unsigned int done, unsigned int errors)
+{
+  atomic_store_explicit(&progress->errors, errors, memory_order_relaxed);
+  atomic_store_explicit(&progress->done, done, memory_order_relaxed);
+}
+
+void ProgressStop(result_progress *progress)
+{
+  pthread_mutex_lock(&progress->lock);
+  progress->running = 0;
+  pthread_cond_signal(&progress->wake);
+  pthread_mutex_unlock(&progress->lock);
+  pthread_join(progress->thread, NULL);
+  pthread_mutex_destroy(&progress->lock);
+  pthread_cond_destroy(&progress->wake);
+  free(progress);
+}
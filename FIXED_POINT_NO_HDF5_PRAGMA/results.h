@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file    results.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Quiet mode of the evaluators: buffered result file and progress thread
+  * @brief   The timed loop fills one result_record per image in memory, and
+  *          the whole log is written at the end in one buffered pass, as CSV
+  *          or as a binary file (result_header then the records as is).
+  *          Progress is printed on stderr by a separate thread at most once
+  *          per interval; the loop only stores two counters and never waits
+  *          on the terminal. Also used by the FLOAT evaluator (FLOAT/Makefile).
+  */
+
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#define RESULTS_NBLOGITS    10              // FC2_NBOUTPUT of both trees
+#define RESULTS_MAGIC       "LENETRES"
+#define RESULTS_VERSION     1
+
+// binary file header, 24 bytes
+typedef struct {
+  char magic[8];                            // RESULTS_MAGIC, not 0 terminated
+  unsigned int version;
+  unsigned int nb_logits;
+  unsigned int record_size;                 // sizeof(result_record)
+  unsigned int count;
+} result_header;
+
+// one image, 56 bytes with no padding
+typedef struct {
+  unsigned long long latency;               // ns, image load to softmax
+  float logits[RESULTS_NBLOGITS];           // FC2 output, fixed point values unscaled
+  unsigned int index;
+  unsigned char label, predicted;
+  unsigned short reserved;
+} result_record;
+
+typedef struct result_log result_log;
+typedef struct result_progress result_progress;
+
+result_log *ResultsCreate(void);
+void ResultsDestroy(result_log *log);
+// record of the next image, index set, the other fields are filled by the caller
+result_record *ResultsNext(result_log *log);
+void ResultsWrite(result_log *log, char *filename, int binary);
+
+// prints every interval seconds until ProgressStop
+result_progress *ProgressStart(double interval);
+void ProgressUpdate(result_progress *progress, unsigned int done, unsigned int errors);
+void ProgressStop(result_progress *progress);
+
+#endif
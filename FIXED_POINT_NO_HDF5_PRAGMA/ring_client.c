@@ -0,0 +1,152 @@
+/**
+  ******************************************************************************
+  * @file    ring_client.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Producer process of the shared memory ring of lenet_server -r
+  * @brief   usage: ./ring_client [-r ring_name] [-w window] [-R rounds] [-n max_images]
+  *          Writes the test images straight into the ring slots (as a capture
+  *          process would write its frames), keeps up to window of them in
+  *          flight and reads the results in place. Errors are counted on the
+  *          first round; images/s and round trip percentiles cover all rounds.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+#include "lenet_cnn_float.h"
+#include "shm_ring.h"
+
+#define RESULT_TIMEOUT  1000    // ms without results before checking that the server is still there
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-r ring_name] [-w window] [-R rounds] [-n max_images]\n", program);
+}
+
+static int CompareDouble(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+
+  return x < y ? -1 : x > y;
+}
+
+int main(int argc, char *argv[])
+{
+  static unsigned char images[NB_TEST_IMAGES][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  static unsigned char labels[NB_TEST_IMAGES];
+  shm_ring ring;
+  ring_header *header;
+  char *ring_name;
+  double *submitted, *latency;
+  unsigned long long total, sent, received;
+  uint32_t head, done, tail, mask;
+  unsigned int error;
+  int opt, window, rounds, nb_images, max_images, spin;
+  double tstart, tdiff;
+
+  ring_name = RING_DEFAULT_NAME;
+  window = 0;
+  rounds = 1;
+  max_images = NB_TEST_IMAGES;
+  while ((opt = getopt(argc, argv, "r:w:R:n:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'r': ring_name = optarg; break;
+    case 'w': window = atoi(optarg); break;
+    case 'R': rounds = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (rounds < 1)
+    rounds = 1;
+  spin = RingSpin();
+  if (max_images <= 0 || max_images > NB_TEST_IMAGES)
+    max_images = NB_TEST_IMAGES;
+
+  if (RingAttach(&ring, ring_name) < 0)
+  {
+    printf("Error: Unable to attach ring %s (is lenet_server -r running?).\n", ring_name);
+    exit(1);
+  }
+  header = ring.header;
+  mask = header->nb_slots - 1;
+  if (window < 1 || window > (int)header->nb_slots)
+    window = header->nb_slots;
+
+  nb_images = LoadTestSet("mnist/t10k-labels-idx1-ubyte", images, labels, max_images);
+  total = (unsigned long long)nb_images * rounds;
+  submitted = malloc(sizeof(double) * header->nb_slots);
+  latency = malloc(sizeof(double) * total);
+  if (!submitted || !latency)
+  {
+    printf("Error: Unable to allocate %llu latencies.\n", total);
+    exit(1);
+  }
+
+  // a previous producer may have left images in flight
+  head = atomic_load(&header->head.value);
+  while ((done = atomic_load(&header->done.value)) != head && !atomic_load(&header->stop))
+    RingWait(&header->done, done, spin, RESULT_TIMEOUT);
+  tail = head;
+  RingPost(&header->tail, tail);
+
+  error = 0;
+  sent = 0;
+  received = 0;
+  tstart = TimeNow();
+  while (received < total)
+  {
+    // fill the window, then publish the whole burst at once
+    if (sent < total && head - tail < (uint32_t)window)
+    {
+      while (sent < total && head - tail < (uint32_t)window)
+      {
+        memcpy(ring.pixels[head & mask], images[sent % nb_images], LENET_PIXELS);
+        submitted[head & mask] = TimeNow();
+        head++;
+        sent++;
+      }
+      RingPost(&header->head, head);
+    }
+
+    done = RingWait(&header->done, tail, spin, RESULT_TIMEOUT);
+    if (done == tail && atomic_load(&header->stop))
+    {
+      printf("Error: Server stopped with %llu images in flight.\n", sent - received);
+      exit(1);
+    }
+    tdiff = TimeNow();
+    for (; tail != done; tail++, received++)
+    {
+      latency[received] = (tdiff - submitted[tail & mask]) * 1000000;
+      if (received < (unsigned long long)nb_images && ring.results[tail & mask].label != labels[received])
+        error = error + 1;
+    }
+    atomic_store_explicit(&header->tail.value, tail, memory_order_release);
+  }
+  tdiff = TimeNow() - tstart;
+
+  qsort(latency, total, sizeof(double), CompareDouble);
+  printf("\n%llu images (%d rounds) through %s, window %d: %f s, %.1f images/s\n", total, rounds, ring_name,
+         window, tdiff, total / tdiff);
+  printf("Round trip: p50 %.1f us, p90 %.1f us, p99 %.1f us, max %.1f us\n", latency[total / 2],
+         latency[total * 90 / 100], latency[total * 99 / 100], latency[total - 1]);
+  printf("\n\nErrors : %d / %d", error, nb_images);
+  printf("\n\nSuccess rate = %f%%", (1 - ((float)error / nb_images)) * 100);
+  printf("\n\n");
+
+  free(submitted);
+  free(latency);
+  RingDetach(&ring);
+
+  return 0;
+}
@@ -0,0 +1,230 @@
+/**
+  ******************************************************************************
+  * @file    roofline.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Roofline report of the fixed point and FLOAT layers
+  * @brief   usage: ./roofline [-c cpu] [-w warmup_samples] [-r samples] [-o csv_file]
+  *          MACs and bytes of every layer come from the shape macros of
+  *          lenet_cnn_float.h (bench.h cases); one MAC counts as 2 operations.
+  *          The roofs are measured on the pinned cpu with the same harness:
+  *          peak float and int16 multiply-add throughput with the vector width
+  *          of this build (-O3, no -march), and read bandwidth from memory
+  *          (64 MB buffer) and from cache (256 KB buffer). A layer whose bytes
+  *          (weights and activations) fit in CACHE_BYTES stays in cache from
+  *          one image to the next and is bound by min(peak, intensity * cache
+  *          bandwidth), a larger one (FC1, 512 KB of weights) by the memory
+  *          bandwidth; the table shows the roof and how far each layer is from
+  *          its bound (above 100% when the last level cache holds more than
+  *          CACHE_BYTES), the csv file holds the roofs and points for plotting
+  *          (gnuplot, matplotlib).
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define PEAK_ACCS           12          // independent accumulators, enough to hide the add latency
+#define PEAK_ITERATIONS     1024
+#define MEMORY_BYTES        (64 << 20)
+#define CACHE_BYTES         (256 << 10)
+
+typedef float vfloat __attribute__((vector_size(16)));
+typedef unsigned short vshort __attribute__((vector_size(16)));
+typedef unsigned int vuint __attribute__((vector_size(16)));
+
+static vfloat PEAK_FLOAT[PEAK_ACCS];
+static vshort PEAK_SHORT[PEAK_ACCS];
+static vuint *BW_BUFFER;
+static size_t BW_VECTORS;
+static vuint BW_SUM;
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-c cpu] [-w warmup_samples] [-r samples] [-o csv_file]\n", program);
+}
+
+static void PeakFloat(void)
+{
+  vfloat acc[PEAK_ACCS], mul, add;
+  int i, a;
+
+  mul = (vfloat){ 0.999999f, 0.999999f, 0.999999f, 0.999999f };
+  add = (vfloat){ 1e-6f, 1e-6f, 1e-6f, 1e-6f };
+  for (a = 0; a < PEAK_ACCS; a++)
+    acc[a] = PEAK_FLOAT[a];
+  for (i = 0; i < PEAK_ITERATIONS; i++)
+    for (a = 0; a < PEAK_ACCS; a++)
+      acc[a] = acc[a] * mul + add;
+  for (a = 0; a < PEAK_ACCS; a++)
+    PEAK_FLOAT[a] = acc[a];
+}
+
+static void PeakShort(void)
+{
+  vshort acc[PEAK_ACCS], mul, add;
+  int i, a;
+
+  mul = (vshort){ 3, 3, 3, 3, 3, 3, 3, 3 };
+  add = (vshort){ 1, 1, 1, 1, 1, 1, 1, 1 };
+  for (a = 0; a < PEAK_ACCS; a++)
+    acc[a] = PEAK_SHORT[a];
+  for (i = 0; i < PEAK_ITERATIONS; i++)
+    for (a = 0; a < PEAK_ACCS; a++)
+      acc[a] = acc[a] * mul + add;
+  for (a = 0; a < PEAK_ACCS; a++)
+    PEAK_SHORT[a] = acc[a];
+}
+
+static void ReadBandwidth(void)
+{
+  vuint sum0, sum1, sum2, sum3;
+  size_t k;
+
+  sum0 = sum1 = sum2 = sum3 = BW_SUM;
+  for (k = 0; k < BW_VECTORS; k += 4)
+  {
+    sum0 += BW_BUFFER[k];
+    sum1 += BW_BUFFER[k + 1];
+    sum2 += BW_BUFFER[k + 2];
+    sum3 += BW_BUFFER[k + 3];
+  }
+  BW_SUM = sum0 + sum1 + sum2 + sum3;
+}
+
+// median throughput of one call in units per ns (G units/s)
+static double Measure(bench_call call, double units, int warmup, int nb_samples)
+{
+  bench_case bench;
+  double median, min;
+
+  memset(&bench, 0, sizeof(bench));
+  bench.call = call;
+  BenchRun(&bench, warmup, nb_samples, &median, &min);
+  return units / median;
+}
+
+static double MeasureBandwidth(size_t bytes, int warmup, int nb_samples)
+{
+  BW_VECTORS = bytes / sizeof(vuint);
+  return Measure(ReadBandwidth, bytes, warmup, nb_samples);
+}
+
+int main(int argc, char *argv[])
+{
+  bench_case cases[MAX_BENCH_CASES];
+  double median, min, peak_float, peak_short, memory_bw, cache_bw, peak, bandwidth, intensity, measured, bound, fraction, worst;
+  char *csv_filename, *roof;
+  FILE *csv;
+  int opt, cpu, warmup, nb_samples, nb_cases, k, worst_case;
+
+  cpu = sched_getcpu();
+  warmup = BENCH_WARMUP;
+  nb_samples = BENCH_SAMPLES;
+  csv_filename = "roofline.csv";
+  while ((opt = getopt(argc, argv, "c:w:r:o:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'c': cpu = atoi(optarg); break;
+    case 'w': warmup = atoi(optarg); break;
+    case 'r': nb_samples = atoi(optarg); break;
+    case 'o': csv_filename = optarg; break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_samples < 1 || nb_samples > BENCH_MAX_SAMPLES)
+    nb_samples = BENCH_SAMPLES;
+  if (warmup < 0)
+    warmup = 0;
+
+  BenchPin(cpu);
+
+  BW_BUFFER = aligned_alloc(64, MEMORY_BYTES);
+  if (!BW_BUFFER)
+  {
+    printf("Error: Unable to allocate %d bytes.\n", MEMORY_BYTES);
+    exit(1);
+  }
+  memset(BW_BUFFER, 1, MEMORY_BYTES);
+
+  peak_float = Measure(PeakFloat, 2.0 * PEAK_ITERATIONS * PEAK_ACCS * 4, warmup, nb_samples);
+  peak_short = Measure(PeakShort, 2.0 * PEAK_ITERATIONS * PEAK_ACCS * 8, warmup, nb_samples);
+  memory_bw = MeasureBandwidth(MEMORY_BYTES, warmup, nb_samples);
+  cache_bw = MeasureBandwidth(CACHE_BYTES, warmup, nb_samples);
+  free(BW_BUFFER);
+
+  printf("cpu %d: peak float %.2f Gop/s, peak int16 %.2f Gop/s, memory %.2f GB/s, cache %.2f GB/s\n", cpu, peak_float,
+         peak_short, memory_bw, cache_bw);
+  printf("ridge points: float %.2f op/B (cache) %.2f op/B (memory), int16 %.2f op/B (cache) %.2f op/B (memory)\n\n",
+         peak_float / cache_bw, peak_float / memory_bw, peak_short / cache_bw, peak_short / memory_bw);
+
+  csv = fopen(csv_filename, "w");
+  if (!csv)
+  {
+    printf("Error: Unable to open file %s.\n", csv_filename);
+    exit(1);
+  }
+  fprintf(csv, "kind,tree,layer,intensity_op_per_byte,gops,gbs,bound_gops,roof\n");
+  fprintf(csv, "roof,float,peak,,%f,,,\nroof,fixed,peak,,%f,,,\n", peak_float, peak_short);
+  fprintf(csv, "roof,,memory,,,%f,,\nroof,,cache,,,%f,,\n", memory_bw, cache_bw);
+
+  nb_cases = FixedBenchCases(cases);
+  nb_cases += FloatBenchCases(cases + nb_cases);
+
+  printf("%-6s %-26s %10s %10s %8s %9s %9s %-6s %9s %7s\n", "tree", "layer", "MACs", "bytes", "op/B", "Gop/s", "GB/s",
+         "roof", "bound", "% bound");
+  worst = 0;
+  worst_case = -1;
+  for (k = 0; k < nb_cases; k++)
+  {
+    BenchRun(&cases[k], warmup, nb_samples, &median, &min);
+    peak = strcmp(cases[k].tree, "float") ? peak_short : peak_float;
+    intensity = 2 * cases[k].macs / cases[k].bytes;
+    measured = 2 * cases[k].macs / median;
+
+    // the bandwidth roof of the level that holds the working set of the layer
+    roof = cases[k].bytes <= CACHE_BYTES ? "cache" : "memory";
+    bandwidth = cases[k].bytes <= CACHE_BYTES ? cache_bw : memory_bw;
+
+    // pooling and softmax have no MAC: against the bandwidth only, left out of the ranking
+    if (cases[k].macs)
+    {
+      bound = intensity * bandwidth < peak ? intensity * bandwidth : peak;
+      fraction = measured / bound;
+      if (worst_case < 0 || fraction < worst)
+      {
+        worst = fraction;
+        worst_case = k;
+      }
+      printf("%-6s %-26s %10.0f %10.0f %8.2f %9.2f %9.2f %-6s %9.2f %6.1f%%\n", cases[k].tree, cases[k].layer,
+             cases[k].macs, cases[k].bytes, intensity, measured, cases[k].bytes / median,
+             intensity * bandwidth < peak ? roof : "peak", bound, 100 * fraction);
+    }
+    else
+    {
+      bound = bandwidth;
+      fraction = cases[k].bytes / median / bandwidth;
+      printf("%-6s %-26s %10s %10.0f %8s %9s %9.2f %-6s %9.2f %6.1f%%\n", cases[k].tree, cases[k].layer, "-",
+             cases[k].bytes, "-", "-", cases[k].bytes / median, roof, bound, 100 * fraction);
+    }
+    fprintf(csv, "point,%s,%s,%f,%f,%f,%f,%s\n", cases[k].tree, cases[k].layer, intensity, measured,
+            cases[k].bytes / median, cases[k].macs ? bound : 0, roof);
+  }
+  fclose(csv);
+
+  if (worst_case >= 0)
+    printf("\nMAC layer furthest from its bound: %s %s (%.1f%%)\n", cases[worst_case].tree, cases[worst_case].layer,
+           100 * worst);
+  printf("plot data written to %s\n\n", csv_filename);
+
+  return 0;
+}
@@ -0,0 +1,267 @@
+/**
+  ******************************************************************************
+  * @file    scan.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Fully convolutional LeNet over an image of any size (scan.h)
+  * @brief   Same fixed point arithmetic as conv.c / pool.c / fc.c, layer by
+  *          layer: int accumulation, shift by FIXED_POINT, short outputs and
+  *          the activation tests of the original layers. The loops run one
+  *          kernel weight at a time over a whole output plane, so that the
+  *          inner loop walks contiguous rows of any width.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lenet_cnn_float.h"
+#include "scan.h"
+
+struct lenet_scan {
+  int width, height;
+  int conv1_width, conv1_height;
+  int pool1_width, pool1_height;
+  int conv2_width, conv2_height;
+  int pool2_width, pool2_height;
+  int map_width, map_height;      // FC1 / FC2 outputs, one per window
+  short *conv1_output;            // [CONV1_NBOUTPUT][conv1_height][conv1_width]
+  short *pool1_output;
+  short *conv2_output;
+  short *pool2_output;
+  short *fc1_output;              // [FC1_NBOUTPUT][map_height][map_width]
+  int *sum;                       // one output plane of int accumulators
+};
+
+static void *ScanAlloc(size_t size)
+{
+  void *buffer;
+
+  buffer = malloc(size);
+  if (!buffer)
+  {
+    printf("Error: Unable to allocate %zu bytes for the scan.\n", size);
+    exit(1);
+  }
+  return buffer;
+}
+
+lenet_scan *ScanCreate(int width, int height)
+{
+  lenet_scan *scan;
+
+  if (width < IMG_WIDTH || height < IMG_HEIGHT)
+  {
+    printf("Error: Scanned image %dx%d smaller than %dx%d.\n", width, height, IMG_WIDTH, IMG_HEIGHT);
+    exit(1);
+  }
+  scan = ScanAlloc(sizeof(lenet_scan));
+  scan->width = width;
+  scan->height = height;
+  scan->conv1_width = width - CONV1_DIM + 1;
+  scan->conv1_height = height - CONV1_DIM + 1;
+  scan->pool1_width = scan->conv1_width / POOL1_STRIDE;
+  scan->pool1_height = scan->conv1_height / POOL1_STRIDE;
+  scan->conv2_width = scan->pool1_width - CONV2_DIM + 1;
+  scan->conv2_height = scan->pool1_height - CONV2_DIM + 1;
+  scan->pool2_width = scan->conv2_width / POOL2_STRIDE;
+  scan->pool2_height = scan->conv2_height / POOL2_STRIDE;
+  scan->map_width = scan->pool2_width - POOL2_WIDTH + 1;
+  scan->map_height = scan->pool2_height - POOL2_HEIGHT + 1;
+
+  scan->conv1_output = ScanAlloc(sizeof(short) * CONV1_NBOUTPUT * scan->conv1_height * scan->conv1_width);
+  scan->pool1_output = ScanAlloc(sizeof(short) * POOL1_NBOUTPUT * scan->pool1_height * scan->pool1_width);
+  scan->conv2_output = ScanAlloc(sizeof(short) * CONV2_NBOUTPUT * scan->conv2_height * scan->conv2_width);
+  scan->pool2_output = ScanAlloc(sizeof(short) * POOL2_NBOUTPUT * scan->pool2_height * scan->pool2_width);
+  scan->fc1_output = ScanAlloc(sizeof(short) * FC1_NBOUTPUT * scan->map_height * scan->map_width);
+  // Conv1 has the largest output plane
+  scan->sum = ScanAlloc(sizeof(int) * scan->conv1_height * scan->conv1_width);
+  return scan;
+}
+
+void ScanDestroy(lenet_scan *scan)
+{
+  free(scan->conv1_output);
+  free(scan->pool1_output);
+  free(scan->conv2_output);
+  free(scan->pool2_output);
+  free(scan->fc1_output);
+  free(scan->sum);
+  free(scan);
+}
+
+void ScanMapSize(lenet_scan *scan, int *map_width, int *map_height)
+{
+  *map_width = scan->map_width;
+  *map_height = scan->map_height;
+}
+
+// sum[y][x] += weight * input[y + dy][x + dx] over an output plane
+static void AccumulateChar(int *sum, int width, int height, const unsigned char *input, int input_width, short weight)
+{
+  const unsigned char *row;
+  int *out;
+  int x, y;
+
+  for (y = 0; y < height; y++)
+  {
+    row = input + y * input_width;
+    out = sum + y * width;
+    for (x = 0; x < width; x++)
+      out[x] += weight * row[x];
+  }
+}
+
+static void AccumulateShort(int *sum, int width, int height, const short *input, int input_width, short weight)
+{
+  const short *row;
+  int *out;
+  int x, y;
+
+  for (y = 0; y < height; y++)
+  {
+    row = input + y * input_width;
+    out = sum + y * width;
+    for (x = 0; x < width; x++)
+      out[x] += weight * row[x];
+  }
+}
+
+// 2x2 max pooling of every channel, stride 2
+static void ScanPool(const short *input, int channels, int input_width, int input_height,  // IN
+                     short *output, int width, int height)                                  // OUT
+{
+  const short *in;
+  short max;
+  int c, x, y;
+
+  for (c = 0; c < channels; c++)
+  {
+    in = input + c * input_height * input_width;
+    for (y = 0; y < height; y++)
+      for (x = 0; x < width; x++)
+      {
+        max = in[2 * y * input_width + 2 * x];
+        if (max < in[(2 * y + 1) * input_width + 2 * x]) max = in[(2 * y + 1) * input_width + 2 * x];
+        if (max < in[2 * y * input_width + 2 * x + 1]) max = in[2 * y * input_width + 2 * x + 1];
+        if (max < in[(2 * y + 1) * input_width + 2 * x + 1]) max = in[(2 * y + 1) * input_width + 2 * x + 1];
+        output[(c * height + y) * width + x] = max;
+      }
+  }
+}
+
+static void ScanConv1(lenet_scan *scan, const unsigned char *image)
+{
+  short *out;
+  int o, ky, kx, k, size;
+
+  size = scan->conv1_height * scan->conv1_width;
+  for (o = 0; o < CONV1_NBOUTPUT; o++)
+  {
+    memset(scan->sum, 0, sizeof(int) * size);
+    for (ky = 0; ky < CONV1_DIM; ky++)
+      for (kx = 0; kx < CONV1_DIM; kx++)
+        AccumulateChar(scan->sum, scan->conv1_width, scan->conv1_height, image + ky * scan->width + kx, scan->width,
+                       CONV1_KERNEL[o][0][ky][kx]);
+
+    // neuron activation, as Conv1_28x28x1_5x5x20_1_0
+    out = scan->conv1_output + o * size;
+    for (k = 0; k < size; k++)
+      out[k] = scan->sum[k] + CONV1_BIAS[o] <= 0 ? 0 : (scan->sum[k] >> FIXED_POINT) + CONV1_BIAS[o];
+  }
+}
+
+static void ScanConv2(lenet_scan *scan)
+{
+  const short *in;
+  short *out;
+  int f, d, ky, kx, k, size, input_size;
+
+  size = scan->conv2_height * scan->conv2_width;
+  input_size = scan->pool1_height * scan->pool1_width;
+  for (f = 0; f < CONV2_NBOUTPUT; f++)
+  {
+    out = scan->conv2_output + f * size;
+    for (d = 0; d < POOL1_NBOUTPUT; d++)
+    {
+      in = scan->pool1_output + d * input_size;
+      memset(scan->sum, 0, sizeof(int) * size);
+      for (ky = 0; ky < CONV2_DIM; ky++)
+        for (kx = 0; kx < CONV2_DIM; kx++)
+          AccumulateShort(scan->sum, scan->conv2_width, scan->conv2_height, in + ky * scan->pool1_width + kx,
+                          scan->pool1_width, CONV2_KERNEL[f][d][ky][kx]);
+
+      // shifted per input channel and summed in short, as Conv2_12x12x20_5x5x40_1_0
+      for (k = 0; k < size; k++)
+        out[k] = d == 0 ? scan->sum[k] >> FIXED_POINT : out[k] + (scan->sum[k] >> FIXED_POINT);
+    }
+    for (k = 0; k < size; k++)
+      out[k] = out[k] + CONV2_BIAS[f] <= 0 ? 0 : out[k] + CONV2_BIAS[f];
+  }
+}
+
+// FC1 as a POOL2_HEIGHT x POOL2_WIDTH convolution of the Pool2 map
+static void ScanFc1(lenet_scan *scan)
+{
+  const short *in;
+  short *out, fc_sum;
+  int o, d, ky, kx, k, size, input_size;
+
+  size = scan->map_height * scan->map_width;
+  input_size = scan->pool2_height * scan->pool2_width;
+  for (o = 0; o < FC1_NBOUTPUT; o++)
+  {
+    memset(scan->sum, 0, sizeof(int) * size);
+    for (d = 0; d < POOL2_NBOUTPUT; d++)
+    {
+      in = scan->pool2_output + d * input_size;
+      for (ky = 0; ky < POOL2_HEIGHT; ky++)
+        for (kx = 0; kx < POOL2_WIDTH; kx++)
+          AccumulateShort(scan->sum, scan->map_width, scan->map_height, in + ky * scan->pool2_width + kx,
+                          scan->pool2_width, FC1_KERNEL[o][d][ky][kx]);
+    }
+
+    // neuron activation, as Fc1_40_400
+    out = scan->fc1_output + o * size;
+    for (k = 0; k < size; k++)
+    {
+      fc_sum = scan->sum[k] >> FIXED_POINT;
+      out[k] = fc_sum + FC1_BIAS[o] <= 0 ? 0 : fc_sum + FC1_BIAS[o];
+    }
+  }
+}
+
+// FC2 as a 1x1 convolution of the FC1 map
+static void ScanFc2(lenet_scan *scan, short *scores)
+{
+  short fc_sum;
+  int c, o, k, size;
+
+  size = scan->map_height * scan->map_width;
+  for (c = 0; c < FC2_NBOUTPUT; c++)
+  {
+    memset(scan->sum, 0, sizeof(int) * size);
+    for (o = 0; o < FC1_NBOUTPUT; o++)
+      AccumulateShort(scan->sum, size, 1, scan->fc1_output + o * size, size, FC2_KERNEL[c][o]);
+    for (k = 0; k < size; k++)
+    {
+      fc_sum = scan->sum[k] >> FIXED_POINT;
+      scores[c * size + k] = fc_sum + FC2_BIAS[c];
+    }
+  }
+}
+
+void lenet_cnn_scan(lenet_scan *scan,
+                    const unsigned char *image,   // IN [height][width]
+                    short *scores)                // OUT [FC2_NBOUTPUT][map_height][map_width]
+{
+  ScanConv1(scan, image);
+  ScanPool(scan->conv1_output, CONV1_NBOUTPUT, scan->conv1_width, scan->conv1_height, scan->pool1_output,
+           scan->pool1_width, scan->pool1_height);
+  ScanConv2(scan);
+  ScanPool(scan->conv2_output, CONV2_NBOUTPUT, scan->conv2_width, scan->conv2_height, scan->pool2_output,
+           scan->pool2_width, scan->pool2_height);
+  ScanFc1(scan);
+  ScanFc2(scan, scores);
+}
@@ -0,0 +1,34 @@
+/**
+  ******************************************************************************
+  * @file    scan.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Fully convolutional LeNet: dense class scores over an image of any size
+  * @brief   Conv1 / Pool1 / Conv2 / Pool2 run once over the whole image, FC1 is
+  *          applied as a 4x4 convolution of the Pool2 map and FC2 as a 1x1
+  *          convolution, giving the FC2 output of every 28x28 window at a
+  *          stride of SCAN_STRIDE pixels. Windows at multiples of the stride
+  *          line up with both pooling grids, so each score is bit-exact with
+  *          lenet_cnn() on the same crop, while the convolutions of
+  *          overlapping windows are computed once.
+  */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#define SCAN_STRIDE     (POOL1_STRIDE * POOL2_STRIDE)   // 4 pixels between windows
+
+typedef struct lenet_scan lenet_scan;
+
+// buffers for width x height images, at least IMG_WIDTH x IMG_HEIGHT
+lenet_scan *ScanCreate(int width, int height);
+void ScanDestroy(lenet_scan *scan);
+void ScanMapSize(lenet_scan *scan, int *map_width, int *map_height);  // OUT
+
+// scores[c][y][x]: FC2 output for class c of the window at (SCAN_STRIDE * x, SCAN_STRIDE * y)
+void lenet_cnn_scan(lenet_scan *scan,
+                    const unsigned char *image,   // IN [height][width]
+                    short *scores);               // OUT [FC2_NBOUTPUT][map_height][map_width]
+
+#endif
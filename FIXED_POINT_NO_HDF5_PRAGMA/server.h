@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file    server.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Binary protocol of the inference daemon (lenet_server.c, lenet_client.c)
+  * @brief   Stream of fixed size messages over a Unix domain socket, host byte order.
+  *          A request is an srv_header followed, for SRV_INFER, by LENET_PIXELS
+  *          bytes. Every request is answered by an srv_reply with the same id;
+  *          for SRV_STATS the reply is followed by a 32-bit length and that
+  *          many bytes of text. Replies of one connection may be sent in any
+  *          order when the server runs several workers. An SRV_INFER request
+  *          arriving on a full queue is answered SRV_EBUSY without logits and
+  *          may be sent again; a connection that leaves its replies unread is
+  *          closed by the server.
+  */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+
+#include "lenet.h"
+
+#define SRV_DEFAULT_SOCKET  "/tmp/lenet.sock"
+#define SRV_DEFAULT_BATCH   32          // images per lenet_infer_batch call
+#define SRV_DEFAULT_WAIT    500         // us a request may wait for its batch to fill
+#define SRV_MAX_BATCH       256
+
+enum { SRV_INFER = 1, SRV_STATS = 2, SRV_SHUTDOWN = 3 };
+enum { SRV_OK = 0, SRV_EBADREQ = 1, SRV_EBUSY = 2 };
+
+typedef struct {
+  uint8_t type;
+  uint8_t reserved[3];
+  uint32_t id;                          // chosen by the client, echoed in the reply
+} srv_header;
+
+typedef struct {
+  uint32_t id;
+  uint8_t status;
+  uint8_t label;
+  uint8_t reserved[2];
+  int16_t logits[LENET_NB_CLASSES];     // fixed point, as lenet_result
+} srv_reply;
+
+_Static_assert(sizeof(srv_header) == 8, "srv_header layout");
+_Static_assert(sizeof(srv_reply) == 28, "srv_reply layout");
+
+#endif
@@ -0,0 +1,429 @@
+/**
+  ******************************************************************************
+  * @file    shard_eval.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Multi-process sharded evaluation with shared memory results
+  * @brief   usage: ./shard_eval [-w workers] [-e engine[,engine...]] [-k chunk] [-n max_images]
+  *                              [-l labels_file] [-p image_pattern] [-c crash_image]
+  *          The launcher forks the workers; they claim chunks of image indexes
+  *          from an atomic counter in an anonymous shared mapping and write the
+  *          errors, confusion matrix and latency histogram of every chunk they
+  *          complete. Worker w runs engine w modulo the -e list (engine.c); the
+  *          engines are initialized by the launcher before the fork. When a
+  *          worker dies, its unfinished chunk is given back (up to MAX_ATTEMPTS
+  *          times) and a replacement is forked (up to MAX_RESTARTS times per
+  *          worker), so only completed chunks are merged. A worker that dies
+  *          holding no chunk did not fail on an image: the run is aborted.
+  *          -c makes the first attempt at that image crash, for testing.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "lenet_cnn_float.h"
+#include "engine.h"
+#include "workers.h"
+
+#define MAX_SHARD_WORKERS   64
+#define MAX_SHARD_ENGINES   8
+#define DEFAULT_CHUNK       64
+#define MAX_ATTEMPTS        3
+#define MAX_RESTARTS        3       // replacements forked per worker slot
+#define HIST_BUCKETS        64      // 4 buckets per octave of microseconds
+#define HIST_PER_OCTAVE     4
+
+// CHUNK_NEW chunks are only claimed through next_chunk, CHUNK_FREE ones were given back
+enum { CHUNK_NEW, CHUNK_FREE, CHUNK_CLAIMED, CHUNK_DONE, CHUNK_FAILED };
+
+// state, owner and number of claims of a chunk change together in one word
+#define CLAIM(state, worker, attempts)  ((unsigned int)(attempts) << 16 | (unsigned int)(worker) << 8 | (state))
+#define CLAIM_STATE(claim)              ((claim) & 0xff)
+#define CLAIM_WORKER(claim)             ((int)((claim) >> 8 & 0xff))
+#define CLAIM_ATTEMPTS(claim)           ((int)((claim) >> 16))
+
+typedef struct {
+  _Atomic unsigned int claim;   // CLAIM(state, last claimer, claims so far)
+  int engine;                   // index in the -e list of the worker that completed it
+  unsigned int images;
+  unsigned int errors;
+  unsigned int confusion[FC2_NBOUTPUT][FC2_NBOUTPUT];   // [label][predicted]
+  unsigned int histogram[HIST_BUCKETS];
+} shard_chunk;
+
+typedef struct {
+  _Atomic int next_chunk;       // first chunk never claimed
+  int nb_chunks;
+  int chunk_size;
+  int nb_images;
+  shard_chunk chunks[];
+} shard_shared;
+
+typedef struct {
+  char *labels_filename;
+  char *image_pattern;
+  unsigned char *labels;
+  int crash_image;
+  char *engine_names[MAX_SHARD_ENGINES];
+  lenet_engine *engines[MAX_SHARD_ENGINES];
+  int nb_engines;
+} shard_config;
+
+static const double percentiles[] = { 50, 90, 99, 99.9 };
+
+static void Usage(char *program)
+{
+  printf("usage: %s [-w workers] [-e engine[,engine...]] [-k chunk] [-n max_images]\n", program);
+  printf("       %*s [-l labels_file] [-p image_pattern] [-c crash_image]\n\n", (int)strlen(program), "");
+  printf("engines:\n");
+  ListEngines();
+}
+
+static int LatencyBucket(double us)
+{
+  int bucket;
+
+  if (us < 1)
+    return 0;
+  bucket = (int)(log2(us) * HIST_PER_OCTAVE);
+  return bucket >= HIST_BUCKETS ? HIST_BUCKETS - 1 : bucket;
+}
+
+// upper bound of a bucket in microseconds
+static double BucketLimit(int bucket)
+{
+  return pow(2, (double)(bucket + 1) / HIST_PER_OCTAVE);
+}
+
+// claims chunk c if it is in state from, returns the claims so far or 0
+static int TryClaim(shard_chunk *chunk, int from, int worker)
+{
+  unsigned int expected;
+
+  expected = atomic_load(&chunk->claim);
+  while (CLAIM_STATE(expected) == (unsigned int)from)
+    if (atomic_compare_exchange_weak(&chunk->claim, &expected,
+                                     CLAIM(CHUNK_CLAIMED, worker, CLAIM_ATTEMPTS(expected) + 1)))
+      return CLAIM_ATTEMPTS(expected) + 1;
+  return 0;
+}
+
+// fresh chunks first, then chunks given back after a crash
+static int ClaimChunk(shard_shared *shared, int worker, int *attempts)
+{
+  int c;
+
+  // a fresh chunk swept to CHUNK_FREE by the launcher meanwhile is claimed below
+  while ((c = atomic_fetch_add(&shared->next_chunk, 1)) < shared->nb_chunks)
+    if ((*attempts = TryClaim(&shared->chunks[c], CHUNK_NEW, worker)))
+      return c;
+
+  for (c = 0; c < shared->nb_chunks; c++)
+    if ((*attempts = TryClaim(&shared->chunks[c], CHUNK_FREE, worker)))
+      return c;
+  return -1;
+}
+
+static void WorkerProcess(shard_shared *shared, shard_config *config, int worker)
+{
+  unsigned char ref_img[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  unsigned char input_norm[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  float logits[FC2_NBOUTPUT];
+  char img_filename[256];
+  shard_chunk *chunk, result;
+  lenet_engine *engine;
+  unsigned char number;
+  int c, m, first, last, engine_index, attempts;
+  double tstart;
+
+  engine_index = worker % config->nb_engines;
+  engine = config->engines[engine_index];
+
+  while ((c = ClaimChunk(shared, worker, &attempts)) >= 0) {
+    chunk = &shared->chunks[c];
+    first = c * shared->chunk_size;
+    last = first + shared->chunk_size < shared->nb_images ? first + shared->chunk_size : shared->nb_images;
+
+    // results are built locally and published with the state, a crash leaves nothing behind
+    memset(&result, 0, sizeof(result));
+    for (m = first; m < last; m++) {
+      if (m == config->crash_image && attempts == 1)
+        abort();
+
+      tstart = TimeNow();
+      sprintf(img_filename, config->image_pattern, m);
+      ReadPgmFile(img_filename, (unsigned char *)ref_img);
+      NormalizeImg((unsigned char *)ref_img, (unsigned char *)input_norm, IMG_WIDTH, IMG_WIDTH);
+      number = engine->run(input_norm, logits, NULL);
+
+      result.histogram[LatencyBucket((TimeNow() - tstart) * 1000000)]++;
+      result.confusion[config->labels[m]][number]++;
+      if (number != config->labels[m])
+        result.errors++;
+      result.images++;
+    }
+
+    chunk->engine = engine_index;
+    chunk->images = result.images;
+    chunk->errors = result.errors;
+    memcpy(chunk->confusion, result.confusion, sizeof(result.confusion));
+    memcpy(chunk->histogram, result.histogram, sizeof(result.histogram));
+    atomic_store(&chunk->claim, CLAIM(CHUNK_DONE, worker, attempts));
+  }
+}
+
+static pid_t SpawnWorker(shard_shared *shared, shard_config *config, int worker)
+{
+  pid_t pid;
+
+  fflush(stdout);
+  pid = fork();
+  if (pid == 0) {
+    WorkerProcess(shared, config, worker);
+    _exit(0);
+  }
+  return pid;
+}
+
+int main(int argc, char *argv[])
+{
+  static shard_config config;
+  shard_shared *shared;
+  shard_chunk *chunk;
+  pid_t pids[MAX_SHARD_WORKERS], pid;
+  int restarts[MAX_SHARD_WORKERS];
+  unsigned int confusion[FC2_NBOUTPUT][FC2_NBOUTPUT], histogram[HIST_BUCKETS];
+  unsigned int engine_images[MAX_SHARD_ENGINES], engine_errors[MAX_SHARD_ENGINES];
+  unsigned int images, errors, failed_images, crashes, retried, claim;
+  size_t shared_size;
+  char *engine_list, *name;
+  int opt, status, w, c, e, k, p, nb_workers, chunk_size, live, max_images, nb_images, held, aborted, fresh;
+  unsigned long long count, target;
+  double tstart, tdiff;
+
+  nb_workers = DefaultWorkers();
+  engine_list = NULL;
+  chunk_size = DEFAULT_CHUNK;
+  max_images = 0;
+  config.labels_filename = "mnist/t10k-labels-idx1-ubyte";
+  config.image_pattern = "mnist/t10k-images-idx3-ubyte[%05d].pgm";
+  config.crash_image = -1;
+  while ((opt = getopt(argc, argv, "w:e:k:n:l:p:c:h")) != -1)
+  {
+    switch (opt)
+    {
+    case 'w': nb_workers = atoi(optarg); break;
+    case 'e': engine_list = strdup(optarg); break;
+    case 'k': chunk_size = atoi(optarg); break;
+    case 'n': max_images = atoi(optarg); break;
+    case 'l': config.labels_filename = optarg; break;
+    case 'p': config.image_pattern = optarg; break;
+    case 'c': config.crash_image = atoi(optarg); break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  if (nb_workers < 1 || nb_workers > MAX_SHARD_WORKERS)
+    nb_workers = DefaultWorkers();
+  if (chunk_size < 1)
+    chunk_size = DEFAULT_CHUNK;
+
+  if (!engine_list)
+    engine_list = strdup("fixed");
+  for (name = strtok(engine_list, ","); name && config.nb_engines < MAX_SHARD_ENGINES; name = strtok(NULL, ","))
+  {
+    // initialized here so that a failing init stops the launcher, not every worker it forks
+    config.engines[config.nb_engines] = FindEngine(name);
+    if (!config.engines[config.nb_engines])
+    {
+      printf("Error: Unknown engine %s.\n\n", name);
+      Usage(argv[0]);
+      return 2;
+    }
+    config.engine_names[config.nb_engines++] = name;
+  }
+
+  // labels are read once, the workers inherit them
+  if (max_images <= 0)
+    max_images = 1 << 24;
+  config.labels = malloc(max_images);
+  if (!config.labels)
+  {
+    printf("Error: Unable to allocate %d labels.\n", max_images);
+    exit(1);
+  }
+  nb_images = ReadLabels(config.labels_filename, config.labels, max_images);
+
+  shared_size = sizeof(shard_shared) + sizeof(shard_chunk) * ((nb_images + chunk_size - 1) / chunk_size);
+  shared = mmap(NULL, shared_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (shared == MAP_FAILED)
+  {
+    printf("Error: Unable to map %zu bytes of shared memory.\n", shared_size);
+    exit(1);
+  }
+  shared->nb_chunks = (nb_images + chunk_size - 1) / chunk_size;
+  shared->chunk_size = chunk_size;
+  shared->nb_images = nb_images;
+
+  printf("\n%d images, %d chunks of %d, %d worker processes\n", nb_images, shared->nb_chunks, chunk_size, nb_workers);
+
+  tstart = TimeNow();
+  for (w = 0; w < nb_workers; w++)
+  {
+    pids[w] = SpawnWorker(shared, &config, w);
+    restarts[w] = 0;
+  }
+  live = nb_workers;
+  crashes = 0;
+  retried = 0;
+  aborted = 0;
+
+  while (live > 0)
+  {
+    pid = wait(&status);
+    if (pid < 0)
+      break;
+    for (w = 0; w < nb_workers && pids[w] != pid; w++);
+    if (w == nb_workers)
+      continue;
+    live--;
+    pids[w] = 0;
+    if ((WIFEXITED(status) && WEXITSTATUS(status) == 0) || aborted)
+      continue;
+
+    crashes++;
+    printf("Worker %d (%s, pid %d) %s %d, ", w, config.engine_names[w % config.nb_engines], pid,
+           WIFSIGNALED(status) ? "killed by signal" : "exited with", WIFSIGNALED(status) ? WTERMSIG(status) : WEXITSTATUS(status));
+
+    // give back what it was working on; the owner is in the same word as the state
+    held = 0;
+    for (c = 0; c < shared->nb_chunks; c++)
+    {
+      chunk = &shared->chunks[c];
+      claim = atomic_load(&chunk->claim);
+      if (CLAIM_STATE(claim) != CHUNK_CLAIMED || CLAIM_WORKER(claim) != w)
+        continue;
+      held++;
+      if (CLAIM_ATTEMPTS(claim) >= MAX_ATTEMPTS)
+      {
+        atomic_store(&chunk->claim, CLAIM(CHUNK_FAILED, w, CLAIM_ATTEMPTS(claim)));
+        printf("chunk %d failed %d times, dropped, ", c, MAX_ATTEMPTS);
+      }
+      else
+      {
+        atomic_store(&chunk->claim, CLAIM(CHUNK_FREE, w, CLAIM_ATTEMPTS(claim)));
+        retried++;
+        printf("chunk %d given back, ", c);
+      }
+    }
+
+    // fresh chunks taken from next_chunk but never marked claimed: the worker died in between
+    fresh = atomic_load(&shared->next_chunk);
+    for (c = 0; c < shared->nb_chunks && c < fresh; c++)
+    {
+      claim = CLAIM(CHUNK_NEW, 0, 0);
+      if (atomic_compare_exchange_strong(&shared->chunks[c].claim, &claim, CLAIM(CHUNK_FREE, 0, 0)))
+      {
+        held++;
+        printf("chunk %d never started, given back, ", c);
+      }
+    }
+
+    if (!held)
+    {
+      // it did not fail on an image (engine, environment): a replacement would fail the same way
+      printf("no chunk held, aborting\n");
+      aborted = 1;
+      for (k = 0; k < nb_workers; k++)
+        if (pids[k] > 0)
+          kill(pids[k], SIGKILL);
+    }
+    else if (restarts[w] == MAX_RESTARTS)
+      printf("restarted %d times, not restarted\n", MAX_RESTARTS);
+    else
+    {
+      pids[w] = SpawnWorker(shared, &config, w);
+      restarts[w]++;
+      live++;
+      printf("restarted\n");
+    }
+  }
+  tdiff = TimeNow() - tstart;
+
+  // merge in chunk order
+  memset(confusion, 0, sizeof(confusion));
+  memset(histogram, 0, sizeof(histogram));
+  memset(engine_images, 0, sizeof(engine_images));
+  memset(engine_errors, 0, sizeof(engine_errors));
+  images = 0;
+  errors = 0;
+  failed_images = 0;
+  for (c = 0; c < shared->nb_chunks; c++)
+  {
+    chunk = &shared->chunks[c];
+    if (CLAIM_STATE(atomic_load(&chunk->claim)) != CHUNK_DONE)
+    {
+      failed_images += (c + 1) * chunk_size < nb_images ? chunk_size : nb_images - c * chunk_size;
+      continue;
+    }
+    images += chunk->images;
+    errors += chunk->errors;
+    engine_images[chunk->engine] += chunk->images;
+    engine_errors[chunk->engine] += chunk->errors;
+    for (e = 0; e < FC2_NBOUTPUT; e++)
+      for (k = 0; k < FC2_NBOUTPUT; k++)
+        confusion[e][k] += chunk->confusion[e][k];
+    for (k = 0; k < HIST_BUCKETS; k++)
+      histogram[k] += chunk->histogram[k];
+  }
+
+  printf("\nTOTAL PROCESSING TIME: %f s, %.1f images/s, %u worker crashes, %u chunks retried, %u images lost%s\n",
+         tdiff, images / tdiff, crashes, retried, failed_images, aborted ? ", aborted" : "");
+
+  printf("\n%-12s %10s %14s\n", "engine", "images", "errors");
+  for (e = 0; e < config.nb_engines; e++)
+    printf("%-12s %10u %8u / %-5u\n", config.engine_names[e], engine_images[e], engine_errors[e], engine_images[e]);
+
+  printf("\nConfusion matrix (rows: label, columns: predicted)\n     ");
+  for (k = 0; k < FC2_NBOUTPUT; k++)
+    printf("%6d", k);
+  printf("\n");
+  for (e = 0; e < FC2_NBOUTPUT; e++)
+  {
+    printf("%4d ", e);
+    for (k = 0; k < FC2_NBOUTPUT; k++)
+      printf("%6u", confusion[e][k]);
+    printf("\n");
+  }
+
+  // percentiles as bucket upper bounds
+  printf("\nLatency per image (I/O + inference), upper bounds:");
+  count = 0;
+  k = 0;
+  for (p = 0; p < (int)(sizeof(percentiles) / sizeof(percentiles[0])); p++)
+  {
+    target = (unsigned long long)ceil(images * percentiles[p] / 100);
+    while (k < HIST_BUCKETS - 1 && count + histogram[k] < target)
+      count += histogram[k++];
+    printf(" p%g %.0f us", percentiles[p], BucketLimit(k));
+  }
+
+  printf("\n\nErrors : %d / %d", errors, images);
+  printf("\n\nSuccess rate = %f%%", images ? (1 - ((float)errors / images)) * 100 : 0);
+  printf("\n\n");
+
+  munmap(shared, shared_size);
+  free(config.labels);
+  free(engine_list);
+
+  return failed_images || aborted ? 1 : 0;
+}
@@ -0,0 +1,137 @@
+/**
+  ******************************************************************************
+  * @file    shm_ring.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Shared memory ring: mapping and cross-process futex signalling
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "workers.h"
+#include "shm_ring.h"
+
+#define RING_ALIGN      4096
+
+static size_t RingSize(int nb_slots, size_t *pixels_offset, size_t *results_offset)
+{
+  *pixels_offset = RING_ALIGN;
+  *results_offset = *pixels_offset + (((size_t)nb_slots * LENET_PIXELS + RING_ALIGN - 1) & ~(size_t)(RING_ALIGN - 1));
+  return *results_offset + (((size_t)nb_slots * sizeof(lenet_result) + RING_ALIGN - 1) & ~(size_t)(RING_ALIGN - 1));
+}
+
+static int RingMap(shm_ring *ring, int fd, int nb_slots)
+{
+  size_t pixels_offset, results_offset;
+  unsigned char *base;
+
+  ring->size = RingSize(nb_slots, &pixels_offset, &results_offset);
+  base = mmap(NULL, ring->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED)
+    return -1;
+  ring->header = (ring_header *)base;
+  ring->pixels = (unsigned char (*)[LENET_PIXELS])(base + pixels_offset);
+  ring->results = (lenet_result *)(base + results_offset);
+  return 0;
+}
+
+int RingCreate(shm_ring *ring, const char *name, int nb_slots)
+{
+  size_t pixels_offset, results_offset;
+  int fd, ret;
+
+  if (nb_slots < 1 || (nb_slots & (nb_slots - 1)))
+    return -1;
+
+  shm_unlink(name);
+  fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0)
+    return -1;
+  ret = ftruncate(fd, RingSize(nb_slots, &pixels_offset, &results_offset));
+  if (ret == 0)
+    ret = RingMap(ring, fd, nb_slots);
+  close(fd);
+  if (ret < 0)
+  {
+    shm_unlink(name);
+    return -1;
+  }
+
+  // ftruncate zeroed the counters; the magic is written last
+  ring->header->nb_slots = nb_slots;
+  atomic_store(&ring->header->stop, 0);
+  atomic_thread_fence(memory_order_release);
+  ring->header->magic = RING_MAGIC;
+  return 0;
+}
+
+int RingAttach(shm_ring *ring, const char *name)
+{
+  ring_header header;
+  int fd, ret;
+
+  fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0)
+    return -1;
+  ret = -1;
+  if (pread(fd, &header, sizeof(header), 0) == sizeof(header) && header.magic == RING_MAGIC && header.nb_slots > 0)
+    ret = RingMap(ring, fd, header.nb_slots);
+  close(fd);
+  return ret;
+}
+
+void RingDetach(shm_ring *ring)
+{
+  if (ring->header)
+    munmap(ring->header, ring->size);
+  ring->header = NULL;
+}
+
+int RingSpin(void)
+{
+  return sysconf(_SC_NPROCESSORS_ONLN) > 1 ? RING_DEFAULT_SPIN : 0;
+}
+
+uint32_t RingWait(ring_signal *signal, uint32_t seen, int spin, int timeout_ms)
+{
+  struct timespec timeout;
+  uint32_t value;
+  int i;
+
+  for (i = 0; i < spin; i++)
+  {
+    value = atomic_load_explicit(&signal->value, memory_order_acquire);
+    if (value != seen)
+      return value;
+    CPU_RELAX();
+  }
+
+  // shared (not private) futex: the poster is another process
+  timeout.tv_sec = timeout_ms / 1000;
+  timeout.tv_nsec = (long)(timeout_ms % 1000) * 1000000;
+  atomic_fetch_add(&signal->sleepers, 1);
+  value = atomic_load(&signal->value);
+  if (value == seen)
+    syscall(SYS_futex, (uint32_t *)&signal->value, FUTEX_WAIT, seen, timeout_ms ? &timeout : NULL, NULL, 0);
+  atomic_fetch_sub(&signal->sleepers, 1);
+
+  return atomic_load_explicit(&signal->value, memory_order_acquire);
+}
+
+void RingPost(ring_signal *signal, uint32_t value)
+{
+  atomic_store_explicit(&signal->value, value, memory_order_seq_cst);
+  if (atomic_load(&signal->sleepers) > 0)
+    syscall(SYS_futex, (uint32_t *)&signal->value, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    shm_ring.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Shared memory ring of 28x28 input slots and result slots between
+  *          one producer process and the inference daemon (lenet_server -r)
+  * @brief   Three free running counters, each written by one side only:
+  *          head (images submitted by the producer), done (results written by
+  *          the server) and tail (results consumed by the producer). Slot k of
+  *          image i is i % nb_slots: the producer writes the pixels in place,
+  *          the server reads them in place with lenet_infer_batch and writes the
+  *          lenet_result in place. Waiting spins, then sleeps on a futex of the
+  *          counter, woken only when the other side has announced a sleeper.
+  */
+
+#ifndef SHM_RING_H
+#define SHM_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lenet.h"
+
+#define RING_DEFAULT_NAME   "/lenet_ring"
+#define RING_DEFAULT_SLOTS  1024        // power of two
+#define RING_DEFAULT_SPIN   20000       // polls before sleeping, when there is a cpu for the other side
+#define RING_MAGIC          0x4c4e5231  // "LNR1"
+
+// counter one side waits on
+typedef struct {
+  _Atomic uint32_t value;
+  _Atomic int32_t sleepers;
+} __attribute__((aligned(64))) ring_signal;
+
+typedef struct {
+  uint32_t magic;
+  uint32_t nb_slots;
+  _Atomic uint32_t stop;        // set by the server when it leaves
+  ring_signal head;
+  ring_signal done;
+  ring_signal tail;
+} ring_header;
+
+typedef struct {
+  ring_header *header;
+  unsigned char (*pixels)[LENET_PIXELS];    // nb_slots, contiguous so that batches are read in place
+  lenet_result *results;                    // nb_slots
+  size_t size;
+} shm_ring;
+
+// server side: creates (or recreates) the shared memory object, -1 on error
+int RingCreate(shm_ring *ring, const char *name, int nb_slots);
+// producer side: maps a ring created by the server, -1 on error
+int RingAttach(shm_ring *ring, const char *name);
+void RingDetach(shm_ring *ring);
+
+// RING_DEFAULT_SPIN, 0 on a single cpu where spinning only delays the other side
+int RingSpin(void);
+
+// value of the counter once it differs from seen; may return seen unchanged
+// after timeout_ms (0 for no timeout) or a spurious wake-up
+uint32_t RingWait(ring_signal *signal, uint32_t seen, int spin, int timeout_ms);
+// publishes a new value and wakes the sleepers of the other side
+void RingPost(ring_signal *signal, uint32_t value);
+
+#endif
@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    sparse.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Magnitude pruning of FC1 and compressed sparse row (CSR) FC1 layer
+  * @brief   The FC1 weights of this tree fit in int8 (|w| <= 28), so an entry
+  *          is an int8 weight and a uint8 delta to the previous column: 2 bytes
+  *          per kept weight against 2 bytes per weight for the dense short
+  *          kernel, plus the 4 byte row pointers.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lenet_cnn_float.h"
+
+#define MAX_COL_DELTA   255
+
+// weights with |w| <= threshold are dropped, threshold 0 keeps every non-zero weight
+// returns the number of weights kept, row_ptr[FC1_NBOUTPUT] is the number of entries
+unsigned int PruneFc1(  short           kernel[FC1_NBOUTPUT][POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],   // IN
+                        short           threshold,                                                          // IN
+                        unsigned int    row_ptr[FC1_NBOUTPUT+1],                                            // OUT
+                        unsigned char   col_delta[FC1_MAX_ENTRIES],                                         // OUT
+                        signed char     values[FC1_MAX_ENTRIES])                                            // OUT
+{
+  unsigned short o, i, col;
+  unsigned int nnz, entries;
+  short *weights;
+
+  nnz = 0;
+  entries = 0;
+  for (o = 0; o < FC1_NBOUTPUT; o++) {
+    row_ptr[o] = entries;
+    weights = &kernel[o][0][0][0];
+    col = 0;
+    for (i = 0; i < FC1_NBINPUT; i++) {
+      if (weights[i] <= threshold && weights[i] >= -threshold)
+        continue;
+      if (weights[i] > 127 || weights[i] < -128) {
+        printf("Error: FC1 weight %d of neuron %d does not fit in int8.\n", weights[i], o);
+        exit(1);
+      }
+      // zero weight entries over the gaps that do not fit in a delta
+      while (i - col > MAX_COL_DELTA) {
+        col_delta[entries] = MAX_COL_DELTA;
+        values[entries] = 0;
+        col += MAX_COL_DELTA;
+        entries++;
+      }
+      col_delta[entries] = i - col;
+      values[entries] = weights[i];
+      col = i;
+      entries++;
+      nnz++;
+    }
+  }
+  row_ptr[FC1_NBOUTPUT] = entries;
+
+  return nnz;
+}
+
+void Fc1_40_400_csr(    short           input[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH],  // IN
+                        unsigned int    row_ptr[FC1_NBOUTPUT+1],                            // IN
+                        unsigned char   col_delta[FC1_MAX_ENTRIES],                         // IN
+                        signed char     values[FC1_MAX_ENTRIES],                            // IN
+                        short           bias[FC1_NBOUTPUT],                                 // IN
+                        short           output[FC1_NBOUTPUT])                               // OUT
+{
+  unsigned short o;
+  unsigned int k, end;
+  short *in, *in1, *in2, *in3, fc_sum;
+  int temp_sum, sum1, sum2, sum3;
+
+  for (o = 0; o < FC1_NBOUTPUT; o++) { // 400
+    temp_sum = 0;
+    sum1 = 0;
+    sum2 = 0;
+    sum3 = 0;
+
+    // only the weights kept by the pruning, 4 entries per iteration in independent sums
+    in = &input[0][0][0];
+    end = row_ptr[o+1];
+    for (k = row_ptr[o]; k + 4 <= end; k += 4) {
+      in1 = in + col_delta[k];
+      in2 = in1 + col_delta[k+1];
+      in3 = in2 + col_delta[k+2];
+      in = in3 + col_delta[k+3];
+      temp_sum = temp_sum + *in1 * values[k];
+      sum1 = sum1 + *in2 * values[k+1];
+      sum2 = sum2 + *in3 * values[k+2];
+      sum3 = sum3 + *in * values[k+3];
+    }
+    for (; k < end; k++) {
+      in += col_delta[k];
+      temp_sum = temp_sum + *in * values[k];
+    }
+    temp_sum = temp_sum + sum1 + sum2 + sum3;
+
+    // shifting back after matrix*kernel multiplication
+    fc_sum = temp_sum >> FIXED_POINT;
+
+    // neuron activation
+    if (fc_sum + bias[o] <= 0) {
+      output[o] = 0;
+    } else {
+      output[o] = fc_sum + bias[o];
+    }
+  }
+}
@@ -0,0 +1,332 @@
+/**
+  ******************************************************************************
+  * @file    stream.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Incremental inference of a stream of frames (stream.h)
+  * @brief   Every layer keeps its int sums before the shift (Conv2 one per
+  *          input channel, since conv.c shifts each channel before summing).
+  *          A changed value adds its difference times its weights to the sums
+  *          of the outputs reading it, and marks them dirty; only the dirty
+  *          outputs are then rebuilt from their sums, with the fixed point
+  *          arithmetic of conv.c / pool.c / fc.c.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lenet_cnn_float.h"
+#include "stream.h"
+
+struct lenet_stream {
+  int valid;                                            // previous frame computed
+  unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
+  lenet_scratch scratch;                                // activations of the previous frame
+  // sums output channel last, the channels updated by one input value are contiguous
+  int conv1_sum[CONV1_HEIGHT][CONV1_WIDTH][CONV1_NBOUTPUT];
+  int conv2_sum[POOL1_NBOUTPUT][CONV2_HEIGHT][CONV2_WIDTH][CONV2_NBOUTPUT];
+  int fc1_sum[FC1_NBOUTPUT];
+  int fc2_sum[FC2_NBOUTPUT];
+  short output[FC2_NBOUTPUT];
+  // kernels transposed the same way
+  short conv1_kernel[CONV1_DIM][CONV1_DIM][CONV1_NBOUTPUT];
+  short conv2_kernel[POOL1_NBOUTPUT][CONV2_DIM][CONV2_DIM][CONV2_NBOUTPUT];
+  short fc1_kernel[POOL2_NBOUTPUT][POOL2_HEIGHT][POOL2_WIDTH][FC1_NBOUTPUT];
+  stream_stats stats;
+};
+
+lenet_stream *StreamCreate(void)
+{
+  lenet_stream *stream;
+  int o, f, d, h, w;
+
+  stream = calloc(1, sizeof(lenet_stream));
+  if (!stream)
+  {
+    printf("Error: Unable to allocate the stream.\n");
+    exit(1);
+  }
+  for (o = 0; o < CONV1_NBOUTPUT; o++)
+    for (h = 0; h < CONV1_DIM; h++)
+      for (w = 0; w < CONV1_DIM; w++)
+        stream->conv1_kernel[h][w][o] = CONV1_KERNEL[o][0][h][w];
+  for (f = 0; f < CONV2_NBOUTPUT; f++)
+    for (d = 0; d < POOL1_NBOUTPUT; d++)
+      for (h = 0; h < CONV2_DIM; h++)
+        for (w = 0; w < CONV2_DIM; w++)
+          stream->conv2_kernel[d][h][w][f] = CONV2_KERNEL[f][d][h][w];
+  for (o = 0; o < FC1_NBOUTPUT; o++)
+    for (d = 0; d < POOL2_NBOUTPUT; d++)
+      for (h = 0; h < POOL2_HEIGHT; h++)
+        for (w = 0; w < POOL2_WIDTH; w++)
+          stream->fc1_kernel[d][h][w][o] = FC1_KERNEL[o][d][h][w];
+  return stream;
+}
+
+void StreamDestroy(lenet_stream *stream)
+{
+  free(stream);
+}
+
+void StreamReset(lenet_stream *stream)
+{
+  stream->valid = 0;
+}
+
+void StreamStats(lenet_stream *stream, stream_stats *stats)
+{
+  *stats = stream->stats;
+}
+
+// neuron activations from the sums, as the layers of conv.c and fc.c
+static void Conv1Output(lenet_stream *stream, int y, int x)
+{
+  int o, sum;
+
+  for (o = 0; o < CONV1_NBOUTPUT; o++)
+  {
+    sum = stream->conv1_sum[y][x][o];
+    stream->scratch.conv1_output[o][y][x] = sum + CONV1_BIAS[o] <= 0 ? 0 : (sum >> FIXED_POINT) + CONV1_BIAS[o];
+  }
+}
+
+static void Conv2Output(lenet_stream *stream, int y, int x)
+{
+  short out[CONV2_NBOUTPUT];
+  int f, d;
+
+  // shifted per input channel and summed in short, as Conv2_12x12x20_5x5x40_1_0
+  for (f = 0; f < CONV2_NBOUTPUT; f++)
+    out[f] = stream->conv2_sum[0][y][x][f] >> FIXED_POINT;
+  for (d = 1; d < POOL1_NBOUTPUT; d++)
+    for (f = 0; f < CONV2_NBOUTPUT; f++)
+      out[f] = out[f] + (stream->conv2_sum[d][y][x][f] >> FIXED_POINT);
+  for (f = 0; f < CONV2_NBOUTPUT; f++)
+    stream->scratch.conv2_output[f][y][x] = out[f] + CONV2_BIAS[f] <= 0 ? 0 : out[f] + CONV2_BIAS[f];
+}
+
+static short Fc1Output(int sum, short bias)
+{
+  short fc_sum;
+
+  fc_sum = sum >> FIXED_POINT;
+  return fc_sum + bias <= 0 ? 0 : fc_sum + bias;
+}
+
+static short Fc2Output(int sum, short bias)
+{
+  short fc_sum;
+
+  fc_sum = sum >> FIXED_POINT;
+  return fc_sum + bias;
+}
+
+static short Max4(short a, short b, short c, short d)
+{
+  short max;
+
+  max = a;
+  if (max < b) max = b;
+  if (max < c) max = c;
+  if (max < d) max = d;
+  return max;
+}
+
+static void FullFrame(lenet_stream *stream, unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH])
+{
+  lenet_scratch *s;
+  int o, f, d, c, y, x, ky, kx, sum;
+
+  s = &stream->scratch;
+  memcpy(stream->input, input, sizeof(stream->input));
+
+  for (o = 0; o < CONV1_NBOUTPUT; o++)
+    for (y = 0; y < CONV1_HEIGHT; y++)
+      for (x = 0; x < CONV1_WIDTH; x++)
+      {
+        sum = 0;
+        for (ky = 0; ky < CONV1_DIM; ky++)
+          for (kx = 0; kx < CONV1_DIM; kx++)
+            sum += stream->input[0][y + ky][x + kx] * CONV1_KERNEL[o][0][ky][kx];
+        stream->conv1_sum[y][x][o] = sum;
+      }
+  for (y = 0; y < CONV1_HEIGHT; y++)
+    for (x = 0; x < CONV1_WIDTH; x++)
+      Conv1Output(stream, y, x);
+  Pool1_24x24x20_2x2x20_2_0(s->conv1_output, s->pool1_output);
+
+  for (f = 0; f < CONV2_NBOUTPUT; f++)
+    for (d = 0; d < POOL1_NBOUTPUT; d++)
+      for (y = 0; y < CONV2_HEIGHT; y++)
+        for (x = 0; x < CONV2_WIDTH; x++)
+        {
+          sum = 0;
+          for (ky = 0; ky < CONV2_DIM; ky++)
+            for (kx = 0; kx < CONV2_DIM; kx++)
+              sum += s->pool1_output[d][y + ky][x + kx] * CONV2_KERNEL[f][d][ky][kx];
+          stream->conv2_sum[d][y][x][f] = sum;
+        }
+  for (y = 0; y < CONV2_HEIGHT; y++)
+    for (x = 0; x < CONV2_WIDTH; x++)
+      Conv2Output(stream, y, x);
+  Pool2_8x8x40_2x2x40_2_0(s->conv2_output, s->pool2_output);
+
+  for (o = 0; o < FC1_NBOUTPUT; o++)
+  {
+    stream->fc1_sum[o] = 0;
+    for (d = 0; d < POOL2_NBOUTPUT; d++)
+      for (y = 0; y < POOL2_HEIGHT; y++)
+        for (x = 0; x < POOL2_WIDTH; x++)
+          stream->fc1_sum[o] += s->pool2_output[d][y][x] * FC1_KERNEL[o][d][y][x];
+    s->fc1_output[o] = Fc1Output(stream->fc1_sum[o], FC1_BIAS[o]);
+  }
+  for (c = 0; c < FC2_NBOUTPUT; c++)
+  {
+    stream->fc2_sum[c] = 0;
+    for (o = 0; o < FC1_NBOUTPUT; o++)
+      stream->fc2_sum[c] += s->fc1_output[o] * FC2_KERNEL[c][o];
+    stream->output[c] = Fc2Output(stream->fc2_sum[c], FC2_BIAS[c]);
+  }
+  stream->valid = 1;
+  stream->stats.full++;
+}
+
+int lenet_cnn_stream(lenet_stream *stream,
+                     unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                     short output[FC2_NBOUTPUT])                             // OUT
+{
+  unsigned char conv1_dirty[CONV1_HEIGHT][CONV1_WIDTH];
+  unsigned char conv2_dirty[CONV2_HEIGHT][CONV2_WIDTH];
+  lenet_scratch *s;
+  short value, delta;
+  int changed, pool2_changed, y, x, oy, ox, y0, x0, c, o, f, d;
+
+  stream->stats.frames++;
+  if (!stream->valid)
+  {
+    FullFrame(stream, input);
+    memcpy(output, stream->output, sizeof(stream->output));
+    return IMG_HEIGHT * IMG_WIDTH;
+  }
+  s = &stream->scratch;
+
+  // each changed pixel updates the Conv1 sums of its receptive field
+  memset(conv1_dirty, 0, sizeof(conv1_dirty));
+  changed = 0;
+  for (y = 0; y < IMG_HEIGHT; y++)
+    for (x = 0; x < IMG_WIDTH; x++)
+    {
+      if (input[0][y][x] == stream->input[0][y][x])
+        continue;
+      delta = input[0][y][x] - stream->input[0][y][x];
+      stream->input[0][y][x] = input[0][y][x];
+      y0 = y < CONV1_DIM - 1 ? 0 : y - CONV1_DIM + 1;
+      x0 = x < CONV1_DIM - 1 ? 0 : x - CONV1_DIM + 1;
+      for (oy = y0; oy <= y && oy < CONV1_HEIGHT; oy++)
+        for (ox = x0; ox <= x && ox < CONV1_WIDTH; ox++)
+        {
+          for (o = 0; o < CONV1_NBOUTPUT; o++)
+            stream->conv1_sum[oy][ox][o] += delta * stream->conv1_kernel[y - oy][x - ox][o];
+          conv1_dirty[oy][ox] = 1;
+        }
+      changed++;
+    }
+  if (!changed)
+  {
+    stream->stats.unchanged++;
+    memcpy(output, stream->output, sizeof(stream->output));
+    return 0;
+  }
+
+  for (y = 0; y < CONV1_HEIGHT; y++)
+    for (x = 0; x < CONV1_WIDTH; x++)
+      if (conv1_dirty[y][x])
+      {
+        Conv1Output(stream, y, x);
+        stream->stats.conv1_pixels++;
+      }
+
+  // each changed Pool1 value updates the Conv2 sums of its input channel
+  memset(conv2_dirty, 0, sizeof(conv2_dirty));
+  for (y = 0; y < POOL1_HEIGHT; y++)
+    for (x = 0; x < POOL1_WIDTH; x++)
+    {
+      if (!(conv1_dirty[2 * y][2 * x] | conv1_dirty[2 * y][2 * x + 1] | conv1_dirty[2 * y + 1][2 * x] |
+            conv1_dirty[2 * y + 1][2 * x + 1]))
+        continue;
+      y0 = y < CONV2_DIM - 1 ? 0 : y - CONV2_DIM + 1;
+      x0 = x < CONV2_DIM - 1 ? 0 : x - CONV2_DIM + 1;
+      for (d = 0; d < POOL1_NBOUTPUT; d++)
+      {
+        value = Max4(s->conv1_output[d][2 * y][2 * x], s->conv1_output[d][2 * y + 1][2 * x],
+                     s->conv1_output[d][2 * y][2 * x + 1], s->conv1_output[d][2 * y + 1][2 * x + 1]);
+        if (value == s->pool1_output[d][y][x])
+          continue;
+        delta = value - s->pool1_output[d][y][x];
+        s->pool1_output[d][y][x] = value;
+        for (oy = y0; oy <= y && oy < CONV2_HEIGHT; oy++)
+          for (ox = x0; ox <= x && ox < CONV2_WIDTH; ox++)
+          {
+            for (f = 0; f < CONV2_NBOUTPUT; f++)
+              stream->conv2_sum[d][oy][ox][f] += delta * stream->conv2_kernel[d][y - oy][x - ox][f];
+            conv2_dirty[oy][ox] = 1;
+          }
+        stream->stats.pool1_changes++;
+      }
+    }
+
+  for (y = 0; y < CONV2_HEIGHT; y++)
+    for (x = 0; x < CONV2_WIDTH; x++)
+      if (conv2_dirty[y][x])
+      {
+        Conv2Output(stream, y, x);
+        stream->stats.conv2_pixels++;
+      }
+
+  // each changed Pool2 value updates the FC1 sums
+  pool2_changed = 0;
+  for (y = 0; y < POOL2_HEIGHT; y++)
+    for (x = 0; x < POOL2_WIDTH; x++)
+    {
+      if (!(conv2_dirty[2 * y][2 * x] | conv2_dirty[2 * y][2 * x + 1] | conv2_dirty[2 * y + 1][2 * x] |
+            conv2_dirty[2 * y + 1][2 * x + 1]))
+        continue;
+      for (d = 0; d < POOL2_NBOUTPUT; d++)
+      {
+        value = Max4(s->conv2_output[d][2 * y][2 * x], s->conv2_output[d][2 * y + 1][2 * x],
+                     s->conv2_output[d][2 * y][2 * x + 1], s->conv2_output[d][2 * y + 1][2 * x + 1]);
+        if (value == s->pool2_output[d][y][x])
+          continue;
+        delta = value - s->pool2_output[d][y][x];
+        s->pool2_output[d][y][x] = value;
+        for (o = 0; o < FC1_NBOUTPUT; o++)
+          stream->fc1_sum[o] += delta * stream->fc1_kernel[d][y][x][o];
+        stream->stats.pool2_changes++;
+        pool2_changed = 1;
+      }
+    }
+
+  // FC only when pooled features changed, FC2 from the changed FC1 outputs
+  if (pool2_changed)
+  {
+    stream->stats.fc_frames++;
+    for (o = 0; o < FC1_NBOUTPUT; o++)
+    {
+      value = Fc1Output(stream->fc1_sum[o], FC1_BIAS[o]);
+      if (value == s->fc1_output[o])
+        continue;
+      delta = value - s->fc1_output[o];
+      s->fc1_output[o] = value;
+      for (c = 0; c < FC2_NBOUTPUT; c++)
+        stream->fc2_sum[c] += delta * FC2_KERNEL[c][o];
+      stream->stats.fc1_changes++;
+    }
+    for (c = 0; c < FC2_NBOUTPUT; c++)
+      stream->output[c] = Fc2Output(stream->fc2_sum[c], FC2_BIAS[c]);
+  }
+
+  memcpy(output, stream->output, sizeof(stream->output));
+  return changed;
+}
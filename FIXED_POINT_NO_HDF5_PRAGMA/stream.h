@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    stream.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Incremental inference of a stream of frames (video of a digit display)
+  * @brief   The stream keeps the input, the activations and the int sums of
+  *          every layer for the previous frame. A new frame is diffed with it:
+  *          each changed pixel adds its difference times the Conv1 weights to
+  *          the Conv1 outputs of its receptive field, each Pool1 value that
+  *          changes in turn updates the Conv2 outputs reading it, and each
+  *          Pool2 value that changes updates the FC1 sums. FC1 / FC2 only run
+  *          when pooled features changed, and FC2 only on the FC1 outputs that
+  *          changed. The cost of a frame follows the size of the change, and
+  *          the outputs are bit-exact with lenet_cnn().
+  */
+
+#ifndef STREAM_H
+#define STREAM_H
+
+typedef struct lenet_stream lenet_stream;
+
+typedef struct {
+  unsigned long long frames;
+  unsigned long long full;            // first frame after create / reset
+  unsigned long long unchanged;       // identical to the previous frame
+  unsigned long long conv1_pixels;    // Conv1 positions recomputed, all channels
+  unsigned long long pool1_changes;   // Pool1 values changed, each an update of Conv2
+  unsigned long long conv2_pixels;    // Conv2 positions recomputed, all channels
+  unsigned long long pool2_changes;   // Pool2 values changed, each an update of FC1
+  unsigned long long fc_frames;       // frames where FC1 / FC2 ran
+  unsigned long long fc1_changes;     // FC1 outputs changed, each an update of FC2
+} stream_stats;
+
+lenet_stream *StreamCreate(void);
+void StreamDestroy(lenet_stream *stream);
+void StreamReset(lenet_stream *stream);                       // next frame is computed in full
+void StreamStats(lenet_stream *stream, stream_stats *stats);  // OUT
+
+// same output as lenet_cnn(), returns the number of pixels that differ from the previous frame
+int lenet_cnn_stream(lenet_stream *stream,
+                     unsigned char input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH],  // IN
+                     short output[FC2_NBOUTPUT]);                            // OUT
+
+#endif
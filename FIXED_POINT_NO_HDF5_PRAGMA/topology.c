@@ -0,0 +1,268 @@
+/**
+  ******************************************************************************
+  * @file    topology.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Cache / NUMA topology from sysfs, thread placement and first-touch memory
+  */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include "lenet_cnn_float.h"
+#include "workers.h"
+#include "topology.h"
+
+#define SYSFS_CPU       "/sys/devices/system/cpu"
+#define SYSFS_NODE      "/sys/devices/system/node"
+
+static lenet_weights *NODE_WEIGHTS[MAX_NODES];
+static topo_arena *NODE_ARENAS[MAX_NODES];
+static pthread_mutex_t NODE_LOCK = PTHREAD_MUTEX_INITIALIZER;
+
+// first line of a sysfs file, 0 when missing
+static int ReadSysfsLine(char *filename, char *line, int size)
+{
+  FILE *sysfs_file;
+
+  sysfs_file = fopen(filename, "r");
+  if (!sysfs_file)
+    return 0;
+  if (!fgets(line, size, sysfs_file))
+    line[0] = 0;
+  fclose(sysfs_file);
+  line[strcspn(line, "\n")] = 0;
+  return 1;
+}
+
+static int ReadSysfsInt(char *filename, int fallback)
+{
+  char line[64];
+
+  if (!ReadSysfsLine(filename, line, sizeof(line)) || !line[0])
+    return fallback;
+  return atoi(line);
+}
+
+// "0-3,8,10-11" into mask[cpu] = 1, returns the first cpu or -1
+static int ParseCpuList(char *text, unsigned char mask[MAX_CPUS])
+{
+  char *p;
+  int first, last, c, lowest;
+
+  memset(mask, 0, MAX_CPUS);
+  lowest = -1;
+  p = text;
+  while (*p) {
+    first = strtol(p, &p, 10);
+    last = first;
+    if (*p == '-')
+      last = strtol(p + 1, &p, 10);
+    for (c = first; c <= last && c < MAX_CPUS; c++) {
+      if (c < 0)
+        continue;
+      mask[c] = 1;
+      if (lowest < 0 || c < lowest)
+        lowest = c;
+    }
+    if (*p != ',')
+      break;
+    p++;
+  }
+  return lowest;
+}
+
+// first cpu sharing the cache of the given level (highest level when level is 0)
+static int SharedCache(int cpu, int level)
+{
+  char filename[256], line[1024];
+  unsigned char mask[MAX_CPUS];
+  int index, cache_level, best_level, shared;
+
+  best_level = 0;
+  shared = cpu;
+  for (index = 0; ; index++) {
+    sprintf(filename, SYSFS_CPU "/cpu%d/cache/index%d/level", cpu, index);
+    cache_level = ReadSysfsInt(filename, -1);
+    if (cache_level < 0)
+      break;
+    sprintf(filename, SYSFS_CPU "/cpu%d/cache/index%d/type", cpu, index);
+    if (ReadSysfsLine(filename, line, sizeof(line)) && strcmp(line, "Instruction") == 0)
+      continue;
+    if ((level && cache_level != level) || (!level && cache_level <= best_level))
+      continue;
+    sprintf(filename, SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+    if (ReadSysfsLine(filename, line, sizeof(line))) {
+      shared = ParseCpuList(line, mask);
+      best_level = cache_level;
+    }
+  }
+  return shared < 0 ? cpu : shared;
+}
+
+static int CompareCpus(const void *a, const void *b)
+{
+  const cpu_info *x = a, *y = b;
+
+  if (x->smt != y->smt) return x->smt - y->smt;
+  if (x->node != y->node) return x->node - y->node;
+  if (x->llc != y->llc) return x->llc - y->llc;
+  if (x->l2 != y->l2) return x->l2 - y->l2;
+  return x->cpu - y->cpu;
+}
+
+void ReadTopology(cpu_topology *topology)
+{
+  char filename[256], line[4096];
+  unsigned char online[MAX_CPUS], node_cpus[MAX_CPUS];
+  int c, n, i;
+  cpu_info *info;
+
+  memset(topology, 0, sizeof(cpu_topology));
+
+  if (!ReadSysfsLine(SYSFS_CPU "/online", line, sizeof(line)) || ParseCpuList(line, online) < 0) {
+    memset(online, 0, MAX_CPUS);
+    for (c = 0; c < DefaultWorkers() && c < MAX_CPUS; c++)
+      online[c] = 1;
+  }
+
+  for (c = 0; c < MAX_CPUS; c++) {
+    if (!online[c])
+      continue;
+    info = &topology->cpus[topology->nb_cpus++];
+    info->cpu = c;
+    sprintf(filename, SYSFS_CPU "/cpu%d/topology/core_id", c);
+    info->core = ReadSysfsInt(filename, c);
+    sprintf(filename, SYSFS_CPU "/cpu%d/topology/physical_package_id", c);
+    info->package = ReadSysfsInt(filename, 0);
+    info->l2 = SharedCache(c, 2);
+    info->llc = SharedCache(c, 0);
+    info->node = 0;
+  }
+
+  topology->nb_nodes = 1;
+  for (n = 0; n < MAX_NODES; n++) {
+    sprintf(filename, SYSFS_NODE "/node%d/cpulist", n);
+    if (!ReadSysfsLine(filename, line, sizeof(line)) || ParseCpuList(line, node_cpus) < 0)
+      continue;
+    for (i = 0; i < topology->nb_cpus; i++)
+      if (node_cpus[topology->cpus[i].cpu])
+        topology->cpus[i].node = n;
+    if (n + 1 > topology->nb_nodes)
+      topology->nb_nodes = n + 1;
+  }
+
+  // rank of each hardware thread among the threads of its core
+  for (i = 0; i < topology->nb_cpus; i++)
+    for (c = 0; c < i; c++)
+      if (topology->cpus[c].package == topology->cpus[i].package && topology->cpus[c].core == topology->cpus[i].core)
+        topology->cpus[i].smt++;
+
+  qsort(topology->cpus, topology->nb_cpus, sizeof(cpu_info), CompareCpus);
+}
+
+void PrintTopology(cpu_topology *topology)
+{
+  cpu_info *info;
+  int i;
+
+  printf("%6s %4s %5s %8s %5s %4s %4s %4s\n", "worker", "cpu", "core", "package", "node", "L2", "LLC", "SMT");
+  for (i = 0; i < topology->nb_cpus; i++) {
+    info = &topology->cpus[i];
+    printf("%6d %4d %5d %8d %5d %4d %4d %4d\n", i, info->cpu, info->core, info->package, info->node, info->l2, info->llc, info->smt);
+  }
+}
+
+cpu_info *PlaceWorker(cpu_topology *topology, int worker)
+{
+  return &topology->cpus[worker % topology->nb_cpus];
+}
+
+int PinThread(int cpu)
+{
+  cpu_set_t cpus;
+
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+topo_arena *ArenaCreate(size_t size)
+{
+  topo_arena *arena;
+
+  arena = malloc(sizeof(topo_arena));
+  if (!arena)
+    return NULL;
+  arena->base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (arena->base == MAP_FAILED) {
+    free(arena);
+    return NULL;
+  }
+  // first touch from the calling thread places the pages on its node
+  memset(arena->base, 0, size);
+  arena->size = size;
+  arena->used = 0;
+  return arena;
+}
+
+void *ArenaAlloc(topo_arena *arena, size_t size)
+{
+  void *block;
+
+  if (arena->used + size > arena->size)
+    return NULL;
+  block = arena->base + arena->used;
+  arena->used += (size + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1);
+  return block;
+}
+
+void ArenaDestroy(topo_arena *arena)
+{
+  if (!arena)
+    return;
+  munmap(arena->base, arena->size);
+  free(arena);
+}
+
+lenet_weights *NodeWeights(int node)
+{
+  lenet_weights *weights;
+
+  if (node < 0 || node >= MAX_NODES)
+    node = 0;
+
+  pthread_mutex_lock(&NODE_LOCK);
+  if (!NODE_WEIGHTS[node]) {
+    NODE_ARENAS[node] = ArenaCreate(sizeof(lenet_weights));
+    if (!NODE_ARENAS[node]) {
+      printf("Error: Unable to allocate the weights of node %d.\n", node);
+      exit(1);
+    }
+    NODE_WEIGHTS[node] = ArenaAlloc(NODE_ARENAS[node], sizeof(lenet_weights));
+    CopyWeights(NODE_WEIGHTS[node]);
+  }
+  weights = NODE_WEIGHTS[node];
+  pthread_mutex_unlock(&NODE_LOCK);
+
+  return weights;
+}
+
+void FreeNodeWeights(void)
+{
+  int n;
+
+  pthread_mutex_lock(&NODE_LOCK);
+  for (n = 0; n < MAX_NODES; n++) {
+    ArenaDestroy(NODE_ARENAS[n]);
+    NODE_ARENAS[n] = NULL;
+    NODE_WEIGHTS[n] = NULL;
+  }
+  pthread_mutex_unlock(&NODE_LOCK);
+}
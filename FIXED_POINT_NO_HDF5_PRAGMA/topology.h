@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    topology.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Cache / NUMA topology from sysfs, thread placement and first-touch
+  *          memory: per-core scratch arenas and per-node weight replicas
+  * @brief   Placement fills the physical cores of a node (sharing its last level
+  *          cache and weight replica) before the next node, and uses the SMT
+  *          siblings last. Memory is mapped and touched by the pinned thread that
+  *          uses it, so that Linux places its pages on that thread's node.
+  */
+
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <stddef.h>
+
+#define MAX_CPUS        1024
+#define MAX_NODES       64
+
+typedef struct {
+  int cpu;
+  int core;         // topology/core_id
+  int package;      // topology/physical_package_id
+  int node;         // NUMA node, 0 without /sys/devices/system/node
+  int l2;           // first cpu sharing the L2, identifies the cache
+  int llc;          // first cpu sharing the last level cache
+  int smt;          // 0 for the first hardware thread of a core, 1 for its sibling...
+} cpu_info;
+
+typedef struct {
+  int nb_cpus;
+  int nb_nodes;     // highest node + 1
+  cpu_info cpus[MAX_CPUS];    // in placement order
+} cpu_topology;
+
+// bump allocator over memory touched by its creator
+typedef struct {
+  unsigned char *base;
+  size_t size;
+  size_t used;
+} topo_arena;
+
+void ReadTopology(cpu_topology *topology);              // OUT
+void PrintTopology(cpu_topology *topology);
+cpu_info *PlaceWorker(cpu_topology *topology, int worker);
+int PinThread(int cpu);                                 // 0 on success
+
+topo_arena *ArenaCreate(size_t size);                   // mapped and zeroed by the calling thread
+void *ArenaAlloc(topo_arena *arena, size_t size);       // cache line aligned, NULL when full
+void ArenaDestroy(topo_arena *arena);
+
+// weights copied into memory first touched on node, created by the first caller
+// of that node; callers must run on a cpu of node
+lenet_weights *NodeWeights(int node);
+void FreeNodeWeights(void);
+
+#endif
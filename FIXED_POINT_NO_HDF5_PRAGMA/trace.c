@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file    trace.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Per-thread event rings and Chrome trace JSON export (trace.h)
+  */
+
+#ifdef LENET_TRACE
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "trace.h"
+
+#define TRACE_DEFAULT_FILE  "lenet_trace.json"
+
+static const char *EVENT_NAMES[NB_TRACE_EVENTS] = {
+  "load", "normalize", "Conv1", "Pool1", "Conv2", "Pool2", "Fc1", "Fc2", "softmax", "queue empty", "queue full"
+};
+
+typedef struct {
+  unsigned long long ns;
+  unsigned char event;
+  char phase;                                 // 'B' or 'E'
+} trace_record;
+
+typedef struct trace_ring {
+  struct trace_ring *next;
+  int tid;
+  atomic_ullong head;                         // records written, only the owner thread writes
+  trace_record records[TRACE_RING_EVENTS];
+} trace_ring;
+
+static _Atomic(trace_ring *) RINGS;
+static atomic_int AT_EXIT;
+static __thread trace_ring *RING;
+
+static void DumpAtExit(void)
+{
+  const char *filename;
+
+  filename = getenv("LENET_TRACE_FILE");
+  TraceDump(filename ? filename : TRACE_DEFAULT_FILE);
+}
+
+static trace_ring *Register(void)
+{
+  trace_ring *ring;
+
+  ring = malloc(sizeof(trace_ring));
+  if (!ring)
+  {
+    printf("Error: Unable to allocate a trace ring.\n");
+    exit(1);
+  }
+  ring->tid = syscall(SYS_gettid);
+  atomic_init(&ring->head, 0);
+
+  // push on the list of rings
+  ring->next = atomic_load_explicit(&RINGS, memory_order_relaxed);
+  while (!atomic_compare_exchange_weak_explicit(&RINGS, &ring->next, ring, memory_order_release, memory_order_relaxed))
+    ;
+
+  if (atomic_exchange(&AT_EXIT, 1) == 0)
+    atexit(DumpAtExit);
+  RING = ring;
+  return ring;
+}
+
+void TraceEvent(int event, char phase)
+{
+  trace_ring *ring;
+  trace_record *record;
+  struct timespec ts;
+  unsigned long long head;
+
+  ring = RING;
+  if (!ring)
+    ring = Register();
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  record = &ring->records[head & (TRACE_RING_EVENTS - 1)];
+  record->ns = (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+  record->event = event;
+  record->phase = phase;
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void TraceDump(const char *filename)
+{
+  trace_ring *ring;
+  trace_record *record;
+  unsigned long long head, first, k, nb_events;
+  FILE *file;
+  int pid, depth, comma;
+
+  file = fopen(filename, "w");
+  if (!file)
+  {
+    printf("Error: Unable to open file %s.\n", filename);
+    return;
+  }
+  pid = getpid();
+  nb_events = 0;
+  comma = 0;
+  fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+  for (ring = atomic_load_explicit(&RINGS, memory_order_acquire); ring; ring = ring->next)
+  {
+    fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"thread %d\"}}",
+            comma ? ",\n" : "", pid, ring->tid, ring->tid);
+    comma = 1;
+
+    head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    first = head > TRACE_RING_EVENTS ? head - TRACE_RING_EVENTS : 0;
+
+    // a wrapped ring can start with the end of an event whose begin was overwritten
+    depth = 0;
+    for (k = first; k < head; k++)
+    {
+      record = &ring->records[k & (TRACE_RING_EVENTS - 1)];
+      if (record->phase == 'E' && depth == 0)
+        continue;
+      depth += record->phase == 'B' ? 1 : -1;
+      fprintf(file, ",\n{\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": %d, \"tid\": %d}",
+              EVENT_NAMES[record->event], record->phase, record->ns / 1000.0, pid, ring->tid);
+      nb_events++;
+    }
+  }
+  fprintf(file, "\n]}\n");
+  fclose(file);
+  printf("Trace: %llu events written to %s\n", nb_events, filename);
+}
+
+#endif
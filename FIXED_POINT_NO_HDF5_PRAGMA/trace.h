@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    trace.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Timeline tracing of image load, normalization, layers, softmax and
+  *          pipeline queue waits, exported as Chrome trace JSON
+  * @brief   Built with -DLENET_TRACE (make TRACE=1 ...), TRACE_BEGIN / TRACE_END
+  *          record a timestamped event in a ring owned by the calling thread:
+  *          no lock and no shared cache line on the hot path, the oldest events
+  *          are overwritten when a ring is full. The rings stay on a lock-free
+  *          list after their thread exits and are written at exit to
+  *          $LENET_TRACE_FILE (default lenet_trace.json), to be opened in
+  *          chrome://tracing or ui.perfetto.dev.
+  *          Without LENET_TRACE the macros expand to nothing.
+  */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#define TRACE_RING_EVENTS   (1 << 16)   // per thread, power of two
+
+enum {
+  TRACE_LOAD, TRACE_NORMALIZE,
+  TRACE_CONV1, TRACE_POOL1, TRACE_CONV2, TRACE_POOL2, TRACE_FC1, TRACE_FC2,
+  TRACE_SOFTMAX, TRACE_QUEUE_EMPTY, TRACE_QUEUE_FULL,
+  NB_TRACE_EVENTS
+};
+
+#ifdef LENET_TRACE
+
+void TraceEvent(int event, char phase);
+void TraceDump(const char *filename);
+
+#define TRACE_BEGIN(event)  TraceEvent(event, 'B')
+#define TRACE_END(event)    TraceEvent(event, 'E')
+
+#else
+
+#define TRACE_BEGIN(event)  ((void)0)
+#define TRACE_END(event)    ((void)0)
+
+#endif
+
+#endif
@@ -10,6 +10,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 #include "lenet_cnn_float.h"
 
@@ -120,4 +121,69 @@ void NormalizeImg(unsigned char *input, unsigned char *output, short width, shor
     for (x = 0; x < width; x++)
       //for some strange reason, it is faster if I leave this function here... no need for this at all, could use REF_IMG at the beginning
       output[(y * width) + x] = input[(y * width) + x];
-}
\ No newline at end of file
+}
+
+void MakeImgFilename(char *img_filename, int m)
+{
+  // mnist/t10k-images-idx3-ubyte[00042].pgm
+  sprintf(img_filename, "mnist/t10k-images-idx3-ubyte[%05d].pgm", m);
+  //  sprintf(img_filename, "mnist/train-images-idx3-ubyte[%05d].pgm", m);
+}
+
+// Reads the labels of the test set, returns the number of labels read
+int ReadLabels(char *labels_filename, unsigned char *labels, int max_labels)
+{
+  FILE *label_file;
+  unsigned char header[8];
+  int m, c;
+
+  label_file = fopen(labels_filename, "rb");
+  if (!label_file)
+  {
+    printf("Error: Unable to open file %s.\n", labels_filename);
+    exit(1);
+  }
+
+  if (fread(header, 1, 8, label_file) != 8) // Skip 8 first header bytes
+  {
+    printf("Error: Truncated labels file %s.\n", labels_filename);
+    exit(1);
+  }
+
+  for (m = 0; m < max_labels; m++)
+  {
+    c = fgetc(label_file);
+    if (c == EOF)
+      break;
+    labels[m] = (unsigned char)c;
+  }
+
+  fclose(label_file);
+
+  return m;
+}
+
+// Reads labels and images of the test set once, so that tools can run
+// several configurations without re-opening 10000 pgm files each time
+int LoadTestSet(char *labels_filename, unsigned char images[][IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], unsigned char *labels, int max_images)
+{
+  char img_filename[120];
+  int m, nb_images;
+
+  nb_images = ReadLabels(labels_filename, labels, max_images);
+  for (m = 0; m < nb_images; m++)
+  {
+    MakeImgFilename(img_filename, m);
+    ReadPgmFile(img_filename, (unsigned char *)images[m]);
+  }
+
+  return nb_images;
+}
+
+double TimeNow(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000;
+}
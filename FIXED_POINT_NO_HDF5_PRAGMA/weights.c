@@ -0,0 +1,13 @@
+/**
+  ******************************************************************************
+  * @file    weights.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Single definition of the exported weights and biases
+  * @brief   weights.h defines the arrays, so it must be included by exactly one file;
+  *          every other file uses the extern declarations of lenet_cnn_float.h
+  */
+
+#include "lenet_cnn_float.h"
+#include "weights.h"
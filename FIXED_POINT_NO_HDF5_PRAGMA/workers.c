@@ -0,0 +1,183 @@
+/**
+  ******************************************************************************
+  * @file    workers.c
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Work-stealing thread pool over a range of items
+  * @brief   The part of each worker is one 64-bit word, begin << 32 | end, so the
+  *          owner (front) and the thieves (back half) only need a compare and swap.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "workers.h"
+
+#define RANGE(begin, end)   (((unsigned long long)(begin) << 32) | (unsigned int)(end))
+#define RANGE_BEGIN(range)  ((int)((range) >> 32))
+#define RANGE_END(range)    ((int)((range) & 0xffffffff))
+
+typedef struct {
+  _Atomic unsigned long long range;
+  ws_worker_stats stats;
+} __attribute__((aligned(CACHE_LINE))) ws_part;
+
+typedef struct {
+  ws_part *parts;
+  int nb_workers;
+  int grain;
+  ws_start start;
+  ws_task task;
+  void *arg;
+} ws_pool;
+
+typedef struct {
+  ws_pool *pool;
+  int worker;
+} ws_thread_arg;
+
+// owner side: up to grain items from the front of its own part
+static int TakeFront(ws_part *part, int grain, int *begin, int *end)
+{
+  unsigned long long range;
+  int b, e;
+
+  range = atomic_load(&part->range);
+  do {
+    b = RANGE_BEGIN(range);
+    e = RANGE_END(range);
+    if (b >= e)
+      return 0;
+    *begin = b;
+    *end = e - b > grain ? b + grain : e;
+  } while (!atomic_compare_exchange_weak(&part->range, &range, RANGE(*end, e)));
+
+  return 1;
+}
+
+// thief side: the back half (rounded up) of another worker's part
+static int StealBack(ws_part *victim, int *begin, int *end)
+{
+  unsigned long long range;
+  int b, e;
+
+  range = atomic_load(&victim->range);
+  do {
+    b = RANGE_BEGIN(range);
+    e = RANGE_END(range);
+    if (b >= e)
+      return 0;
+    *begin = e - (e - b + 1) / 2;
+    *end = e;
+  } while (!atomic_compare_exchange_weak(&victim->range, &range, RANGE(b, *begin)));
+
+  return 1;
+}
+
+static void WorkerLoop(ws_pool *pool, int worker)
+{
+  ws_part *own;
+  int begin, end, v, stolen;
+
+  own = &pool->parts[worker];
+  if (pool->start)
+    pool->start(pool->arg, worker);
+
+  while (1)
+  {
+    while (TakeFront(own, pool->grain, &begin, &end))
+    {
+      pool->task(pool->arg, worker, begin, end);
+      own->stats.items += end - begin;
+      own->stats.chunks++;
+    }
+
+    // own part is empty, nobody else writes it until it is refilled here
+    stolen = 0;
+    for (v = 1; v < pool->nb_workers && !stolen; v++)
+      stolen = StealBack(&pool->parts[(worker + v) % pool->nb_workers], &begin, &end);
+    if (!stolen)
+      return;
+
+    own->stats.steals++;
+    atomic_store(&own->range, RANGE(begin, end));
+  }
+}
+
+static void *WorkerThread(void *arg)
+{
+  ws_thread_arg *thread_arg = arg;
+
+  WorkerLoop(thread_arg->pool, thread_arg->worker);
+  return NULL;
+}
+
+void RunWorkStealing(int nb_workers, int nb_items, int grain, ws_start start, ws_task task, void *arg,
+                     ws_worker_stats stats[])  // OUT
+{
+  pthread_t threads[MAX_WORKERS];
+  ws_thread_arg thread_args[MAX_WORKERS];
+  ws_pool pool;
+  int w, started;
+
+  if (nb_workers < 1)
+    nb_workers = 1;
+  if (nb_workers > MAX_WORKERS)
+    nb_workers = MAX_WORKERS;
+  if (grain < 1)
+    grain = 1;
+
+  pool.parts = aligned_alloc(CACHE_LINE, sizeof(ws_part) * nb_workers);
+  if (!pool.parts)
+  {
+    printf("Error: Unable to allocate %d workers.\n", nb_workers);
+    exit(1);
+  }
+  pool.nb_workers = nb_workers;
+  pool.grain = grain;
+  pool.start = start;
+  pool.task = task;
+  pool.arg = arg;
+
+  // equal contiguous parts, stealing evens out the rest
+  for (w = 0; w < nb_workers; w++)
+  {
+    atomic_init(&pool.parts[w].range, RANGE((long long)nb_items * w / nb_workers, (long long)nb_items * (w + 1) / nb_workers));
+    memset(&pool.parts[w].stats, 0, sizeof(ws_worker_stats));
+  }
+
+  // a worker that cannot be started leaves its part to be stolen
+  started = 1;
+  for (w = 1; w < nb_workers; w++)
+  {
+    thread_args[w].pool = &pool;
+    thread_args[w].worker = w;
+    if (pthread_create(&threads[w], NULL, WorkerThread, &thread_args[w]) != 0)
+      break;
+    started++;
+  }
+  WorkerLoop(&pool, 0);
+  for (w = 1; w < started; w++)
+    pthread_join(threads[w], NULL);
+
+  if (stats)
+    for (w = 0; w < nb_workers; w++)
+      stats[w] = pool.parts[w].stats;
+
+  free(pool.parts);
+}
+
+int DefaultWorkers(void)
+{
+  long cores;
+
+  cores = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cores < 1)
+    return 1;
+  return cores > MAX_WORKERS ? MAX_WORKERS : (int)cores;
+}
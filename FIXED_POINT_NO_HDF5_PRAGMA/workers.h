@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * @file    workers.h
+  * @author  Chaitanya Devidas Gore, Bogdan Mihai Nistor, Nelli Nyisztor, Université Côte d'Azur, France
+  * @version V1.0
+  * @date    19 october 2026
+  * @brief   Work-stealing thread pool over a range of items (images)
+  * @brief   Every worker owns a contiguous part of the range, takes grain items
+  *          at a time from its front and, once empty, steals the back half of
+  *          another worker's part. The task only receives the worker index, so
+  *          per-worker buffers are indexed by it and never shared.
+  */
+
+#ifndef WORKERS_H
+#define WORKERS_H
+
+#define MAX_WORKERS     256
+#define CACHE_LINE      64
+
+// busy wait hint for the spinning loops
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX()     __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX()     __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX()     __asm__ __volatile__("" ::: "memory")
+#endif
+
+// processes items begin..end-1 on behalf of worker
+typedef void (*ws_task)(void *arg, int worker, int begin, int end);
+
+// called once by each worker, in its own thread, before it takes any item
+// (placement, thread local memory)
+typedef void (*ws_start)(void *arg, int worker);
+
+typedef struct {
+  unsigned int items;     // items processed by the worker
+  unsigned int chunks;    // task calls
+  unsigned int steals;    // successful steals from other workers
+} ws_worker_stats;
+
+// runs task over 0..nb_items-1 on nb_workers threads (the caller is worker 0)
+// and returns when every item has been processed; start and stats may be NULL
+void RunWorkStealing(int nb_workers, int nb_items, int grain, ws_start start, ws_task task, void *arg,
+                     ws_worker_stats stats[]);  // OUT
+
+int DefaultWorkers(void);   // online cores
+
+#endif
@@ -22,6 +22,8 @@
 
 // Xilinx time measurement
 #include "sds_lib.h"
+// percentiles of the sds_clock_counter deltas, in counter ticks instead of ns
+#include "../FIXED_POINT_NO_HDF5_PRAGMA/lat_hist.h"
 
 #include "lenet_cnn_float.h"
 #include "weights.h"
@@ -50,6 +52,7 @@ unsigned char REF_IMG[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
 unsigned char INPUT_NORM[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH];
 short FC2_OUTPUT[FC2_NBOUTPUT];
 float SOFTMAX_OUTPUT[FC2_NBOUTPUT];
+lat_hist XILINX_HIST;
 
 /**
   ******************************************************************************
@@ -93,6 +96,7 @@ int main()
   tmax = 0;              // maximum processing time (us)
   xilinx_time_min = 1e9; // Xilinx minimum processing time (cpu cycles)
   xilinx_time_max = 0;   // Xilinx maximum processing time (cpu cycles)
+  HistReset(&XILINX_HIST);
   error = 0;             // number of mispredictions
 
   // MAIN TEST LOOP
@@ -158,6 +162,7 @@ int main()
       xilinx_time_max = xilinx_time;
 
     xilinx_time_avg = xilinx_time_avg + xilinx_time;
+    HistRecord(&XILINX_HIST, xilinx_time);
     m++;
 
   } // END MAIN TEST LOOP
@@ -170,6 +175,9 @@ int main()
   printf("\n\nSuccess rate = %f%%", (1 - ((float)error / m)) * 100);
 
   printf("\n\nThw_min = %lld cpu cycles \t Thw_max = %lld cpu cycles \t Thw_avg = %lld cpu cycles (Xilinx) ", xilinx_time_min, xilinx_time_max, xilinx_time_avg/m );
+  printf("\n\nThw_p50 = %llu \t Thw_p90 = %llu \t Thw_p99 = %llu \t Thw_p99.9 = %llu cpu cycles (Xilinx, bucket upper bounds) ",
+         HistPercentile(&XILINX_HIST, 50), HistPercentile(&XILINX_HIST, 90), HistPercentile(&XILINX_HIST, 99),
+         HistPercentile(&XILINX_HIST, 99.9));
 
   printf("\n\n");
 
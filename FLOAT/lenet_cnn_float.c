@@ -20,12 +20,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
+#include <unistd.h>
 //#include "hdf5.h"
 
 // Xilinx time measurement
 //#include "sds_lib.h"    
 
 #include "lenet_cnn_float.h"
+#include "../FIXED_POINT_NO_HDF5_PRAGMA/lat_hist.h"
+#include "../FIXED_POINT_NO_HDF5_PRAGMA/results.h"
+
+#define DEFAULT_PROGRESS 	1.0 	// s between progress lines in quiet mode
 
 // Top Level HLS function
 void lenet_cnn(	float 	input[IMG_DEPTH][IMG_HEIGHT][IMG_WIDTH], 							// IN
@@ -119,12 +124,23 @@ float 			FC2_BIAS[FC2_NBOUTPUT];
 float 			FC2_OUTPUT[FC2_NBOUTPUT]; 
 float			SOFTMAX_OUTPUT[FC2_NBOUTPUT]; 
 
+// per-image latency of each phase and of the whole image (ns)
+lat_hist 		IO_HIST, PREPROCESS_HIST, INFERENCE_HIST, SOFTMAX_HIST, IMAGE_HIST; 
+
+static void Usage(char *program) {
+  printf("usage: %s [-q] [-o results.csv] [-b] [-p seconds]\n", program); 
+}
+
 /**
   ******************************************************************************
   * @brief   main code deploying a LeNet inference CNN on MNIST dataset
+  * @brief   -q: no per-image output, progress on stderr every -p seconds
+  *          (default 1, 0 for none). -o: prediction, logits and latency of
+  *          every image written at the end as CSV, or binary with -b
+  *          (../FIXED_POINT_NO_HDF5_PRAGMA/results.h).
   */
 
-void main() {
+int main(int argc, char *argv[]) {
   short 	x, y, z, k, m; 
   char 		*hdf5_filename = 		"lenet_weights.hdf5"; 
   char 		*conv1_weights = 		"conv2d_1/conv2d_1/kernel:0"; 
@@ -147,10 +163,34 @@ void main() {
   char 		img_count[10]; 
   float 	max; 
   struct timeval start, end; 
-  double 	tdiff, tmin, tmax, tavg; 
+  double 	tdiff; 
+  unsigned long long tread, tnorm, tinfer, tsoftmax, tend; 
   unsigned long long xilinx_start, xilinx_end, xilinx_time, xilinx_time_max, xilinx_time_min, xilinx_time_avg; 
+  char 		*results_filename; 
+  double 	progress_interval; 
+  int 		opt, quiet, binary; 
+  result_log 	*log; 
+  result_record *record; 
+  result_progress *progress; 
+
+  quiet = 0; 
+  binary = 0; 
+  results_filename = NULL; 
+  progress_interval = DEFAULT_PROGRESS; 
+  while ((opt = getopt(argc, argv, "qo:bp:h")) != -1) {
+    switch (opt) {
+    case 'q': quiet = 1; break; 
+    case 'o': results_filename = optarg; break; 
+    case 'b': binary = 1; break; 
+    case 'p': progress_interval = atof(optarg); break; 
+    default: 
+      Usage(argv[0]); 
+      return 2; 
+    }
+  }
+  log = results_filename ? ResultsCreate() : NULL; 
 
-  printf("\e[1;1H\e[2J");
+  if (!quiet) printf("\e[1;1H\e[2J");
 
   printf("\nReading weights \n"); 
   ReadConv1Weights(hdf5_filename, conv1_weights, CONV1_KERNEL);
@@ -175,13 +215,16 @@ void main() {
   
   printf("\nProcessing \n");
   m = 0; 		        // test image counter
-  tavg = 0; 		    // average processing time (us)
   xilinx_time_avg = 0;  // Xilinx average processing time (cpu cycles)
-  tmin = 1000000; 	    // minimum processing time (us)
-  tmax = 0; 		    // maximum processing time (us)
   xilinx_time_min = 1e9;// Xilinx minimum processing time (cpu cycles)
   xilinx_time_max = 0;  // Xilinx maximum processing time (cpu cycles)
   error = 0; 		    // number of mispredictions
+  HistReset(&IO_HIST); 
+  HistReset(&PREPROCESS_HIST); 
+  HistReset(&INFERENCE_HIST); 
+  HistReset(&SOFTMAX_HIST); 
+  HistReset(&IMAGE_HIST); 
+  progress = quiet && progress_interval > 0 ? ProgressStart(progress_interval) : NULL; 
 
   // MAIN TEST LOOP
   gettimeofday(&start, NULL); 
@@ -201,11 +244,13 @@ void main() {
     strcat(img_filename, img_count);
     strcat(img_filename, "].pgm");
 
-/**/    printf("\033[%d;%dH%s\n", 7, 0, img_filename);
+/**/    if (!quiet) printf("\033[%d;%dH%s\n", 7, 0, img_filename);
 //    printf("%s\n", img_filename);
 
+    tread = HistNow(); 
     ReadPgmFile(img_filename, (unsigned char *)REF_IMG); 
 
+    tnorm = HistNow(); 
     NormalizeImg((unsigned char *)REF_IMG, (float *)INPUT_NORM, IMG_WIDTH, IMG_WIDTH); 
 /*  for (z = 0; z < IMG_DEPTH; z++)
     for (y=0; y<IMG_HEIGHT; y++) {
@@ -217,6 +262,7 @@ void main() {
 
 ////    xilinx_start = sds_clock_counter();
 
+    tinfer = HistNow(); 
     lenet_cnn(	INPUT_NORM, 				
 				CONV1_KERNEL, 		
 				CONV1_BIAS, 		
@@ -230,12 +276,22 @@ void main() {
 
 ////    xilinx_end = sds_clock_counter(); 
 
+    tsoftmax = HistNow(); 
     Softmax(FC2_OUTPUT, SOFTMAX_OUTPUT); 
-/**/    printf("\n\nSoftmax output: \n");
+    tend = HistNow(); 
+
+    // the console output is left out of the phases
+    HistRecord(&IO_HIST, tnorm - tread); 
+    HistRecord(&PREPROCESS_HIST, tinfer - tnorm); 
+    HistRecord(&INFERENCE_HIST, tsoftmax - tinfer); 
+    HistRecord(&SOFTMAX_HIST, tend - tsoftmax); 
+    HistRecord(&IMAGE_HIST, tend - tread); 
+
+/**/    if (!quiet) printf("\n\nSoftmax output: \n");
     max = 0; 
     number = 0; 
     for (k = 0; k < FC2_NBOUTPUT; k++) {
-/**/      printf("%.2f%% ", SOFTMAX_OUTPUT[k]*100); 
+/**/      if (!quiet) printf("%.2f%% ", SOFTMAX_OUTPUT[k]*100); 
       if (SOFTMAX_OUTPUT[k] > max) {
         max = SOFTMAX_OUTPUT[k]; 
         number = k; 
@@ -243,9 +299,19 @@ void main() {
     }
 
 
-/**/    printf("\n\nPredicted: %d \t Actual: %d\n", labels_legend[number], label); 
+/**/    if (!quiet) printf("\n\nPredicted: %d \t Actual: %d\n", labels_legend[number], label); 
     if (labels_legend[number] != label) error = error + 1; 
 
+    if (log) {
+      record = ResultsNext(log); 
+      record->latency = tend - tread; 
+      for (k = 0; k < FC2_NBOUTPUT; k++) 
+        record->logits[k] = FC2_OUTPUT[k]; 
+      record->label = label; 
+      record->predicted = labels_legend[number]; 
+    }
+    if (progress) ProgressUpdate(progress, m + 1, error); 
+
     xilinx_time = xilinx_end - xilinx_start; 
 
     if (xilinx_time < xilinx_time_min) xilinx_time_min = xilinx_time; 
@@ -256,10 +322,19 @@ void main() {
 
   } // END MAIN TEST LOOP
   gettimeofday(&end, NULL); 
+  if (progress) ProgressStop(progress); 
 
-  tdiff = (double)(end.tv_sec-start.tv_sec); 
+  tdiff = (double)(end.tv_sec-start.tv_sec) + (double)(end.tv_usec-start.tv_usec)/1000000; 
   printf("TOTAL PROCESSING TIME (gettimeofday): %f s\n", tdiff); 
 
+  printf("\n"); 
+  HistPrintHeader("Latency (us)"); 
+  HistPrint("I/O", &IO_HIST); 
+  HistPrint("preprocessing", &PREPROCESS_HIST); 
+  HistPrint("inference", &INFERENCE_HIST); 
+  HistPrint("softmax", &SOFTMAX_HIST); 
+  HistPrint("image", &IMAGE_HIST); 
+
   printf("\n\nErrors : %d / %d", error, m); 
   printf("\n\nSuccess rate = %f%%", (1-((float)error/m))*100); 
 
@@ -267,8 +342,16 @@ void main() {
 
   printf("\n\n"); 
 
+  if (log) {
+    ResultsWrite(log, results_filename, binary); 
+    printf("%d results written to %s\n\n", m, results_filename); 
+    ResultsDestroy(log); 
+  }
+
   fclose(label_file); 
 
+  return 0; 
+
 }
 
 
@@ -6,7 +6,9 @@ Created on Thu Nov 14 2019
 """
 
 # Imports
+import numpy as np
 from keras.models import Sequential
+from keras.models import Model
 from keras.layers import Dense
 from keras.layers import Flatten
 from keras.optimizers import SGD
@@ -58,3 +60,29 @@ model.save_weights('lenet_weights.hdf5')
 
 scores = model.evaluate(testData,testLabels,verbose=0)
 print("Accuracy: %.2f%%" % (scores[1]*100))
+
+# Early exit head: linear classifier on the Pool2 features, the rest of the
+# network stays frozen. Exported for FIXED_POINT_NO_HDF5_PRAGMA/exit_head.c
+features = Model(inputs=model.input, outputs=model.layers[3].output)
+trainFeatures = features.predict(trainData)
+testFeatures = features.predict(testData)
+
+exit_head = Sequential()
+exit_head.add(Flatten(input_shape=trainFeatures.shape[1:]))
+exit_head.add(Dense(num_classes, activation='softmax'))
+exit_head.compile(loss='categorical_crossentropy', optimizer=SGD(lr=0.01), metrics=['accuracy'])
+exit_head.fit(trainFeatures, trainLabels, batch_size=128, epochs=20, verbose=1)
+
+scores = exit_head.evaluate(testFeatures,testLabels,verbose=0)
+print("Exit head accuracy: %.2f%%" % (scores[1]*100))
+
+# keras flattens (height, width, channel), the C arrays are [channel][height][width];
+# values in fixed point with 8 fractional bits, same as weights.h
+exit_kernel, exit_bias = exit_head.layers[1].get_weights()
+height, width, depth = trainFeatures.shape[1:]
+exit_kernel = exit_kernel.reshape((height, width, depth, num_classes)).transpose((3, 2, 0, 1))
+with open('exit_head.txt', 'w') as txt_file:
+    txt_file.write("%d %d\n" % (num_classes, depth*height*width))
+    for k in range(num_classes):
+        txt_file.write(" ".join(str(int(v)) for v in np.round(exit_kernel[k].flatten()*256)) + "\n")
+    txt_file.write(" ".join(str(int(v)) for v in np.round(exit_bias*256)) + "\n")